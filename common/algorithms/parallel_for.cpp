@@ -0,0 +1,64 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "parallel_for.h"
+#include "../sys/regression.h"
+
+namespace embree
+{
+  struct parallel_for_affinity_regression_test : public RegressionTest
+  {
+    parallel_for_affinity_regression_test(const char* name) : RegressionTest(name) {
+      registerRegressionTest(this);
+    }
+
+    bool run ()
+    {
+      bool passed = true;
+
+      const size_t N = 4096;
+      const size_t numCalls = 16;
+      std::vector<std::atomic<size_t>> counts(N);
+      std::vector<size_t> thread0(N), thread1(N);
+      std::vector<unsigned> result(N);
+      affinity_partitioner ap;
+      size_t numMoved = 0;
+
+      for (size_t c=0; c<numCalls; c++)
+      {
+        for (size_t i=0; i<N; i++) counts[i] = 0;
+
+        /* every item does the same amount of work, such that the chunks are balanced */
+        parallel_for_affinity(size_t(0), N, size_t(1), [&](const range<size_t>& r) {
+            const size_t thread = TaskScheduler::threadIndex();
+            for (size_t i=r.begin(); i<r.end(); i++)
+            {
+              unsigned h = unsigned(i);
+              for (size_t j=0; j<1000; j++) h = h*1664525u + 1013904223u;
+              result[i] = h;
+              thread1[i] = thread;
+              counts[i]++;
+            }
+          },ap);
+
+        /* each call processes every index exactly once */
+        for (size_t i=0; i<N; i++)
+          passed &= counts[i] == 1;
+
+        if (c > 0) {
+          for (size_t i=0; i<N; i++)
+            numMoved += thread0[i] != thread1[i];
+        }
+        std::swap(thread0,thread1);
+      }
+
+#if defined(TASKING_INTERNAL) && !defined(TASKING_TBB)
+      /* repeated calls process most items on the same thread as in the previous call */
+      passed &= numMoved <= (numCalls-1)*N/2;
+#endif
+      return passed;
+    }
+  };
+
+  parallel_for_affinity_regression_test parallel_for_affinity_regression("parallel_for_affinity_regression_test");
+}
@@ -140,6 +140,113 @@ namespace embree
     #endif
   }
 
+  template<typename Index, typename Func>
+    __forceinline void parallel_for_affinity( const Index first, const Index last, const Index minStepSize, const Func& func, tbb::affinity_partitioner& ap)
+  {
+    assert(first <= last);
+    #if TBB_INTERFACE_VERSION >= 12002
+      tbb::task_group_context context;
+      tbb::parallel_for(tbb::blocked_range<Index>(first,last,minStepSize),[&](const tbb::blocked_range<Index>& r) {
+          func(range<Index>(r.begin(),r.end()));
+        },ap,context);
+      if (context.is_group_execution_cancelled())
+        throw std::runtime_error("task cancelled");
+    #else
+      tbb::parallel_for(tbb::blocked_range<Index>(first,last,minStepSize),[&](const tbb::blocked_range<Index>& r) {
+          func(range<Index>(r.begin(),r.end()));
+        },ap);
+      if (tbb::task::self().is_cancelled())
+        throw std::runtime_error("task cancelled");
+    #endif
+  }
+
+#elif defined(TASKING_INTERNAL) && !defined(TASKING_TBB)
+
+  template<typename Index, typename Func>
+    __forceinline void parallel_for_static( const Index N, const Func& func) 
+  {
+    parallel_for(N,func);
+  }
+
+  /*! Remembers which thread processed each chunk of the last
+   *  parallel_for_affinity call. In the next call over a range of the
+   *  same size every thread first processes its own chunks again, and
+   *  only then steals chunks from the end of the range, such that a busy
+   *  thread only loses its last chunks and threads that did not start
+   *  yet lose theirs last. */
+  struct affinity_partitioner
+  {
+    /*! number of chunks per thread, more chunks balance better but share more state */
+    static const size_t CHUNKS_PER_THREAD = 4;
+
+    __forceinline affinity_partitioner ()
+      : numThreads(0), numChunks(0) {}
+
+    size_t numThreads;                             //!< number of threads of the last call
+    size_t numChunks;                              //!< number of chunks of the last call
+    std::unique_ptr<unsigned[]> owner;             //!< thread that processed each chunk during the last call
+    std::unique_ptr<unsigned[]> next;              //!< thread that processes each chunk during the current call
+    std::unique_ptr<std::atomic<bool>[]> claimed;  //!< chunks already processed during the current call
+    std::unique_ptr<std::atomic<bool>[]> started;  //!< threads that started processing their own chunks during the current call
+  };
+
+  template<typename Index, typename Func>
+    __forceinline void parallel_for_affinity( const Index first, const Index last, const Index minStepSize, const Func& func, affinity_partitioner& ap)
+  {
+    assert(first <= last);
+    const size_t N = size_t(last-first);
+    const size_t numThreads = TaskScheduler::threadCount();
+    const size_t numChunks = min((N+size_t(minStepSize)-1)/size_t(minStepSize),numThreads*affinity_partitioner::CHUNKS_PER_THREAD);
+    if (numChunks <= 1) {
+      if (N) func(range<Index>(first,last));
+      return;
+    }
+
+    /* chunks are initially distributed statically over the threads */
+    if (ap.numThreads != numThreads || ap.numChunks != numChunks)
+    {
+      ap.numThreads = numThreads;
+      ap.numChunks = numChunks;
+      ap.owner.reset(new unsigned[numChunks]);
+      ap.next.reset(new unsigned[numChunks]);
+      ap.claimed.reset(new std::atomic<bool>[numChunks]);
+      ap.started.reset(new std::atomic<bool>[numThreads]);
+      for (size_t i=0; i<numChunks; i++) ap.owner[i] = unsigned(i % numThreads);
+    }
+    /* chunks keep their owner unless processed, e.g. when func throws */
+    for (size_t i=0; i<numChunks; i++) ap.next[i] = ap.owner[i];
+    for (size_t i=0; i<numChunks; i++) ap.claimed[i] = false;
+    for (size_t i=0; i<numThreads; i++) ap.started[i] = false;
+
+    auto chunk = [&] (size_t i, unsigned thread) {
+      ap.next[i] = thread;
+      func(range<Index>(first+Index(i*N/numChunks),first+Index((i+1)*N/numChunks)));
+    };
+
+    parallel_for(numThreads, [&] (size_t) {
+        const unsigned thread = (unsigned) TaskScheduler::threadIndex();
+        assert(thread < numThreads);
+        ap.started[thread] = true;
+        for (size_t i=0; i<numChunks; i++)
+          if (ap.owner[i] == thread && !ap.claimed[i].exchange(true)) chunk(i,thread);
+
+        /* owners claim their chunks from the front, thus stealing from the end takes their last chunks */
+        for (size_t i=numChunks; i-- > 0; )
+          if (ap.started[ap.owner[i]].load() && !ap.claimed[i].load() && !ap.claimed[i].exchange(true)) chunk(i,thread);
+        for (size_t i=numChunks; i-- > 0; )
+          if (!ap.claimed[i].load() && !ap.claimed[i].exchange(true)) chunk(i,thread);
+      });
+    std::swap(ap.owner,ap.next);
+  }
+
+  template<typename Index, typename Func>
+    __forceinline void parallel_for_affinity( const Index N, const Func& func, affinity_partitioner& ap) 
+  {
+    parallel_for_affinity(Index(0),N,Index(1),[&] (const range<Index>& r) {
+        for (Index i=r.begin(); i<r.end(); i++) func(i);
+      },ap);
+  }
+
 #else
 
   template<typename Index, typename Func>
@@ -157,5 +264,11 @@ namespace embree
     parallel_for(N,func);
   }
 
+  template<typename Index, typename Func>
+    __forceinline void parallel_for_affinity( const Index first, const Index last, const Index minStepSize, const Func& func, affinity_partitioner& ap) 
+  {
+    parallel_for(first,last,minStepSize,func);
+  }
+
 #endif
 }
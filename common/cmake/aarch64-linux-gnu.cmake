@@ -0,0 +1,25 @@
+## Copyright 2009-2021 Intel Corporation
+## SPDX-License-Identifier: Apache-2.0
+
+# Toolchain to cross compile Embree for AArch64 Linux on an x86 host,
+# ctest runs the resulting executables through QEMU user mode emulation:
+#
+#   cmake -DCMAKE_TOOLCHAIN_FILE=../common/cmake/aarch64-linux-gnu.cmake -DEMBREE_TASKING_SYSTEM=INTERNAL ..
+#   make -j 8 embree_verify
+#   ctest -R embree_verify_neon
+
+SET(CMAKE_SYSTEM_NAME Linux)
+SET(CMAKE_SYSTEM_PROCESSOR aarch64)
+
+SET(EMBREE_AARCH64_SYSROOT "/usr/aarch64-linux-gnu" CACHE PATH "Path to the AArch64 sysroot used by the cross compiler and QEMU.")
+
+SET(CMAKE_C_COMPILER aarch64-linux-gnu-gcc)
+SET(CMAKE_CXX_COMPILER aarch64-linux-gnu-g++)
+SET(CMAKE_FIND_ROOT_PATH "${EMBREE_AARCH64_SYSROOT}")
+SET(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+SET(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+SET(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
+SET(CMAKE_FIND_ROOT_PATH_MODE_PACKAGE ONLY)
+
+# tests that run executable targets get prefixed with the emulator
+SET(CMAKE_CROSSCOMPILING_EMULATOR qemu-aarch64 -L "${EMBREE_AARCH64_SYSROOT}")
@@ -6,6 +6,8 @@
 #include "bbox.h"
 #include "range.h"
 
+#include <algorithm>
+
 namespace embree
 {
   template<typename T>
@@ -102,6 +104,49 @@ namespace embree
       bounds1 = b1;
     }
 
+    /*! calculates the linear bounds of a primitive for the specified time range and non-uniformly spaced time steps */
+    template<typename BoundsFunc>
+    __forceinline LBBox(const BoundsFunc& bounds, const BBox1f& time_range, const float* times, int numTimeSegments)
+    {
+      if (numTimeSegments == 0) {
+        bounds0 = bounds1 = bounds(0);
+        return;
+      }
+
+      const int ilower = clamp(int(std::upper_bound(times, times+numTimeSegments+1, time_range.lower)-times)-1, 0, numTimeSegments-1);
+      const int iupper = min(int(std::lower_bound(times, times+numTimeSegments+1, time_range.upper)-times), numTimeSegments);
+      const float flower = (time_range.lower-times[ilower])/(times[ilower+1]-times[ilower]);
+      const float fupper = (times[iupper]-time_range.upper)/(times[iupper]-times[iupper-1]);
+
+      const BBox<T> blower0 = bounds(ilower);
+      const BBox<T> bupper1 = bounds(iupper);
+
+      if (iupper-ilower == 1) {
+        bounds0 = lerp(blower0, bupper1, flower);
+        bounds1 = lerp(bupper1, blower0, fupper);
+        return;
+      }
+
+      const BBox<T> blower1 = bounds(ilower+1);
+      const BBox<T> bupper0 = bounds(iupper-1);
+      BBox<T> b0 = lerp(blower0, blower1, flower);
+      BBox<T> b1 = lerp(bupper1, bupper0, fupper);
+
+      for (int i = ilower+1; i < iupper; i++)
+      {
+        const float f = (times[i] - time_range.lower) / time_range.size();
+        const BBox<T> bt = lerp(b0, b1, f);
+        const BBox<T> bi = bounds(i);
+        const T dlower = min(bi.lower-bt.lower, T(zero));
+        const T dupper = max(bi.upper-bt.upper, T(zero));
+        b0.lower += dlower; b1.lower += dlower;
+        b0.upper += dupper; b1.upper += dupper;
+      }
+
+      bounds0 = b0;
+      bounds1 = b1;
+    }
+
     /*! calculates the linear bounds of a primitive for the specified time range */
     template<typename BoundsFunc>
     __forceinline LBBox(const BoundsFunc& bounds, const BBox1f& time_range_in, const BBox1f& geom_time_range, float geom_time_segments)
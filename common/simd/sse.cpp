@@ -2,6 +2,10 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "sse.h"
+#if defined(__AVX__)
+#include "avx.h"
+#endif
+#include "../sys/regression.h"
 
 namespace embree 
 {
@@ -31,4 +35,67 @@ namespace embree
     _mm_castsi128_pd(_mm_set_epi32(-1,-1,-1,-1))
   };
 
+#if defined(__aarch64__)
+
+  /*! compares the native NEON mask reductions and integer compares against the SSE/AVX emulation */
+  struct simd_neon_regression_test : public RegressionTest
+  {
+    simd_neon_regression_test(const char* name) : RegressionTest(name) {
+      registerRegressionTest(this);
+    }
+
+    bool run ()
+    {
+      bool passed = true;
+
+      for (int m=0; m<16; m++)
+      {
+        const vboolf4 a(m);
+        const size_t ref = _mm_movemask_ps(a.v);
+        passed &= movemask(a) == ref;
+        passed &= popcnt(a) == size_t(__builtin_popcount(m));
+        passed &= all(a) == (ref == 0xf);
+        passed &= any(a) == (ref != 0x0);
+        passed &= none(a) == (ref == 0x0);
+        for (size_t i=0; i<4; i++)
+          passed &= a[i] == bool((ref >> i) & 1);
+      }
+
+#if defined(__AVX__)
+      for (int m=0; m<256; m++)
+      {
+        const vboolf8 a(m);
+        const unsigned int ref = _mm256_movemask_ps(a.v);
+        passed &= movemask(a) == ref;
+        passed &= popcnt(a) == size_t(__builtin_popcount(m));
+        passed &= all(a) == (ref == 0xff);
+        passed &= any(a) == (ref != 0x00);
+        passed &= none(a) == (ref == 0x00);
+        for (size_t i=0; i<8; i++)
+          passed &= a[i] == bool((ref >> i) & 1);
+      }
+#endif
+
+      const int values[] = { std::numeric_limits<int>::min(), -7, -1, 0, 1, 7, std::numeric_limits<int>::max() };
+      for (int x : values)
+      {
+        for (int y : values)
+        {
+          const vint4 a(x,y,x,y), b(y,x,x,y);
+          passed &= movemask(a == b) == size_t(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a,b))));
+          passed &= movemask(a <  b) == size_t(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(a,b))));
+          passed &= movemask(a >  b) == size_t(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(a,b))));
+          passed &= movemask(a != b) == (~movemask(a == b) & 0xf);
+          passed &= movemask(a >= b) == (~movemask(a <  b) & 0xf);
+          passed &= movemask(a <= b) == (~movemask(a >  b) & 0xf);
+        }
+      }
+
+      return passed;
+    }
+  };
+
+  simd_neon_regression_test simd_neon_regression("simd_neon_regression_test");
+
+#endif
 }
@@ -68,7 +68,11 @@ namespace embree
     /// Array Access
     ////////////////////////////////////////////////////////////////////////////////
 
+#if defined(__aarch64__)
+    __forceinline bool operator [](size_t index) const { assert(index < 4); return i[index] < 0; }
+#else
     __forceinline bool operator [](size_t index) const { assert(index < 4); return (_mm_movemask_ps(v) >> index) & 1; }
+#endif
     __forceinline int& operator [](size_t index)       { assert(index < 4); return i[index]; }
   };
 
@@ -161,22 +165,42 @@ namespace embree
   /// Reduction Operations
   ////////////////////////////////////////////////////////////////////////////////
     
+#if defined(__aarch64__)
+  /* lanes are tested on their sign bit like movemask does, and reduced with across-vector instructions */
+  __forceinline uint32x4_t signbits(const vboolf4& a) { return vshrq_n_u32(vreinterpretq_u32_f32(a.v),31); }
+
+  __forceinline bool reduce_and(const vboolf4& a) { return vminvq_u32(signbits(a)) != 0; }
+  __forceinline bool reduce_or (const vboolf4& a) { return vmaxvq_u32(signbits(a)) != 0; }
+
+  __forceinline bool all (const vboolf4& b) { return vminvq_u32(signbits(b)) != 0; }
+  __forceinline bool any (const vboolf4& b) { return vmaxvq_u32(signbits(b)) != 0; }
+  __forceinline bool none(const vboolf4& b) { return vmaxvq_u32(signbits(b)) == 0; }
+#else
   __forceinline bool reduce_and(const vboolf4& a) { return _mm_movemask_ps(a) == 0xf; }
   __forceinline bool reduce_or (const vboolf4& a) { return _mm_movemask_ps(a) != 0x0; }
 
   __forceinline bool all (const vboolf4& b) { return _mm_movemask_ps(b) == 0xf; }
   __forceinline bool any (const vboolf4& b) { return _mm_movemask_ps(b) != 0x0; }
   __forceinline bool none(const vboolf4& b) { return _mm_movemask_ps(b) == 0x0; }
+#endif
 
   __forceinline bool all (const vboolf4& valid, const vboolf4& b) { return all((!valid) | b); }
   __forceinline bool any (const vboolf4& valid, const vboolf4& b) { return any(valid & b); }
   __forceinline bool none(const vboolf4& valid, const vboolf4& b) { return none(valid & b); }
   
+#if defined(__aarch64__)
+  __forceinline size_t movemask(const vboolf4& a) {
+    const int32x4_t shift = { 0, 1, 2, 3 };
+    return vaddvq_u32(vshlq_u32(signbits(a),shift));
+  }
+  __forceinline size_t popcnt(const vboolf4& a) { return vaddvq_u32(signbits(a)); }
+#else
   __forceinline size_t movemask(const vboolf4& a) { return _mm_movemask_ps(a); }
 #if defined(__SSE4_2__)
   __forceinline size_t popcnt(const vboolf4& a) { return popcnt((size_t)_mm_movemask_ps(a)); }
 #else
   __forceinline size_t popcnt(const vboolf4& a) { return bool(a[0])+bool(a[1])+bool(a[2])+bool(a[3]); }
+#endif
 #endif
 
   ////////////////////////////////////////////////////////////////////////////////
@@ -85,7 +85,11 @@ namespace embree
     /// Array Access
     ////////////////////////////////////////////////////////////////////////////////
 
+#if defined(__aarch64__)
+    __forceinline bool operator [](size_t index) const { assert(index < 8); return i[index] < 0; }
+#else
     __forceinline bool operator [](size_t index) const { assert(index < 8); return (_mm256_movemask_ps(v) >> index) & 1; }
+#endif
     __forceinline int& operator [](size_t index)       { assert(index < 8); return i[index]; }
   };
 
@@ -164,19 +168,41 @@ namespace embree
   /// Reduction Operations
   ////////////////////////////////////////////////////////////////////////////////
 
+#if defined(__aarch64__)
+  /* lanes are tested on their sign bit like movemask does, both 4-wide halves get combined before a single across-vector reduction */
+  __forceinline uint32x4_t signbits_lo(const vboolf8& a) { return vshrq_n_u32(vreinterpretq_u32_f32(a.v.lo),31); }
+  __forceinline uint32x4_t signbits_hi(const vboolf8& a) { return vshrq_n_u32(vreinterpretq_u32_f32(a.v.hi),31); }
+
+  __forceinline bool reduce_and(const vboolf8& a) { return vminvq_u32(vandq_u32(signbits_lo(a),signbits_hi(a))) != 0; }
+  __forceinline bool reduce_or (const vboolf8& a) { return vmaxvq_u32(vorrq_u32(signbits_lo(a),signbits_hi(a))) != 0; }
+
+  __forceinline bool all (const vboolf8& a) { return reduce_and(a); }
+  __forceinline bool any (const vboolf8& a) { return reduce_or(a); }
+  __forceinline bool none(const vboolf8& a) { return !reduce_or(a); }
+#else
   __forceinline bool reduce_and(const vboolf8& a) { return _mm256_movemask_ps(a) == (unsigned int)0xff; }
   __forceinline bool reduce_or (const vboolf8& a) { return !_mm256_testz_ps(a,a); }
 
   __forceinline bool all (const vboolf8& a) { return _mm256_movemask_ps(a) == (unsigned int)0xff; }
   __forceinline bool any (const vboolf8& a) { return !_mm256_testz_ps(a,a); }
   __forceinline bool none(const vboolf8& a) { return _mm256_testz_ps(a,a) != 0; }
+#endif
 
   __forceinline bool all (const vboolf8& valid, const vboolf8& b) { return all((!valid) | b); }
   __forceinline bool any (const vboolf8& valid, const vboolf8& b) { return any(valid & b); }
   __forceinline bool none(const vboolf8& valid, const vboolf8& b) { return none(valid & b); }
 
+#if defined(__aarch64__)
+  __forceinline unsigned int movemask(const vboolf8& a) {
+    const int32x4_t shift_lo = { 0, 1, 2, 3 };
+    const int32x4_t shift_hi = { 4, 5, 6, 7 };
+    return vaddvq_u32(vaddq_u32(vshlq_u32(signbits_lo(a),shift_lo),vshlq_u32(signbits_hi(a),shift_hi)));
+  }
+  __forceinline size_t       popcnt  (const vboolf8& a) { return vaddvq_u32(vaddq_u32(signbits_lo(a),signbits_hi(a))); }
+#else
   __forceinline unsigned int movemask(const vboolf8& a) { return _mm256_movemask_ps(a); }
   __forceinline size_t       popcnt  (const vboolf8& a) { return popcnt((size_t)_mm256_movemask_ps(a)); }
+#endif
 
   ////////////////////////////////////////////////////////////////////////////////
   /// Get/Set Functions
@@ -727,6 +727,15 @@ namespace embree
   /// Reductions
   ////////////////////////////////////////////////////////////////////////////////
 
+#if defined(__aarch64__)
+  __forceinline vfloat4 vreduce_min(const vfloat4& v) { return vdupq_n_f32(vminvq_f32(v.v)); }
+  __forceinline vfloat4 vreduce_max(const vfloat4& v) { return vdupq_n_f32(vmaxvq_f32(v.v)); }
+  __forceinline vfloat4 vreduce_add(const vfloat4& v) { return vdupq_n_f32(vaddvq_f32(v.v)); }
+
+  __forceinline float reduce_min(const vfloat4& v) { return vminvq_f32(v.v); }
+  __forceinline float reduce_max(const vfloat4& v) { return vmaxvq_f32(v.v); }
+  __forceinline float reduce_add(const vfloat4& v) { return vaddvq_f32(v.v); }
+#else
   __forceinline vfloat4 vreduce_min(const vfloat4& v) { vfloat4 h = min(shuffle<1,0,3,2>(v),v); return min(shuffle<2,3,0,1>(h),h); }
   __forceinline vfloat4 vreduce_max(const vfloat4& v) { vfloat4 h = max(shuffle<1,0,3,2>(v),v); return max(shuffle<2,3,0,1>(h),h); }
   __forceinline vfloat4 vreduce_add(const vfloat4& v) { vfloat4 h = shuffle<1,0,3,2>(v)   + v ; return shuffle<2,3,0,1>(h)   + h ; }
@@ -734,6 +743,7 @@ namespace embree
   __forceinline float reduce_min(const vfloat4& v) { return _mm_cvtss_f32(vreduce_min(v)); }
   __forceinline float reduce_max(const vfloat4& v) { return _mm_cvtss_f32(vreduce_max(v)); }
   __forceinline float reduce_add(const vfloat4& v) { return _mm_cvtss_f32(vreduce_add(v)); }
+#endif
 
   __forceinline size_t select_min(const vboolf4& valid, const vfloat4& v) 
   { 
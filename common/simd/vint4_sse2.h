@@ -351,6 +351,13 @@ namespace embree
   __forceinline vboolf4 operator >=(const vint4& a, const vint4& b) { return _mm_cmp_epi32_mask(a,b,_MM_CMPINT_GE); }
   __forceinline vboolf4 operator > (const vint4& a, const vint4& b) { return _mm_cmp_epi32_mask(a,b,_MM_CMPINT_GT); }
   __forceinline vboolf4 operator <=(const vint4& a, const vint4& b) { return _mm_cmp_epi32_mask(a,b,_MM_CMPINT_LE); }
+#elif defined(__aarch64__)
+  __forceinline vboolf4 operator ==(const vint4& a, const vint4& b) { return vreinterpretq_f32_u32(vceqq_s32(a.v, b.v)); }
+  __forceinline vboolf4 operator !=(const vint4& a, const vint4& b) { return vreinterpretq_f32_u32(vmvnq_u32(vceqq_s32(a.v, b.v))); }
+  __forceinline vboolf4 operator < (const vint4& a, const vint4& b) { return vreinterpretq_f32_u32(vcltq_s32(a.v, b.v)); }
+  __forceinline vboolf4 operator >=(const vint4& a, const vint4& b) { return vreinterpretq_f32_u32(vcgeq_s32(a.v, b.v)); }
+  __forceinline vboolf4 operator > (const vint4& a, const vint4& b) { return vreinterpretq_f32_u32(vcgtq_s32(a.v, b.v)); }
+  __forceinline vboolf4 operator <=(const vint4& a, const vint4& b) { return vreinterpretq_f32_u32(vcleq_s32(a.v, b.v)); }
 #else
   __forceinline vboolf4 operator ==(const vint4& a, const vint4& b) { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, b)); }
   __forceinline vboolf4 operator !=(const vint4& a, const vint4& b) { return !(a == b); }
@@ -10,6 +10,9 @@ RTC_NAMESPACE_BEGIN
 /* Opaque BVH type */
 typedef struct RTCBVHTy* RTCBVH;
 
+/* Opaque streaming BVH build type */
+typedef struct RTCBVHStreamTy* RTCBVHStream;
+
 /* Input build primitives for the builder */
 struct RTC_ALIGN(32) RTCBuildPrimitive
 {
@@ -106,12 +109,57 @@ RTC_FORCEINLINE struct RTCBuildArguments rtcDefaultBuildArguments()
   return args;
 }
 
+/* Memory layout of the nodes returned by rtcBuildFlatBVH */
+enum RTCFlatBVHNodeLayout
+{
+  RTC_FLAT_BVH_NODE_LAYOUT_AOS           = 0,
+  RTC_FLAT_BVH_NODE_LAYOUT_SOA           = 1,
+  RTC_FLAT_BVH_NODE_LAYOUT_SOA_QUANTIZED = 2
+};
+
+/* Offset stored in empty child slots of a flat BVH node */
+#define RTC_FLAT_BVH_EMPTY_CHILD ((unsigned int)-1)
+
+/* Child slot of a flat BVH node in AoS layout */
+struct RTCFlatBVHChild
+{
+  float lower_x, lower_y, lower_z;
+  unsigned int offset;         /* node index of inner children, index of the first primitive of leaves */
+  float upper_x, upper_y, upper_z;
+  unsigned int primitiveCount; /* number of primitives of leaves, 0 for inner children */
+};
+
+/* Flat BVH returned by rtcBuildFlatBVH, the arrays are owned by the BVH object */
+struct RTCFlatBVH
+{
+  unsigned int branchingFactor;
+  enum RTCFlatBVHNodeLayout nodeLayout;
+  size_t nodeByteStride;
+  size_t nodeCount;
+  const void* nodes;                /* root node is stored first */
+  size_t primitiveCount;
+  const unsigned int* primitiveIDs; /* primID of the build primitives in leaf order */
+  struct RTCBounds bounds;
+};
+
 /* Creates a new BVH. */
 RTC_API RTCBVH rtcNewBVH(RTCDevice device);
 
 /* Builds a BVH. */
 RTC_API void* rtcBuildBVH(const struct RTCBuildArguments* args);
 
+/* Builds a BVH into a flat node array without invoking the node and leaf callbacks. */
+RTC_API void rtcBuildFlatBVH(const struct RTCBuildArguments* args, enum RTCFlatBVHNodeLayout layout, struct RTCFlatBVH* flatBVH);
+
+/* Begins a streaming build of a BVH, primitives get added in chunks. */
+RTC_API RTCBVHStream rtcBeginBVHStream(const struct RTCBuildArguments* args);
+
+/* Adds a chunk of primitives to a streaming build, the subtree over the chunk gets built in the background. */
+RTC_API void rtcAddBVHStreamPrimitives(RTCBVHStream stream, const struct RTCBuildPrimitive* primitives, size_t primitiveCount);
+
+/* Finishes a streaming build by merging the subtrees of all chunks and returns the root. */
+RTC_API void* rtcFinishBVHStream(RTCBVHStream stream);
+
 /* Allocates memory using the thread local allocator. */
 RTC_API void* rtcThreadLocalAlloc(RTCThreadLocalAllocator allocator, size_t bytes, size_t align);
 
@@ -150,6 +150,12 @@ enum RTCFormat
   RTC_FORMAT_GRID = 0xA001,
 
   RTC_FORMAT_QUATERNION_DECOMPOSITION = 0xB001,
+
+  /* 16-bit float */
+  RTC_FORMAT_HALF = 0xC001,
+  RTC_FORMAT_HALF2,
+  RTC_FORMAT_HALF3,
+  RTC_FORMAT_HALF4,
 };
 
 /* Build quality levels */
@@ -153,6 +153,15 @@ RTC_API void rtcSetGeometryTimeStepCount(RTCGeometry geometry, unsigned int time
 
 /* Sets the motion blur time range of the geometry. */
 RTC_API void rtcSetGeometryTimeRange(RTCGeometry geometry, float startTime, float endTime);
+
+/* Sets the times of non-uniformly spaced motion blur time steps of the geometry. */
+RTC_API void rtcSetGeometryTimeStepTimes(RTCGeometry geometry, const float* times, unsigned int timeStepCount);
+
+/* Enables or disables compressed storage of the vertex motion of the geometry. */
+RTC_API void rtcSetGeometryVertexMotionCompression(RTCGeometry geometry, bool enable);
+
+/* Sets the bounds that 16 bit quantized vertices of the geometry are relative to. */
+RTC_API void rtcSetGeometryVertexQuantizationBounds(RTCGeometry geometry, const struct RTCBounds* bounds);
   
 /* Sets the number of vertex attributes of the geometry. */
 RTC_API void rtcSetGeometryVertexAttributeCount(RTCGeometry geometry, unsigned int vertexAttributeCount);
@@ -182,6 +191,12 @@ RTC_API void* rtcGetGeometryBufferData(RTCGeometry geometry, enum RTCBufferType
 /* Updates a geometry buffer. */
 RTC_API void rtcUpdateGeometryBuffer(RTCGeometry geometry, enum RTCBufferType type, unsigned int slot);
 
+/* Updates a range of items of a geometry buffer. */
+RTC_API void rtcUpdateGeometryBufferRange(RTCGeometry geometry, enum RTCBufferType type, unsigned int slot, size_t itemOffset, size_t itemCount);
+
+/* Updates a range of bytes of a geometry buffer. */
+RTC_API void rtcUpdateGeometryBufferByteRange(RTCGeometry geometry, enum RTCBufferType type, unsigned int slot, size_t byteOffset, size_t byteSize);
+
 
 /* Sets the intersection filter callback function of the geometry. */
 RTC_API void rtcSetGeometryIntersectFilterFunction(RTCGeometry geometry, RTCFilterFunctionN filter);
@@ -192,6 +207,15 @@ RTC_API void rtcSetGeometryOccludedFilterFunction(RTCGeometry geometry, RTCFilte
 /* Enables argument version of intersection or occlusion filter function. */
 RTC_API void rtcSetGeometryEnableFilterFunctionFromArguments(RTCGeometry geometry, bool enable);
 
+/* Sets a per-primitive visibility mask of the geometry that is tested against the ray mask. */
+RTC_API void rtcSetGeometryPrimitiveMaskBuffer(RTCGeometry geometry, const unsigned int* masks, size_t byteStride);
+
+/* Sets a per-primitive opacity of the geometry, hits of primitives with opacity below the cutoff are ignored. */
+RTC_API void rtcSetGeometryPrimitiveOpacityBuffer(RTCGeometry geometry, const float* opacities, size_t byteStride, float cutoff);
+
+/* Sets an 8-bit alpha texture of the geometry, hits with alpha below the cutoff are ignored. */
+RTC_API void rtcSetGeometryAlphaTexture(RTCGeometry geometry, const unsigned char* texels, unsigned int width, unsigned int height, unsigned int texcoordSlot, float cutoff);
+
 /* Sets the user-defined data pointer of the geometry. */
 RTC_API void rtcSetGeometryUserData(RTCGeometry geometry, void* ptr);
 
@@ -228,6 +252,9 @@ RTC_API void rtcSetGeometryInstancedScene(RTCGeometry geometry, RTCScene scene);
 /* Sets the instanced scenes of an instance array geometry. */
 RTC_API void rtcSetGeometryInstancedScenes(RTCGeometry geometry, RTCScene* scenes, size_t numScenes);
 
+/* Sets the distances at which the instances of an instance array geometry switch to the next level of detail. */
+RTC_API void rtcSetGeometryInstanceLODs(RTCGeometry geometry, const float* distances, unsigned int numDistances, float blendWidth);
+
 /* Sets the transformation of an instance for the specified time step. */
 RTC_API void rtcSetGeometryTransform(RTCGeometry geometry, unsigned int timeStep, enum RTCFormat format, const void* xfm);
 
@@ -51,6 +51,33 @@ struct RTCRayHit
   struct RTCHit hit;
 };
 
+/* Maximal number of hits returned by rtcIntersectMulti */
+#define RTC_MAX_MULTI_HIT_COUNT 16
+
+/* Nearest hits of a single ray sorted by distance */
+struct RTCMultiHit
+{
+  unsigned int hitCount;                      // number of hits found
+  float tfar[RTC_MAX_MULTI_HIT_COUNT];        // hit distances in ascending order
+  struct RTCHit hit[RTC_MAX_MULTI_HIT_COUNT]; // hits sorted by distance
+};
+
+/* Ray cone of a single ray used to estimate its footprint */
+struct RTCRayCone
+{
+  float width;       // width of the cone at the ray origin
+  float spreadAngle; // spread angle of the cone in radians
+};
+
+/* Footprint of a ray cone at the nearest hit */
+struct RTCRayConeHit
+{
+  float distance;    // distance from the ray origin to the hit
+  float width;       // width of the cone at the hit
+  float area;        // world space area of the hit triangle
+  float cosTheta;    // cosine of the angle between ray direction and geometry normal
+};
+
 /* Ray structure for a packet of 4 rays */
 struct RTC_ALIGN(16) RTCRay4
 {
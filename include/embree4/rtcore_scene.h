@@ -22,6 +22,7 @@ enum RTCSceneFlags
   RTC_SCENE_FLAG_ROBUST                       = (1 << 2),
   RTC_SCENE_FLAG_FILTER_FUNCTION_IN_ARGUMENTS = (1 << 3),
   RTC_SCENE_FLAG_PREFETCH_USM_SHARED_ON_GPU   = (1 << 4),
+  RTC_SCENE_FLAG_WATERTIGHT                   = (1 << 5),
 };
 
 /* Additional arguments for rtcIntersect1/4/8/16 calls */
@@ -169,6 +170,27 @@ RTC_API void rtcIntersect8(const int* valid, RTCScene scene, struct RTCRayHit8*
 /* Intersects a packet of 16 rays with the scene. */
 RTC_API void rtcIntersect16(const int* valid, RTCScene scene, struct RTCRayHit16* rayhit, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
 
+/* Intersects a single ray with the scene and returns the maxHitCount nearest hits. */
+RTC_API void rtcIntersectMulti1(RTCScene scene, struct RTCRayHit* rayhit, unsigned int maxHitCount, struct RTCMultiHit* hits, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
+
+/* Intersects a packet of 4 rays with the scene and returns the maxHitCount nearest hits of each ray. */
+RTC_API void rtcIntersectMulti4(const int* valid, RTCScene scene, struct RTCRayHit4* rayhit, unsigned int maxHitCount, struct RTCMultiHit* hits, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
+
+/* Intersects a packet of 8 rays with the scene and returns the maxHitCount nearest hits of each ray. */
+RTC_API void rtcIntersectMulti8(const int* valid, RTCScene scene, struct RTCRayHit8* rayhit, unsigned int maxHitCount, struct RTCMultiHit* hits, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
+
+/* Intersects a packet of 16 rays with the scene and returns the maxHitCount nearest hits of each ray. */
+RTC_API void rtcIntersectMulti16(const int* valid, RTCScene scene, struct RTCRayHit16* rayhit, unsigned int maxHitCount, struct RTCMultiHit* hits, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
+
+/* Maximal number of rays of a tile. */
+#define RTC_MAX_TILE_RAY_COUNT 256
+
+/* Intersects a tile of width*height coherent rays stored in row-major order with the scene. */
+RTC_API void rtcIntersectTile(RTCScene scene, struct RTCRayHit* rayhits, unsigned int width, unsigned int height, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
+
+/* Intersects a single ray cone with the scene and returns the footprint of the cone at the nearest hit. */
+RTC_API void rtcIntersectCone1(RTCScene scene, struct RTCRayHit* rayhit, const struct RTCRayCone* cone, struct RTCRayConeHit* footprint, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
+
 
 /* Forwards ray inside user geometry callback. */
 RTC_SYCL_API void rtcForwardIntersect1(const struct RTCIntersectFunctionNArguments* args, RTCScene scene, struct RTCRay* ray, unsigned int instID);
@@ -207,6 +229,12 @@ RTC_API void rtcOccluded8(const int* valid, RTCScene scene, struct RTCRay8* ray,
 /* Tests a packet of 16 rays for occlusion with the scene. */
 RTC_API void rtcOccluded16(const int* valid, RTCScene scene, struct RTCRay16* ray, struct RTCOccludedArguments* args RTC_OPTIONAL_ARGUMENT);
 
+/* Tests a tile of width*height coherent rays stored in row-major order for occlusion with the scene. */
+RTC_API void rtcOccludedTile(RTCScene scene, struct RTCRay* rays, unsigned int width, unsigned int height, struct RTCOccludedArguments* args RTC_OPTIONAL_ARGUMENT);
+
+/* Tests groups of rays sharing an origin or a light for occlusion with the scene, group i holds the rays groupOffsets[i] to groupOffsets[i+1]-1. */
+RTC_API void rtcOccludedBatch(RTCScene scene, struct RTCRay* rays, const unsigned int* groupOffsets, unsigned int numGroups, struct RTCOccludedArguments* args RTC_OPTIONAL_ARGUMENT);
+
 
 /* Forwards single occlusion ray inside user geometry callback. */
 RTC_SYCL_API void rtcForwardOccluded1(const struct RTCOccludedFunctionNArguments* args, RTCScene scene, struct RTCRay* ray, unsigned int instID);
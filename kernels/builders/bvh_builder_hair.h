@@ -69,7 +69,8 @@ namespace embree
                     const SetUnalignedNodeFunc& setUnalignedNode,
                     const CreateLeafFunc& createLeaf,
                     const ProgressMonitor& progressMonitor,
-                    const Settings settings)
+                    const Settings settings,
+                    const unsigned unalignedTypes)
 
             : cfg(settings),
             prims(prims),
@@ -80,6 +81,7 @@ namespace embree
             setUnalignedNode(setUnalignedNode),
             createLeaf(createLeaf),
             progressMonitor(progressMonitor),
+            unalignedTypes(unalignedTypes),
             alignedHeuristic(prims), unalignedHeuristic(scene,prims), strandHeuristic(scene,prims) {}
 
           /*! creates a large leaf that could be larger than supported by the BVH */
@@ -140,6 +142,11 @@ namespace embree
             return node;
           }
 
+          /*! checks if primitives of the set can get bound by oriented bounding boxes */
+          __forceinline bool isUnalignedType(const PrimInfoRange& pinfo) const {
+            return pinfo.oneType() && (pinfo.types & unalignedTypes);
+          }
+
           /*! performs split */
           __noinline void split(const PrimInfoRange& pinfo, PrimInfoRange& linfo, PrimInfoRange& rinfo, bool& aligned) // FIXME: not inlined as ICC otherwise uses much stack
           {
@@ -160,7 +167,7 @@ namespace embree
             UnalignedHeuristicBinningSAH::Split unalignedObjectSplit;
             LinearSpace3fa uspace;
             float unalignedObjectSAH = inf;
-            if (pinfo.isType(Leaf::TY_HAIR) && bestSAH > 0.7f*leafSAH) {
+            if (isUnalignedType(pinfo) && bestSAH > 0.7f*leafSAH) {
               uspace = unalignedHeuristic.computeAlignedSpace(pinfo);
               const PrimInfoRange sinfo = unalignedHeuristic.computePrimInfo(pinfo,uspace);
               unalignedObjectSplit = unalignedHeuristic.find(sinfo,0,uspace);
@@ -295,7 +302,7 @@ namespace embree
                 parallel_for(size_t(0), numChildren, [&] (const range<size_t>& r) {
                     for (size_t i=r.begin(); i<r.end(); i++) {
                       NodeRef child = recurse(depth+1,children[i],nullptr,true);
-                      if (children[i].isType(Leaf::TY_HAIR)) {
+                      if (isUnalignedType(children[i])) {
                         const LinearSpace3fa space = unalignedHeuristic.computeAlignedSpace(children[i]);
                         const PrimInfoRange sinfo = unalignedHeuristic.computePrimInfo(children[i],space);
                         const OBBox3fa obounds(space,sinfo.geomBounds);
@@ -312,7 +319,7 @@ namespace embree
               {
                 for (size_t i=0; i<numChildren; i++) {
                   NodeRef child = recurse(depth+1,children[i],alloc,false);
-                  if (children[i].isType(Leaf::TY_HAIR)) {
+                  if (isUnalignedType(children[i])) {
                     const LinearSpace3fa space = unalignedHeuristic.computeAlignedSpace(children[i]);
                     const PrimInfoRange sinfo = unalignedHeuristic.computePrimInfo(children[i],space);
                     const OBBox3fa obounds(space,sinfo.geomBounds);
@@ -336,6 +343,7 @@ namespace embree
           const SetUnalignedNodeFunc& setUnalignedNode;
           const CreateLeafFunc& createLeaf;
           const ProgressMonitor& progressMonitor;
+          const unsigned unalignedTypes;  //!< mask of primitive types that may get bound by oriented bounding boxes
 
         private:
           HeuristicBinningSAH alignedHeuristic;
@@ -362,7 +370,8 @@ namespace embree
                               Scene* scene,
                               PrimRef* prims,
                               const PrimInfo& pinfo,
-                              const Settings settings)
+                              const Settings settings,
+                              const unsigned unalignedTypes = Leaf::typeMask(Leaf::TY_HAIR))
         {
           typedef BuilderT<NodeRef,
             CreateAllocFunc,
@@ -373,7 +382,7 @@ namespace embree
           Builder builder(scene,prims,createAlloc,
                           createAlignedNode,setAlignedNode,
                           createUnalignedNode,setUnalignedNode,
-                          createLeaf,progressMonitor,settings);
+                          createLeaf,progressMonitor,settings,unalignedTypes);
 
           NodeRef root = builder.recurse(1,pinfo,nullptr,true);
           _mm_mfence(); // to allow non-temporal stores during build
@@ -23,6 +23,7 @@
 #include "../common/primref_mb.h"
 #include "heuristic_binning_array_aligned.h"
 #include "heuristic_timesplit_array.h"
+#include "timestep_bounds_table.h"
 
 namespace embree
 {
@@ -120,18 +121,19 @@ namespace embree
       struct RecalculatePrimRef
       {
         Scene* scene;
+        const TimeStepBoundsTable* table; //!< optional cached bounds of all time steps
 
-        __forceinline RecalculatePrimRef (Scene* scene)
-          : scene(scene) {}
+        __forceinline RecalculatePrimRef (Scene* scene, const TimeStepBoundsTable* table = nullptr)
+          : scene(scene), table(table) {}
 
         __forceinline PrimRefMB operator() (const PrimRefMB& prim, const BBox1f time_range) const
         {
           const unsigned geomID = prim.geomID();
           const unsigned primID = prim.primID();
           const Mesh* mesh = scene->get<Mesh>(geomID);
-          const LBBox3fa lbounds = mesh->linearBounds(primID, time_range);
+          const LBBox3fa lbounds = table ? table->linearBounds(mesh, geomID, primID, time_range) : mesh->linearBounds(primID, time_range);
           const unsigned num_time_segments = mesh->numTimeSegments();
-          const range<int> tbounds = getTimeSegmentRange(time_range, (float)num_time_segments);
+          const range<int> tbounds = mesh->timeSegmentRange(time_range);
           return PrimRefMB (lbounds, tbounds.size(), num_time_segments, prim.type(), geomID, primID);
         }
 
@@ -143,18 +145,29 @@ namespace embree
           const Mesh* mesh = scene->get<Mesh>(geomID);
           const LBBox3fa lbounds = mesh->linearBounds(space, primID, time_range);
           const unsigned num_time_segments = mesh->numTimeSegments();
-          const range<int> tbounds = getTimeSegmentRange(time_range, (float)num_time_segments);
+          const range<int> tbounds = mesh->timeSegmentRange(time_range);
           return PrimRefMB (lbounds, tbounds.size(), num_time_segments, prim.type(), geomID, primID);
         }
 
-        __forceinline LBBox3fa linearBounds(const PrimRefMB& prim, const BBox1f time_range) const {
-          return scene->get<Mesh>(prim.geomID())->linearBounds(prim.primID(), time_range);
+        __forceinline LBBox3fa linearBounds(const PrimRefMB& prim, const BBox1f time_range) const 
+        {
+          const Mesh* mesh = scene->get<Mesh>(prim.geomID());
+          if (table) return table->linearBounds(mesh, prim.geomID(), prim.primID(), time_range);
+          return mesh->linearBounds(prim.primID(), time_range);
         }
 
         // __noinline is workaround for ICC16 bug under MacOSX
         __noinline LBBox3fa linearBounds(const PrimRefMB& prim, const BBox1f time_range, const LinearSpace3fa& space) const {
           return scene->get<Mesh>(prim.geomID())->linearBounds(space, prim.primID(), time_range);
         }
+
+        __forceinline range<int> timeSegmentRange(const PrimRefMB& prim, const BBox1f time_range) const {
+          return scene->get<Mesh>(prim.geomID())->timeSegmentRange(time_range);
+        }
+
+        __forceinline float timeStep(const PrimRefMB& prim, size_t itime) const {
+          return scene->get<Mesh>(prim.geomID())->timeStep(itime);
+        }
       };
 
     struct VirtualRecalculatePrimRef
@@ -171,7 +184,7 @@ namespace embree
         const Geometry* mesh = scene->get(geomID);
         const LBBox3fa lbounds = mesh->virtualLinearBounds(primID, time_range);
         const unsigned num_time_segments = mesh->numTimeSegments();
-        const range<int> tbounds = getTimeSegmentRange(time_range, num_time_segments);
+        const range<int> tbounds = mesh->timeSegmentRange(time_range);
         return PrimRefMB (lbounds, tbounds.size(), num_time_segments, prim.type(), geomID, primID);
       }
 
@@ -182,7 +195,7 @@ namespace embree
         const Geometry* geom = scene->get(geomID);
         const LBBox3fa lbounds = geom->virtualLinearBounds(space, primID, time_range);
         const unsigned num_time_segments = geom->numTimeSegments();
-        const range<int> tbounds = getTimeSegmentRange(time_range, (float)num_time_segments);
+        const range<int> tbounds = geom->timeSegmentRange(time_range);
         return PrimRefMB (lbounds, tbounds.size(), num_time_segments, prim.type(), geomID, primID);
       }
 
@@ -193,6 +206,14 @@ namespace embree
       __forceinline LBBox3fa linearBounds(const PrimRefMB& prim, const BBox1f time_range, const LinearSpace3fa& space) const {
         return scene->get(prim.geomID())->virtualLinearBounds(space, prim.primID(), time_range);
       }
+
+      __forceinline range<int> timeSegmentRange(const PrimRefMB& prim, const BBox1f time_range) const {
+        return scene->get(prim.geomID())->timeSegmentRange(time_range);
+      }
+
+      __forceinline float timeStep(const PrimRefMB& prim, size_t itime) const {
+        return scene->get(prim.geomID())->timeStep(itime);
+      }
     };
     
     struct BVHBuilderMSMBlur
@@ -375,10 +396,11 @@ namespace embree
               for (size_t i=set.object_range.begin(); i<set.object_range.end(); i++)
               {
                 const PrimRefMB& prim = (*set.prims)[i];
-                const range<int> itime_range = getTimeSegmentRange(set.time_range,(float)prim.totalTimeSegments());
+                const range<int> itime_range = recalculatePrimRef.timeSegmentRange(prim,set.time_range);
                 if (itime_range.size() > 1) {
+                  /* split at a time step of the primitive, which might not be uniformly spaced */
                   const int icenter = (itime_range.begin() + itime_range.end())/2;
-                  const float splitTime = float(icenter)/float(prim.totalTimeSegments());
+                  const float splitTime = recalculatePrimRef.timeStep(prim,icenter);
                   return Split(0.0f,(unsigned)Split::SPLIT_TEMPORAL,0,splitTime);
                 }
               }
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "heuristic_binning_array_aligned.h"
+#include "heuristic_binning_array_morton.h"
 #include "heuristic_spatial_array.h"
 #include "heuristic_openmerge_array.h"
 
@@ -34,7 +35,7 @@ namespace embree
   {
     struct GeneralBVHBuilder
     {
-      static const size_t MAX_BRANCHING_FACTOR = 8;        //!< maximal supported BVH branching factor
+      static const size_t MAX_BRANCHING_FACTOR = 8;        //!< maximal supported BVH branching factor of all but the 16-wide builders
       static const size_t MIN_LARGE_LEAF_LEVELS = 8;        //!< create balanced tree of we are that many levels before the maximal tree depth
 
       typedef CommonBuildSettings Settings;
@@ -75,7 +76,8 @@ namespace embree
         typename CreateNodeFunc,
         typename UpdateNodeFunc,
         typename CreateLeafFunc,
-        typename ProgressMonitor>
+        typename ProgressMonitor,
+        size_t MaxBranchingFactor>
 
         class BuilderT
         {
@@ -96,7 +98,7 @@ namespace embree
             createAlloc(createAlloc), createNode(createNode), updateNode(updateNode), createLeaf(createLeaf),
             progressMonitor(progressMonitor)
           {
-            if (cfg.branchingFactor > MAX_BRANCHING_FACTOR)
+            if (cfg.branchingFactor > MaxBranchingFactor)
               throw_RTCError(RTC_UNKNOWN_ERROR,"bvh_builder: branching factor too large");
           }
 
@@ -114,8 +116,8 @@ namespace embree
               return createLeaf(prims,current.prims,alloc);
 
             /* fill all children by always splitting the largest one */
-            ReductionTy values[MAX_BRANCHING_FACTOR];
-            BuildRecord children[MAX_BRANCHING_FACTOR];
+            ReductionTy values[MaxBranchingFactor];
+            BuildRecord children[MaxBranchingFactor];
             size_t numChildren = 1;
             children[0] = current;
             do {
@@ -195,8 +197,8 @@ namespace embree
             heuristic.split(split,current.prims,lprims,rprims);
 
             /*! initialize child list with initial split */
-            ReductionTy values[MAX_BRANCHING_FACTOR];
-            BuildRecord children[MAX_BRANCHING_FACTOR];
+            ReductionTy values[MaxBranchingFactor];
+            BuildRecord children[MaxBranchingFactor];
             children[0] = BuildRecord(current.depth+1,lprims);
             children[1] = BuildRecord(current.depth+1,rprims);
             size_t numChildren = 2;
@@ -281,6 +283,7 @@ namespace embree
         typename Heuristic,
         typename Set,
         typename PrimRef,
+        size_t MaxBranchingFactor = MAX_BRANCHING_FACTOR,
         typename CreateAllocFunc,
         typename CreateNodeFunc,
         typename UpdateNodeFunc,
@@ -309,7 +312,8 @@ namespace embree
           CreateNodeFunc,
           UpdateNodeFunc,
           CreateLeafFunc,
-          ProgressMonitor> Builder;
+          ProgressMonitor,
+          MaxBranchingFactor> Builder;
 
         /* instantiate builder */
         Builder builder(prims,
@@ -330,7 +334,8 @@ namespace embree
     };
 
     /* SAH builder that operates on an array of BuildRecords */
-    struct BVHBuilderBinnedSAH
+    template<size_t MaxBranchingFactor>
+    struct BVHBuilderBinnedSAHT
     {
       typedef PrimInfoRange Set;
       typedef HeuristicArrayBinningSAH<PrimRef,NUM_OBJECT_BINS> Heuristic;
@@ -354,7 +359,55 @@ namespace embree
                                  const Settings& settings)
       {
         Heuristic heuristic(prims);
-        return GeneralBVHBuilder::build<ReductionTy,Heuristic,Set,PrimRef>(
+        return GeneralBVHBuilder::build<ReductionTy,Heuristic,Set,PrimRef,MaxBranchingFactor>(
+          heuristic,
+          prims,
+          PrimInfoRange(0,pinfo.size(),pinfo),
+          createAlloc,
+          createNode,
+          updateNode,
+          createLeaf,
+          progressMonitor,
+          settings);
+      }
+    };
+
+    typedef BVHBuilderBinnedSAHT<GeneralBVHBuilder::MAX_BRANCHING_FACTOR> BVHBuilderBinnedSAH;
+
+    /* SAH builder that splits the upper levels in Morton order and bins the lower levels */
+    template<size_t MaxBranchingFactor>
+    struct BVHBuilderHybridSAHT
+    {
+      typedef PrimInfoRange Set;
+      typedef HeuristicArrayMortonBinningSAH<PrimRef,NUM_OBJECT_BINS> Heuristic;
+      typedef GeneralBVHBuilder::BuildRecordT<Set,typename Heuristic::Split> BuildRecord;
+      typedef GeneralBVHBuilder::Settings Settings;
+
+      /*! minimal range size to split in Morton order, 256K for the default threshold of 16M primitives */
+      static __forceinline size_t minSortedSize(size_t mortonSplitThreshold) {
+        return max(mortonSplitThreshold/64,4*Heuristic::BLOCK_SIZE);
+      }
+
+      /*! special builder that propagates reduction over the tree */
+      template<
+      typename ReductionTy,
+        typename CreateAllocFunc,
+        typename CreateNodeFunc,
+        typename UpdateNodeFunc,
+        typename CreateLeafFunc,
+        typename ProgressMonitor>
+
+        static ReductionTy build(MemoryMonitorInterface* device,
+                                 CreateAllocFunc createAlloc,
+                                 CreateNodeFunc createNode, UpdateNodeFunc updateNode,
+                                 const CreateLeafFunc& createLeaf,
+                                 const ProgressMonitor& progressMonitor,
+                                 PrimRef* prims, const PrimInfo& pinfo,
+                                 const size_t minSortedSize,
+                                 const Settings& settings)
+      {
+        Heuristic heuristic(device,prims,pinfo,minSortedSize);
+        return GeneralBVHBuilder::build<ReductionTy,Heuristic,Set,PrimRef,MaxBranchingFactor>(
           heuristic,
           prims,
           PrimInfoRange(0,pinfo.size(),pinfo),
@@ -367,6 +420,8 @@ namespace embree
       }
     };
 
+    typedef BVHBuilderHybridSAHT<GeneralBVHBuilder::MAX_BRANCHING_FACTOR> BVHBuilderHybridSAH;
+
     /* Spatial SAH builder that operates on an double-buffered array of BuildRecords */
     struct BVHBuilderBinnedFastSpatialSAH
     {
@@ -0,0 +1,167 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "heuristic_binning_array_aligned.h"
+#include "bvh_builder_morton.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Split of the hybrid heuristic, either a position in the Morton
+     *  sorted primitive array or a regular object binning split. */
+    template<size_t BINS>
+      struct MortonBinSplit
+      {
+        __forceinline MortonBinSplit () {}
+
+        __forceinline MortonBinSplit (const BinSplit<BINS>& binSplit)
+          : sah(binSplit.sah), pos(0), binSplit(binSplit) {}
+
+        __forceinline MortonBinSplit (float sah, size_t pos, const CentGeomBBox3fa& left, const CentGeomBBox3fa& right)
+          : sah(sah), pos(pos), left(left), right(right) {}
+
+        /*! calculates surface area heuristic for performing the split */
+        __forceinline float splitSAH() const { return sah; }
+
+        /*! tests if this split is performed in Morton order */
+        __forceinline bool sorted() const { return pos != 0; }
+
+      public:
+        float sah;                 //!< SAH cost of the split
+        size_t pos;                //!< split position in the primitive array for splits in Morton order
+        CentGeomBBox3fa left;      //!< bounds of the left primitives for splits in Morton order
+        CentGeomBBox3fa right;     //!< bounds of the right primitives for splits in Morton order
+        BinSplit<BINS> binSplit;   //!< object binning split
+      };
+
+    /*! Sorts the primitives once along a Morton curve and finds the splits
+     *  of large ranges by an SAH sweep over the bounds of fixed size blocks
+     *  of sorted primitives. These splits only touch the small block bounds
+     *  array and do not move primitives. Ranges below minSortedSize fall
+     *  back to object binning. */
+    template<typename PrimRef, size_t BINS>
+      struct HeuristicArrayMortonBinningSAH
+      {
+        typedef MortonBinSplit<BINS> Split;
+        typedef HeuristicArrayBinningSAH<PrimRef,BINS> Binning;
+        typedef BVHBuilderMorton::BuildPrim BuildPrim;
+
+        static const size_t BLOCK_SIZE = 256;             //!< number of sorted primitives merged into one block
+
+        HeuristicArrayMortonBinningSAH (MemoryMonitorInterface* device, PrimRef* prims, const PrimInfo& pinfo, const size_t minSortedSize)
+          : binning(prims), minSortedSize(minSortedSize),
+            blocks(device,(pinfo.size()+BLOCK_SIZE-1)/BLOCK_SIZE), rightSAH(device,blocks.size())
+        {
+          const size_t numPrimitives = pinfo.size();
+          mvector<BuildPrim> morton(device,numPrimitives);
+          mvector<PrimRef> sorted(device,numPrimitives);
+
+          /* sort primitives by the Morton code of their centroids, the sorted
+           * primitives are not written yet and serve as temporary buffer */
+          static_assert(sizeof(PrimRef) >= sizeof(BuildPrim), "sorted primitives too small for radix sort temporaries");
+          const BVHBuilderMorton::MortonCodeMapping mapping(pinfo.centBounds);
+          parallel_for(size_t(0), numPrimitives, size_t(1024), [&] (const range<size_t>& r) {
+              for (size_t i=r.begin(); i<r.end(); i++) {
+                morton[i].code = mapping.code(prims[i].bounds());
+                morton[i].index = (unsigned int)i;
+              }
+            });
+          radix_sort_u32(morton.data(),(BuildPrim*)sorted.data(),numPrimitives);
+
+          /* reorder primitives and compute bounds of each block */
+          parallel_for(size_t(0), numPrimitives, size_t(1024), [&] (const range<size_t>& r) {
+              for (size_t i=r.begin(); i<r.end(); i++)
+                sorted[i] = prims[morton[i].index];
+            });
+
+          parallel_for(size_t(0), blocks.size(), size_t(16), [&] (const range<size_t>& r) {
+              for (size_t b=r.begin(); b<r.end(); b++)
+              {
+                CentGeomBBox3fa bounds(empty);
+                for (size_t i=b*BLOCK_SIZE; i<min((b+1)*BLOCK_SIZE,numPrimitives); i++) {
+                  prims[i] = sorted[i];
+                  bounds.extend_center2(sorted[i]);
+                }
+                blocks[b] = bounds;
+              }
+            });
+        }
+
+        /*! tests if a range still is in Morton order, binned splits only produce ranges below minSortedSize */
+        __forceinline bool isSorted(const PrimInfoRange& set) const {
+          return set.size() >= minSortedSize && set.begin() % BLOCK_SIZE == 0;
+        }
+
+        /*! finds the best split */
+        __noinline const Split find(const PrimInfoRange& set, const size_t logBlockSize)
+        {
+          if (isSorted(set)) return find_sorted(set,logBlockSize);
+          return Split(binning.find(set,logBlockSize));
+        }
+
+        /*! SAH sweep over the blocks of a Morton sorted range */
+        const Split find_sorted(const PrimInfoRange& set, const size_t logBlockSize)
+        {
+          const size_t blocks_add = (size_t(1) << logBlockSize)-1;
+          const size_t begin = set.begin()/BLOCK_SIZE;
+          const size_t end = (set.end()+BLOCK_SIZE-1)/BLOCK_SIZE;
+
+          /* sweep from the right to get the SAH of all right halves, sorted
+           * ranges cover disjoint blocks thus parallel sweeps never share entries */
+          CentGeomBBox3fa right(empty);
+          for (size_t b=end-1; b>begin; b--) {
+            right.merge(blocks[b]);
+            const size_t rCount = (set.end()-b*BLOCK_SIZE+blocks_add) >> logBlockSize;
+            rightSAH[b] = expectedApproxHalfArea(right.geomBounds)*float(rCount);
+          }
+
+          /* sweep from the left to find the best split position */
+          float bestSAH = inf;
+          size_t bestBlock = begin+1;
+          CentGeomBBox3fa left(empty), bestLeft(empty);
+          for (size_t b=begin+1; b<end; b++)
+          {
+            left.merge(blocks[b-1]);
+            const size_t lCount = (b*BLOCK_SIZE-set.begin()+blocks_add) >> logBlockSize;
+            const float sah = expectedApproxHalfArea(left.geomBounds)*float(lCount) + rightSAH[b];
+            if (sah < bestSAH) {
+              bestSAH = sah; bestBlock = b; bestLeft = left;
+            }
+          }
+
+          CentGeomBBox3fa bestRight(empty);
+          for (size_t b=bestBlock; b<end; b++)
+            bestRight.merge(blocks[b]);
+
+          return Split(bestSAH,bestBlock*BLOCK_SIZE,bestLeft,bestRight);
+        }
+
+        /*! array partitioning, splits in Morton order do not move primitives */
+        __forceinline void split(const Split& split, const PrimInfoRange& set, PrimInfoRange& lset, PrimInfoRange& rset)
+        {
+          if (!split.sorted())
+            return binning.split(split.binSplit,set,lset,rset);
+
+          new (&lset) PrimInfoRange(set.begin(),split.pos,split.left);
+          new (&rset) PrimInfoRange(split.pos,set.end(),split.right);
+        }
+
+        void deterministic_order(const PrimInfoRange& set) {
+          binning.deterministic_order(set);
+        }
+
+        void splitFallback(const PrimInfoRange& set, PrimInfoRange& lset, PrimInfoRange& rset) {
+          binning.splitFallback(set,lset,rset);
+        }
+
+      private:
+        Binning binning;                  //!< object binning for the lower levels
+        const size_t minSortedSize;       //!< minimal range size to split in Morton order
+        mvector<CentGeomBBox3fa> blocks;  //!< bounds of each block of Morton sorted primitives
+        mvector<float> rightSAH;          //!< SAH of the right halves per block of the current sweep
+      };
+  }
+}
@@ -22,10 +22,45 @@ namespace embree
 {
   namespace isa
   { 
+    /*! Dispatches the geometry specific queries required to bin primitives in unaligned spaces. */
+    struct UnalignedPrimitive
+    {
+      /*! returns the bounds of the primitive in the specified space */
+      static __forceinline BBox3fa bounds(Scene* scene, const LinearSpace3fa& space, const embree::PrimRef& prim)
+      {
+        const unsigned geomID = prim.geomID();
+        const unsigned primID = prim.primID();
+        switch (prim.type()) {
+        case Leaf::TY_TRIANGLE: return ((TriangleMesh*) scene->get(geomID))->bounds(space,primID);
+        case Leaf::TY_QUAD    : return ((QuadMesh*    ) scene->get(geomID))->bounds(space,primID);
+        default               : return ((NativeCurves*) scene->get(geomID))->bounds(space,primID);
+        }
+      }
+
+      /*! returns the (unnormalized) main direction of the primitive */
+      static __forceinline Vec3fa direction(Scene* scene, const embree::PrimRef& prim)
+      {
+        const unsigned geomID = prim.geomID();
+        const unsigned primID = prim.primID();
+        switch (prim.type()) {
+        case Leaf::TY_TRIANGLE: return ((TriangleMesh*) scene->get(geomID))->direction(primID);
+        case Leaf::TY_QUAD    : return ((QuadMesh*    ) scene->get(geomID))->direction(primID);
+        default: {
+          NativeCurves* mesh = (NativeCurves*) scene->get(geomID);
+          const unsigned vtxID = mesh->curve(primID);
+          const Curve3fa curve(mesh->vertex(vtxID+0),mesh->vertex(vtxID+1),mesh->vertex(vtxID+2),mesh->vertex(vtxID+3));
+          return curve.end() - curve.begin();
+        }
+        }
+      }
+    };
+
     /*! Performs standard object binning */
     template<typename PrimRef, size_t BINS>
       struct UnalignedHeuristicArrayBinningSAH
       {
+        static const size_t MAX_DIRECTION_SAMPLES = 256; //!< maximal number of primitives sampled to estimate the main direction of meshes
+
         typedef BinSplit<BINS> Split;
         typedef BinInfoT<BINS,PrimRef,BBox3fa> Binner;
         typedef range<size_t> Set;
@@ -39,24 +74,35 @@ namespace embree
 
         const LinearSpace3fa computeAlignedSpace(const range<size_t>& set)
         {
-          /*! find first curve that defines valid direction */
           Vec3fa axis(0,0,1);
-          for (size_t i=set.begin(); i<set.end(); i++)
+          if (set.size() == 0)
+            return frame(axis).transposed();
+
+          /*! find first curve that defines valid direction */
+          if (prims[set.begin()].type() == Leaf::TY_HAIR)
           {
-            NativeCurves* mesh = (NativeCurves*) scene->get(prims[i].geomID());
-            const unsigned vtxID = mesh->curve(prims[i].primID());
-            const Vec3fa v0 = mesh->vertex(vtxID+0);
-            const Vec3fa v1 = mesh->vertex(vtxID+1);
-            const Vec3fa v2 = mesh->vertex(vtxID+2);
-            const Vec3fa v3 = mesh->vertex(vtxID+3);
-            const Curve3fa curve(v0,v1,v2,v3);
-            const Vec3fa p0 = curve.begin();
-            const Vec3fa p3 = curve.end();
-            const Vec3fa axis1 = normalize(p3 - p0);
-            if (sqr_length(p3-p0) > 1E-18f) {
-              axis = axis1;
-              break;
+            for (size_t i=set.begin(); i<set.end(); i++)
+            {
+              const Vec3fa dir = UnalignedPrimitive::direction(scene,prims[i]);
+              if (sqr_length(dir) > 1E-18f) {
+                axis = normalize(dir);
+                break;
+              }
+            }
+          }
+
+          /*! thin triangles and quads vary more per primitive, thus accumulate the main direction over a subset of primitives */
+          else
+          {
+            const size_t step = max(size_t(1),set.size()/MAX_DIRECTION_SAMPLES);
+            Vec3fa accum(zero);
+            for (size_t i=set.begin(); i<set.end(); i+=step)
+            {
+              const Vec3fa dir = UnalignedPrimitive::direction(scene,prims[i]);
+              accum += dot(dir,accum) < 0.0f ? Vec3fa(-dir) : dir;
             }
+            if (sqr_length(accum) > 1E-18f)
+              axis = normalize(accum);
           }
           return frame(axis).transposed();
         }
@@ -66,10 +112,8 @@ namespace embree
           auto computeBounds = [&](const range<size_t>& r) -> CentGeomBBox3fa
             {
               CentGeomBBox3fa bounds(empty);
-              for (size_t i=r.begin(); i<r.end(); i++) {
-                NativeCurves* mesh = (NativeCurves*) scene->get(prims[i].geomID());
-                bounds.extend(mesh->bounds(space,prims[i].primID()),prims[i].type());
-              }
+              for (size_t i=r.begin(); i<r.end(); i++)
+                bounds.extend(UnalignedPrimitive::bounds(scene,space,prims[i]),prims[i].type());
               return bounds;
             };
           
@@ -87,16 +131,14 @@ namespace embree
             /*! returns center for binning */
           __forceinline Vec3fa binCenter(const PrimRef& ref) const
           {
-            NativeCurves* mesh = (NativeCurves*) scene->get(ref.geomID());
-            BBox3fa bounds = mesh->bounds(space,ref.primID());
+            BBox3fa bounds = UnalignedPrimitive::bounds(scene,space,ref);
             return embree::center2(bounds);
           }
           
           /*! returns bounds and centroid used for binning */
           __forceinline void binBoundsAndCenter(const PrimRef& ref, BBox3fa& bounds_o, Vec3fa& center_o) const
           {
-            NativeCurves* mesh = (NativeCurves*) scene->get(ref.geomID());
-            BBox3fa bounds = mesh->bounds(space,ref.primID());
+            BBox3fa bounds = UnalignedPrimitive::bounds(scene,space,ref);
             bounds_o = bounds;
             center_o = embree::center2(bounds);
           }
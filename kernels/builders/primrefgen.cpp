@@ -23,47 +23,174 @@ namespace embree
 {
   namespace isa
   {
+    /*! Index and vertex buffer access of meshes whose primrefs get generated vectorized */
     template<typename Mesh>
-    PrimInfo createPrimRefArray(Mesh* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
+    struct PrimRefGenSIMD
     {
-      ParallelPrefixSumState<PrimInfo> pstate;
-      /* first try */
-      progressMonitor(0);
-      PrimInfo pinfo = parallel_prefix_sum( pstate, size_t(0), mesh->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo
+      static const int NV = 0;
+    };
+
+    template<>
+    struct PrimRefGenSIMD<TriangleMesh>
+    {
+      static const int NV = 3;
+      static __forceinline const APIBuffer<TriangleMesh::Triangle>& indices(const TriangleMesh* mesh) { return mesh->triangles; }
+    };
+
+    template<>
+    struct PrimRefGenSIMD<QuadMesh>
+    {
+      static const int NV = 4;
+      static __forceinline const APIBuffer<QuadMesh::Quad>& indices(const QuadMesh* mesh) { return mesh->quads; }
+    };
+
+    template<typename Mesh>
+    __forceinline PrimInfo createPrimRefs(Mesh* mesh, const range<size_t>& r, PrimRef* prims, size_t k, std::false_type)
+    {
+      PrimInfo pinfo(empty);
+      Leaf::Type ty = mesh->leafType();
+      for (size_t j=r.begin(); j<r.end(); j++)
       {
-        size_t k = r.begin();
-        PrimInfo pinfo(empty);
-        Leaf::Type ty = mesh->leafType();
-        for (size_t j=r.begin(); j<r.end(); j++)
+        BBox3fa bounds = empty;
+        if (!mesh->buildBounds(j,&bounds)) continue;
+        const PrimRef prim(bounds,ty,mesh->geomID,unsigned(j));
+        pinfo.add_center2(prim);
+        prims[k++] = prim;
+      }
+      return pinfo;
+    }
+
+    /* calculates the bounds of VSIZEX primitives at once by gathering their vertices in SoA layout */
+    template<typename Mesh>
+    __forceinline PrimInfo createPrimRefs(Mesh* mesh, const range<size_t>& r, PrimRef* prims, size_t k, std::true_type)
+    {
+      typedef PrimRefGenSIMD<Mesh> Gen;
+      const auto& indices = Gen::indices(mesh);
+      const size_t numVertices = mesh->numVertices();
+      const size_t indexStride = indices.getStride();
+      const size_t vertexStride = mesh->vertices0.getStride();
+
+      /* the gathers use 32 bit offsets to float3 vertices of a single time step */
+      if (mesh->numTimeSteps != 1 || mesh->hasCompactVertices() || numVertices == 0 ||
+          indexStride%4 != 0 || vertexStride%4 != 0 || numVertices*(vertexStride/4) > size_t(std::numeric_limits<int>::max()))
+        return createPrimRefs(mesh,r,prims,k,std::false_type());
+
+      const Leaf::Type ty = mesh->leafType();
+      const float* vertices = (const float*) mesh->vertices0.getPtr(0);
+      const vintx lane = vintx(step)*int(indexStride/4);
+      Vec3vfx geomLower(pos_inf), geomUpper(neg_inf);
+      Vec3vfx centLower(pos_inf), centUpper(neg_inf);
+      const size_t k0 = k;
+
+      for (size_t j=r.begin(); j<r.end(); j+=VSIZEX)
+      {
+        vboolx valid = vintx(step) < vintx(int(min(r.end()-j,size_t(VSIZEX))));
+        const int* index = (const int*) indices.getPtr(j);
+
+        Vec3vfx lower(pos_inf), upper(neg_inf);
+        for (int v=0; v<Gen::NV; v++)
         {
-          BBox3fa bounds = empty;
-          if (!mesh->buildBounds(j,&bounds)) continue;
-          const PrimRef prim(bounds,ty,mesh->geomID,unsigned(j));          
-          pinfo.add_center2(prim);
-          prims[k++] = prim;
+          const vintx vtx = vintx::gather(valid,index,lane+v);
+          valid &= (vtx >= vintx(zero)) & (vtx < vintx(int(numVertices)));
+          const vintx ofs = vtx*int(vertexStride/4);
+          const Vec3vfx p(vfloatx::gather(valid,vertices,ofs+0),
+                          vfloatx::gather(valid,vertices,ofs+1),
+                          vfloatx::gather(valid,vertices,ofs+2));
+          valid &= (p.x > vfloatx(-FLT_LARGE)) & (p.x < vfloatx(+FLT_LARGE));
+          valid &= (p.y > vfloatx(-FLT_LARGE)) & (p.y < vfloatx(+FLT_LARGE));
+          valid &= (p.z > vfloatx(-FLT_LARGE)) & (p.z < vfloatx(+FLT_LARGE));
+          lower = min(lower,p);
+          upper = max(upper,p);
         }
-        return pinfo;
+
+        /* the PrimInfo gets reduced over the valid lanes */
+        const Vec3vfx center2 = lower+upper;
+        geomLower = Vec3vfx(select(valid,min(geomLower.x,lower.x),geomLower.x),select(valid,min(geomLower.y,lower.y),geomLower.y),select(valid,min(geomLower.z,lower.z),geomLower.z));
+        geomUpper = Vec3vfx(select(valid,max(geomUpper.x,upper.x),geomUpper.x),select(valid,max(geomUpper.y,upper.y),geomUpper.y),select(valid,max(geomUpper.z,upper.z),geomUpper.z));
+        centLower = Vec3vfx(select(valid,min(centLower.x,center2.x),centLower.x),select(valid,min(centLower.y,center2.y),centLower.y),select(valid,min(centLower.z,center2.z),centLower.z));
+        centUpper = Vec3vfx(select(valid,max(centUpper.x,center2.x),centUpper.x),select(valid,max(centUpper.y,center2.y),centUpper.y),select(valid,max(centUpper.z,center2.z),centUpper.z));
+
+        /* primrefs are written with streaming stores as they are not read again before the build */
+        for (size_t m=movemask(valid); m; )
+        {
+          const size_t i = bscf(m);
+          const BBox3fa bounds(Vec3fa(lower.x[i],lower.y[i],lower.z[i]),Vec3fa(upper.x[i],upper.y[i],upper.z[i]));
+          const PrimRef prim(bounds,ty,mesh->geomID,unsigned(j+i));
+          vfloat4::store_nt(&prims[k].lower,vfloat4(prim.lower.m128));
+          vfloat4::store_nt(&prims[k].upper,vfloat4(prim.upper.m128));
+          k++;
+        }
+      }
+      _mm_sfence();
+
+      const size_t num = k-k0;
+      const BBox3fa geomBounds(Vec3fa(reduce_min(geomLower.x),reduce_min(geomLower.y),reduce_min(geomLower.z)),
+                               Vec3fa(reduce_max(geomUpper.x),reduce_max(geomUpper.y),reduce_max(geomUpper.z)));
+      const BBox3fa centBounds(Vec3fa(reduce_min(centLower.x),reduce_min(centLower.y),reduce_min(centLower.z)),
+                               Vec3fa(reduce_max(centUpper.x),reduce_max(centUpper.y),reduce_max(centUpper.z)));
+      return PrimInfo(0,num,CentGeomBBox3fa(geomBounds,centBounds,num ? Leaf::typeMask(ty) : 0));
+    }
+
+    /* generates the primrefs of a range of primitives of a mesh starting at the k'th primref */
+    template<typename Mesh>
+    __forceinline PrimInfo createPrimRefs(Mesh* mesh, const range<size_t>& r, PrimRef* prims, size_t k) {
+      return createPrimRefs(mesh,r,prims,k,std::integral_constant<bool,PrimRefGenSIMD<Mesh>::NV != 0>());
+    }
+
+    template<typename Mesh>
+    PrimInfo createPrimRefArray(Mesh* mesh, PrimRef* prims, size_t numPrims, BuildProgressMonitor& progressMonitor)
+    {
+      ParallelPrefixSumState<PrimInfo> pstate;
+      /* first try */
+      progressMonitor(0);
+      PrimInfo pinfo = parallel_prefix_sum( pstate, size_t(0), mesh->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo {
+        return createPrimRefs(mesh,r,prims,r.begin());
       }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
 
       /* if we need to filter out geometry, run again */
-      if (pinfo.size() != prims.size())
+      if (pinfo.size() != numPrims)
       {
         progressMonitor(0);
-        pinfo = parallel_prefix_sum( pstate, size_t(0), mesh->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo
+        pinfo = parallel_prefix_sum( pstate, size_t(0), mesh->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo {
+          return createPrimRefs(mesh,r,prims,base.size());
+        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+      }
+      return pinfo;
+    }
+
+    template<typename Mesh>
+    PrimInfo createPrimRefArray(Mesh* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor) {
+      return createPrimRefArray(mesh,prims.data(),prims.size(),progressMonitor);
+    }
+
+    template<typename Mesh>
+    PrimInfo updatePrimRefArray(Mesh* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
+    {
+      /* the primref array holds a reference for each primitive, only those using a modified vertex are updated */
+      progressMonitor(0);
+      mesh->dirtyVertices.normalize();
+      std::atomic<bool> invalid(false);
+      const PrimInfo pinfo = parallel_reduce( size_t(0), prims.size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r) -> PrimInfo
+      {
+        PrimInfo pinfo(empty);
+        for (size_t i=r.begin(); i<r.end(); i++)
         {
-          size_t k = base.size();
-          PrimInfo pinfo(empty);
-          Leaf::Type ty = mesh->leafType();
-          for (size_t j=r.begin(); j<r.end(); j++)
+          const unsigned primID = prims[i].primID();
+          if (mesh->primitiveModified(primID))
           {
             BBox3fa bounds = empty;
-            if (!mesh->buildBounds(j,&bounds)) continue;
-            const PrimRef prim(bounds,ty,mesh->geomID,unsigned(j));
-            pinfo.add_center2(prim);
-            prims[k++] = prim;
+            if (!mesh->buildBounds(primID,&bounds)) { invalid = true; continue; }
+            prims[i] = PrimRef(bounds,mesh->leafType(),mesh->geomID,primID);
           }
-          return pinfo;
-        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+          pinfo.add_center2(prims[i]);
+        }
+        return pinfo;
+      }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+
+      /* primitives that became invalid have to get filtered out */
+      if (invalid) {
+        prims.resize(mesh->size());
+        return createPrimRefArray(mesh,prims,progressMonitor);
       }
       return pinfo;
     }
@@ -125,41 +252,105 @@ namespace embree
       /* first try */
       progressMonitor(0);
       pstate.init(iter,size_t(1024));
-      PrimInfo pinfo = parallel_for_for_prefix_sum0( pstate, iter, PrimInfo(empty), [&](Mesh* mesh, const range<size_t>& r, size_t k) -> PrimInfo
-      {
-        PrimInfo pinfo(empty);
-        Leaf::Type ty = mesh->leafType();
-        for (size_t j=r.begin(); j<r.end(); j++)
-        {
-          BBox3fa bounds = empty;
-          if (!mesh->buildBounds(j,&bounds)) continue;
-          const PrimRef prim(bounds,ty,mesh->geomID,unsigned(j));
-          pinfo.add_center2(prim);
-          prims[k++] = prim;
-        }
-        return pinfo;
+      PrimInfo pinfo = parallel_for_for_prefix_sum0( pstate, iter, PrimInfo(empty), [&](Mesh* mesh, const range<size_t>& r, size_t k) -> PrimInfo {
+        return createPrimRefs(mesh,r,prims.data(),k);
       }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
       
       /* if we need to filter out geometry, run again */
       if (pinfo.size() != prims.size())
       {
         progressMonitor(0);
-        pinfo = parallel_for_for_prefix_sum1( pstate, iter, PrimInfo(empty), [&](Mesh* mesh, const range<size_t>& r, size_t k, const PrimInfo& base) -> PrimInfo
+        pinfo = parallel_for_for_prefix_sum1( pstate, iter, PrimInfo(empty), [&](Mesh* mesh, const range<size_t>& r, size_t k, const PrimInfo& base) -> PrimInfo {
+          return createPrimRefs(mesh,r,prims.data(),base.size());
+        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+      }
+      return pinfo;
+    }
+
+    template<typename Mesh, bool mblur>
+    PrimInfo createPrimRefArray(Scene* scene, mvector<PrimRef>& prims, PrimRefCache& cache, BuildProgressMonitor& progressMonitor)
+    {
+      Scene::Iterator<Mesh,mblur> iter(scene);
+      const size_t numGeometries = iter.size();
+      progressMonitor(0);
+
+      /* each geometry gets a slot large enough for all its primitives */
+      vector<size_t> slotSizes(numGeometries), slotOffsets(numGeometries);
+      for (size_t i=0; i<numGeometries; i++) {
+        Mesh* mesh = iter[i];
+        slotSizes[i] = mesh ? mesh->size() : 0;
+      }
+      const size_t numSlotPrims = parallel_prefix_sum(slotSizes,slotOffsets,numGeometries,size_t(0),std::plus<size_t>());
+
+      /* the cache gets updated in place when no slot changed its size */
+      bool inplace = cache.entries.size() == numGeometries && cache.prims.size() == numSlotPrims;
+      for (size_t i=0; inplace && i<numGeometries; i++)
+        inplace = cache.entries[i].numPrims == slotSizes[i];
+
+      mvector<PrimRef> slots(scene->device,inplace ? 0 : numSlotPrims);
+      PrimRef* const dst = inplace ? cache.prims.data() : slots.data();
+
+      /* primrefs of geometries that did not get modified since the last build are reused */
+      vector<PrimRefCache::Entry> entries(numGeometries);
+      vector<char> regenerate(numGeometries);
+      parallel_for(size_t(0), numGeometries, size_t(64), [&](const range<size_t>& r)
+      {
+        for (size_t i=r.begin(); i<r.end(); i++)
         {
-          k = base.size();
-          PrimInfo pinfo(empty);
-          Leaf::Type ty = mesh->leafType();
-          for (size_t j=r.begin(); j<r.end(); j++)
-          {
-            BBox3fa bounds = empty;
-            if (!mesh->buildBounds(j,&bounds)) continue;
-            const PrimRef prim(bounds,ty,mesh->geomID,unsigned(j));
-            pinfo.add_center2(prim);
-            prims[k++] = prim;
+          Mesh* mesh = iter[i];
+          entries[i].geom = mesh;
+          entries[i].begin = slotOffsets[i];
+          entries[i].numPrims = slotSizes[i];
+          regenerate[i] = false;
+          if (mesh == nullptr) continue;
+          entries[i].modCounter = mesh->getModCounter();
+
+          const bool cached = i < cache.entries.size() && cache.entries[i].geom == mesh && cache.entries[i].numPrims == slotSizes[i];
+          if (!cached || cache.entries[i].modCounter != entries[i].modCounter) {
+            regenerate[i] = true;
+            continue;
           }
-          return pinfo;
-        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+
+          entries[i].pinfo = cache.entries[i].pinfo;
+          if (!inplace) {
+            const PrimRef* src = cache.prims.data()+cache.entries[i].begin;
+            std::copy(src,src+entries[i].pinfo.size(),dst+entries[i].begin);
+          }
+        }
+      });
+
+      /* regenerate the primrefs of modified geometries */
+      parallel_for_affinity(size_t(0), numGeometries, size_t(1), [&](const range<size_t>& r)
+      {
+        for (size_t i=r.begin(); i<r.end(); i++) {
+          if (!regenerate[i]) continue;
+          entries[i].pinfo = createPrimRefArray(iter[i],dst+entries[i].begin,entries[i].numPrims,progressMonitor);
+        }
+      },cache.affinity);
+
+      if (!inplace) cache.prims = std::move(slots);
+      cache.entries = std::move(entries);
+
+      /* compact the valid primrefs of all slots into the primref array */
+      vector<size_t> validSizes(numGeometries), validOffsets(numGeometries);
+      PrimInfo pinfo(empty);
+      for (size_t i=0; i<numGeometries; i++) {
+        validSizes[i] = cache.entries[i].pinfo.size();
+        pinfo.merge(cache.entries[i].pinfo);
       }
+      parallel_prefix_sum(validSizes,validOffsets,numGeometries,size_t(0),std::plus<size_t>());
+
+      parallel_for(size_t(0), numGeometries, size_t(1), [&](const range<size_t>& r)
+      {
+        for (size_t i=r.begin(); i<r.end(); i++)
+        {
+          const PrimRef* src = cache.prims.data()+cache.entries[i].begin;
+          PrimRef* out = prims.data()+validOffsets[i];
+          parallel_for(size_t(0), validSizes[i], size_t(4096), [&](const range<size_t>& k) {
+              std::copy(src+k.begin(),src+k.end(),out+k.begin());
+            });
+        }
+      });
       return pinfo;
     }
 
@@ -384,6 +575,12 @@ namespace embree
     IF_ENABLED_LINES(template PrimInfo createGroupPrimRefArray<LineSegments>(GeometryGroup* group COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
     IF_ENABLED_USER (template PrimInfo createGroupPrimRefArray<AccelSet>(GeometryGroup* group COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
     
+    IF_ENABLED_TRIS (template PrimInfo updatePrimRefArray<TriangleMesh>(TriangleMesh* mesh COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
+    IF_ENABLED_QUADS(template PrimInfo updatePrimRefArray<QuadMesh>(QuadMesh* mesh COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
+    IF_ENABLED_HAIR (template PrimInfo updatePrimRefArray<NativeCurves>(NativeCurves* mesh COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
+    IF_ENABLED_LINES(template PrimInfo updatePrimRefArray<LineSegments>(LineSegments* mesh COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
+    IF_ENABLED_USER (template PrimInfo updatePrimRefArray<AccelSet>(AccelSet* mesh COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
+
     IF_ENABLED_TRIS (template PrimInfo createPrimRefArray<TriangleMesh COMMA false>(Scene* scene COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
     IF_ENABLED_TRIS (template PrimInfo createPrimRefArray<TriangleMesh COMMA true>(Scene* scene COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
     IF_ENABLED_QUADS(template PrimInfo createPrimRefArray<QuadMesh COMMA false>(Scene* scene COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
@@ -394,6 +591,12 @@ namespace embree
     IF_ENABLED_USER(template PrimInfo createPrimRefArray<AccelSet COMMA false>(Scene* scene COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
     IF_ENABLED_USER(template PrimInfo createPrimRefArray<AccelSet COMMA true>(Scene* scene COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
 
+    IF_ENABLED_TRIS (template PrimInfo createPrimRefArray<TriangleMesh COMMA false>(Scene* scene COMMA mvector<PrimRef>& prims COMMA PrimRefCache& cache COMMA BuildProgressMonitor& progressMonitor));
+    IF_ENABLED_QUADS(template PrimInfo createPrimRefArray<QuadMesh COMMA false>(Scene* scene COMMA mvector<PrimRef>& prims COMMA PrimRefCache& cache COMMA BuildProgressMonitor& progressMonitor));
+    IF_ENABLED_HAIR (template PrimInfo createPrimRefArray<NativeCurves COMMA false>(Scene* scene COMMA mvector<PrimRef>& prims COMMA PrimRefCache& cache COMMA BuildProgressMonitor& progressMonitor));
+    IF_ENABLED_LINES(template PrimInfo createPrimRefArray<LineSegments COMMA false>(Scene* scene COMMA mvector<PrimRef>& prims COMMA PrimRefCache& cache COMMA BuildProgressMonitor& progressMonitor));
+    IF_ENABLED_USER (template PrimInfo createPrimRefArray<AccelSet COMMA false>(Scene* scene COMMA mvector<PrimRef>& prims COMMA PrimRefCache& cache COMMA BuildProgressMonitor& progressMonitor));
+
     IF_ENABLED_TRIS (template PrimInfo createPrimRefArrayMBlur<TriangleMesh>(size_t timeSegment COMMA Scene* scene COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
     IF_ENABLED_QUADS(template PrimInfo createPrimRefArrayMBlur<QuadMesh>(size_t timeSegment COMMA Scene* scene COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
     IF_ENABLED_LINES(template PrimInfo createPrimRefArrayMBlur<LineSegments>(size_t timeSegment COMMA Scene* scene COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
@@ -22,20 +22,58 @@
 #include "priminfo.h"
 #include "../geometry/bezier1v.h"
 #include "bvh_builder_morton.h"
+#include "../../common/algorithms/parallel_for.h"
 
 namespace embree
 {
   namespace isa
   {
+    /*! Keeps the primrefs of each geometry of a scene between builds,
+     *  such that only geometries modified since the last build have to
+     *  get regenerated. */
+    struct PrimRefCache
+    {
+      struct Entry
+      {
+        __forceinline Entry ()
+          : geom(nullptr), modCounter(0), begin(0), numPrims(0), pinfo(empty) {}
+
+        Geometry* geom;   //!< geometry the primrefs got generated for
+        unsigned int modCounter; //!< modification counter of the geometry when its primrefs got generated
+        size_t begin;     //!< start of the slot of the geometry in the cache
+        size_t numPrims;  //!< size of the slot, valid primrefs are stored at its beginning
+        PrimInfo pinfo;   //!< bounds and number of valid primrefs
+      };
+
+      PrimRefCache (Device* device)
+        : prims(device,0) {}
+
+      void clear() {
+        prims.clear();
+        entries.clear();
+      }
+
+    public:
+      mvector<PrimRef> prims; //!< primrefs of all geometries, one slot per geometry
+      vector<Entry> entries;  //!< cache entry for each geometry ID
+      affinity_partitioner affinity; //!< regenerates and copies the slot of a geometry on the same thread as in the last build
+    };
+
     template<typename Mesh>
       PrimInfo createPrimRefArray(Mesh* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
 
+    template<typename Mesh>
+      PrimInfo updatePrimRefArray(Mesh* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+
     template<typename Mesh>
       PrimInfo createGroupPrimRefArray(GeometryGroup* group, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
 
     template<typename Mesh, bool mblur>
       PrimInfo createPrimRefArray(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
 
+    template<typename Mesh, bool mblur>
+      PrimInfo createPrimRefArray(Scene* scene, mvector<PrimRef>& prims, PrimRefCache& cache, BuildProgressMonitor& progressMonitor);
+
     PrimInfo createMultiPrimRefArray(Scene* scene, Geometry::Type ty, bool mblur, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
   
     template<typename Mesh>
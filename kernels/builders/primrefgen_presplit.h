@@ -113,6 +113,15 @@ namespace embree
 	return data;
       }
 
+      /*! the bounding box area not covered by the primitive estimates the SAH reduction of splitting it */
+      template<typename ProjectedPrimitiveAreaFunc>
+      __forceinline static float compute_benefit(const ProjectedPrimitiveAreaFunc& primitiveArea, const PrimRef &ref)
+      {
+        const float area_prim = primitiveArea(ref);
+        if (area_prim == 0.0f) return 0.0f;
+        return max(0.0f, area(ref.bounds()) - area_prim);
+      }
+
       template<typename ProjectedPrimitiveAreaFunc>
       __forceinline static float compute_priority(const ProjectedPrimitiveAreaFunc& primitiveArea, const PrimRef &ref, const Vec2i &mc)
       {
@@ -136,6 +145,19 @@ namespace embree
     
     };
 
+    /*! Returns the number of times a primitive gets split in half for the
+     *  adaptive split budget. Each split level is assumed to halve the
+     *  wasted bounding box area, thus level l reduces the SAH by
+     *  2*benefit/4^l per added reference. Levels are added as long as
+     *  this reduction is at least minGain. */
+    __forceinline unsigned int adaptive_split_levels(const float benefit, const float minGain)
+    {
+      unsigned int levels = 0;
+      while (levels < MAX_PRESPLITS_PER_PRIMITIVE_LOG && 2.0f*benefit >= minGain*float(1 << (2*(levels+1))))
+        levels++;
+      return levels;
+    }
+
     inline std::ostream &operator<<(std::ostream &cout, const PresplitItem& item) {
       return cout << "index " << item.index << " priority " << item.priority;    
     };
@@ -228,37 +250,14 @@ namespace embree
     
 #endif
 
-#if !defined(RTHWIF_STANDALONE)
-
-    template<typename Mesh, typename SplitterFactory>    
-      PrimInfo createPrimRefArray_presplit(Geometry* geometry, unsigned int geomID, size_t numPrimRefs, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
-    {
-      ParallelPrefixSumState<PrimInfo> pstate;
-      
-      /* first try */
-      progressMonitor(0);
-      PrimInfo pinfo = parallel_prefix_sum( pstate, size_t(0), geometry->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo {
-	  return geometry->createPrimRefArray(prims,r,r.begin(),geomID);
-	}, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
-
-      /* if we need to filter out geometry, run again */
-      if (pinfo.size() != numPrimRefs)
-	{
-	  progressMonitor(0);
-	  pinfo = parallel_prefix_sum( pstate, size_t(0), geometry->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo {
-	      return geometry->createPrimRefArray(prims,r,base.size(),geomID);
-	    }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
-	}
-      return pinfo;	
-    }
-#endif
     
     template<typename SplitPrimitiveFunc, typename ProjectedPrimitiveAreaFunc, typename PrimVector>
     PrimInfo createPrimRefArray_presplit(size_t numPrimRefs,
                                          PrimVector& prims,
                                          const PrimInfo& pinfo,
                                          const SplitPrimitiveFunc& splitPrimitive,
-                                         const ProjectedPrimitiveAreaFunc& primitiveArea)
+                                         const ProjectedPrimitiveAreaFunc& primitiveArea,
+                                         const bool adaptive = false)
     {
       static const size_t MIN_STEP_SIZE = 128;
 
@@ -274,43 +273,94 @@ namespace embree
       /* compute grid */
       SplittingGrid grid(pinfo.geomBounds);
       
-      /* init presplit items and get total sum */
-      const float psum = parallel_reduce( size_t(0), numPrimitives, size_t(MIN_STEP_SIZE), 0.0f, [&](const range<size_t>& r) -> float {
-          float sum = 0.0f;
-          for (size_t i=r.begin(); i<r.end(); i++)
-          {		
-            preSplitItem0[i].index = (unsigned int)i;
-            const Vec2i mc = grid.computeMC(prims[i]);
-            /* if all bits are equal then we cannot split */
-            preSplitItem0[i].priority = (mc.x != mc.y) ? PresplitItem::compute_priority(primitiveArea,prims[i],mc) : 0.0f;    
-            /* FIXME: sum undeterministic */
-            sum += preSplitItem0[i].priority;
+      if (adaptive)
+      {
+        /* estimate SAH benefit of splitting each primitive */
+        const Vec2f sums = parallel_reduce( size_t(0), numPrimitives, size_t(MIN_STEP_SIZE), Vec2f(zero), [&](const range<size_t>& r) -> Vec2f {
+            Vec2f sum(zero);
+            for (size_t i=r.begin(); i<r.end(); i++)
+            {
+              preSplitItem0[i].index = (unsigned int)i;
+              const Vec2i mc = grid.computeMC(prims[i]);
+              preSplitItem0[i].priority = (mc.x != mc.y) ? PresplitItem::compute_benefit(primitiveArea,prims[i]) : 0.0f;
+              sum += Vec2f(area(prims[i].bounds()),preSplitItem0[i].priority);
+            }
+            return sum;
+          },[](const Vec2f& a, const Vec2f& b) -> Vec2f { return a+b; });
+
+        /* computes the number of references added when only splits with a gain of at least minGain are performed */
+        auto numAddedReferences = [&] (const float minGain) -> size_t {
+          return parallel_reduce( size_t(0), numPrimitives, size_t(MIN_STEP_SIZE), size_t(0), [&](const range<size_t>& r) -> size_t {
+              size_t n = 0;
+              for (size_t i=r.begin(); i<r.end(); i++)
+                n += (size_t(1) << adaptive_split_levels(preSplitItem0[i].priority,minGain)) - 1;
+              return n;
+            },[](const size_t& a, const size_t& b) -> size_t { return a+b; });
+        };
+
+        /* an added reference costs about the area of an average
+         * primitive, splits that save less are never performed. As the
+         * gain per reference decreases with each split level, greedily
+         * spending the budget where the gain is highest is equivalent to
+         * raising the minimal gain until the budget suffices. */
+        float minGain = max(sums.x/float(numPrimitives),std::numeric_limits<float>::min());
+        if (numAddedReferences(minGain) > numSplitPrimitivesBudget)
+        {
+          float lower = minGain, upper = max(2.0f*sums.y,minGain);
+          for (size_t i=0; i<24; i++) {
+            const float center = sqrtf(lower)*sqrtf(upper);
+            if (numAddedReferences(center) > numSplitPrimitivesBudget) lower = center;
+            else upper = center;
           }
-          return sum;
-        },[](const float& a, const float& b) -> float { return a+b; });
+          minGain = upper;
+        }
 
-      /* compute number of splits per primitive */
-      const float inv_psum = 1.0f / psum;
-      parallel_for( size_t(0), numPrimitives, size_t(MIN_STEP_SIZE), [&](const range<size_t>& r) -> void {
-          for (size_t i=r.begin(); i<r.end(); i++)
-          {
-            if (preSplitItem0[i].priority <= 0.0f) {
-              preSplitItem0[i].data = 1;
-              continue;
+        /* compute number of splits per primitive */
+        parallel_for( size_t(0), numPrimitives, size_t(MIN_STEP_SIZE), [&](const range<size_t>& r) -> void {
+            for (size_t i=r.begin(); i<r.end(); i++)
+              preSplitItem0[i].data = 1 << adaptive_split_levels(preSplitItem0[i].priority,minGain);
+          });
+      }
+      else
+      {
+        /* init presplit items and get total sum */
+        const float psum = parallel_reduce( size_t(0), numPrimitives, size_t(MIN_STEP_SIZE), 0.0f, [&](const range<size_t>& r) -> float {
+            float sum = 0.0f;
+            for (size_t i=r.begin(); i<r.end(); i++)
+            {		
+              preSplitItem0[i].index = (unsigned int)i;
+              const Vec2i mc = grid.computeMC(prims[i]);
+              /* if all bits are equal then we cannot split */
+              preSplitItem0[i].priority = (mc.x != mc.y) ? PresplitItem::compute_priority(primitiveArea,prims[i],mc) : 0.0f;    
+              /* FIXME: sum undeterministic */
+              sum += preSplitItem0[i].priority;
             }
+            return sum;
+          },[](const float& a, const float& b) -> float { return a+b; });
+
+        /* compute number of splits per primitive */
+        const float inv_psum = 1.0f / psum;
+        parallel_for( size_t(0), numPrimitives, size_t(MIN_STEP_SIZE), [&](const range<size_t>& r) -> void {
+            for (size_t i=r.begin(); i<r.end(); i++)
+            {
+              if (preSplitItem0[i].priority <= 0.0f) {
+                preSplitItem0[i].data = 1;
+                continue;
+              }
               
-            const float rel_p = (float)numSplitPrimitivesBudget * preSplitItem0[i].priority * inv_psum;
-            if (rel_p < 1) {
-              preSplitItem0[i].data = 1;
-              continue;
-            }
+              const float rel_p = (float)numSplitPrimitivesBudget * preSplitItem0[i].priority * inv_psum;
+              if (rel_p < 1) {
+                preSplitItem0[i].data = 1;
+                continue;
+              }
             
-            //preSplitItem0[i].data = max(min(ceilf(rel_p),(float)MAX_PRESPLITS_PER_PRIMITIVE),1.0f);
-            preSplitItem0[i].data = max(min(ceilf(logf(rel_p)/logf(2.0f)),(float)MAX_PRESPLITS_PER_PRIMITIVE_LOG),1.0f);
-            preSplitItem0[i].data = 1 << preSplitItem0[i].data;
-            assert(preSplitItem0[i].data <= MAX_PRESPLITS_PER_PRIMITIVE);
-          }
-        });
+              //preSplitItem0[i].data = max(min(ceilf(rel_p),(float)MAX_PRESPLITS_PER_PRIMITIVE),1.0f);
+              preSplitItem0[i].data = max(min(ceilf(logf(rel_p)/logf(2.0f)),(float)MAX_PRESPLITS_PER_PRIMITIVE_LOG),1.0f);
+              preSplitItem0[i].data = 1 << preSplitItem0[i].data;
+              assert(preSplitItem0[i].data <= MAX_PRESPLITS_PER_PRIMITIVE);
+            }
+          });
+      }
 
       auto isLeft = [&] (const PresplitItem &ref) { return ref.data <= 1; };        
       size_t center = parallel_partitioning(preSplitItem0.data(),0,numPrimitives,isLeft,1024);
@@ -424,7 +474,7 @@ namespace embree
 #if !defined(RTHWIF_STANDALONE)
     
      template<typename Mesh, typename SplitterFactory>    
-      PrimInfo createPrimRefArray_presplit(Scene* scene, Geometry::GTypeMask types, bool mblur, size_t numPrimRefs, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
+      PrimInfo createPrimRefArray_presplit(Scene* scene, Geometry::GTypeMask types, bool mblur, size_t numPrimRefs, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor, bool adaptive = false)
     {
       ParallelForForPrefixSumState<PrimInfo> pstate;
       Scene::Iterator2 iter(scene,types,mblur);
@@ -464,7 +514,47 @@ namespace embree
         return ((Mesh*)scene->get(geomID))->projectedPrimitiveArea(primID);
       };
       
-      return createPrimRefArray_presplit(numPrimRefs,prims,pinfo,split_primitive,primitiveArea);
+      return createPrimRefArray_presplit(numPrimRefs,prims,pinfo,split_primitive,primitiveArea,adaptive);
+    }
+
+    template<typename Mesh, typename SplitterFactory>    
+      PrimInfo createPrimRefArray_presplit(Scene* scene, Geometry* geometry, unsigned int geomID, size_t numPrimRefs, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor, bool adaptive = false)
+    {
+      ParallelPrefixSumState<PrimInfo> pstate;
+      
+      /* first try */
+      progressMonitor(0);
+      PrimInfo pinfo = parallel_prefix_sum( pstate, size_t(0), geometry->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo {
+	  return geometry->createPrimRefArray(prims,r,r.begin(),geomID);
+	}, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+
+      /* if we need to filter out geometry, run again */
+      if (pinfo.size() != numPrimRefs)
+	{
+	  progressMonitor(0);
+	  pinfo = parallel_prefix_sum( pstate, size_t(0), geometry->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo {
+	      return geometry->createPrimRefArray(prims,r,base.size(),geomID);
+	    }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+	}
+
+      /* the splitters look up the mesh in the scene by its geometry ID */
+      SplitterFactory Splitter(scene);
+        
+      auto split_primitive = [&] (const PrimRef &prim,
+                                  const unsigned int splitprims,
+                                  const SplittingGrid& grid,
+                                  PrimRef subPrims[MAX_PRESPLITS_PER_PRIMITIVE],
+                                  unsigned int& numSubPrims)
+      {
+         const auto splitter = Splitter(prim);
+         splitPrimitive(splitter,prim,splitprims,grid,subPrims,numSubPrims);
+      };
+      
+      auto primitiveArea = [&] (const PrimRef &ref) {
+        return ((Mesh*)geometry)->projectedPrimitiveArea(ref.primID());
+      };
+      
+      return createPrimRefArray_presplit(numPrimRefs,prims,pinfo,split_primitive,primitiveArea,adaptive);
     }
 #endif 
   }
@@ -0,0 +1,131 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "../common/scene.h"
+#include "../common/scene_triangle_mesh.h"
+#include "../common/scene_quad_mesh.h"
+#include "../../common/algorithms/parallel_for.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Returns the bounds of a primitive at some time step, only
+     *  geometries with direct access to these bounds can get cached. */
+    template<typename Mesh>
+      struct TimeStepBounds
+      {
+        static const bool supported = false;
+        static __forceinline BBox3fa get(const Mesh* mesh, size_t primID, size_t itime) { return empty; }
+      };
+
+    template<>
+      struct TimeStepBounds<TriangleMesh>
+      {
+        static const bool supported = true;
+        static __forceinline BBox3fa get(const TriangleMesh* mesh, size_t primID, size_t itime) { return mesh->bounds(primID,itime); }
+      };
+
+    template<>
+      struct TimeStepBounds<QuadMesh>
+      {
+        static const bool supported = true;
+        static __forceinline BBox3fa get(const QuadMesh* mesh, size_t primID, size_t itime) { return mesh->bounds(primID,itime); }
+      };
+
+    /*! Caches the bounds of all primitives at all time steps in a SoA
+     *  table. The motion blur builders evaluate the linear bounds of
+     *  a primitive for many different time ranges, using this table
+     *  these evaluations do not have to gather the vertices of each
+     *  time step again. */
+    class TimeStepBoundsTable
+    {
+      static const size_t PARALLEL_THRESHOLD = 1024;
+      static const size_t BLOCK_SIZE = 256;
+
+    public:
+
+      /*! minimal number of time segments to build the table for */
+      static const unsigned MIN_TIME_SEGMENTS = 4;
+
+      TimeStepBoundsTable (MemoryMonitorInterface* device)
+        : lower_x(device,0), lower_y(device,0), lower_z(device,0),
+          upper_x(device,0), upper_y(device,0), upper_z(device,0) {}
+
+      /*! returns true if the table got built */
+      __forceinline bool valid() const {
+        return offsets.size() != 0;
+      }
+
+      /*! caches the bounds of all primitives of geometries of type Mesh */
+      template<typename Mesh>
+        void build(Scene* scene)
+      {
+        /* calculate offset of each geometry into the table */
+        size_t numRows = 0;
+        offsets.resize(scene->size());
+        for (size_t geomID=0; geomID<scene->size(); geomID++)
+        {
+          offsets[geomID] = numRows;
+          const Mesh* mesh = scene->getSafe<Mesh>(geomID);
+          if (mesh == nullptr || mesh->numTimeSteps == 1) continue;
+          numRows += mesh->size()*mesh->numTimeSteps;
+        }
+
+        lower_x.resize(numRows); lower_y.resize(numRows); lower_z.resize(numRows);
+        upper_x.resize(numRows); upper_y.resize(numRows); upper_z.resize(numRows);
+
+        /* the bounds of all time steps of a primitive are stored consecutively */
+        for (size_t geomID=0; geomID<scene->size(); geomID++)
+        {
+          const Mesh* mesh = scene->getSafe<Mesh>(geomID);
+          if (mesh == nullptr || mesh->numTimeSteps == 1) continue;
+
+          const size_t numTimeSteps = mesh->numTimeSteps;
+          const size_t offset = offsets[geomID];
+          auto fill = [&] (const range<size_t>& r)
+          {
+            for (size_t primID=r.begin(); primID<r.end(); primID++)
+            {
+              const size_t row = offset + primID*numTimeSteps;
+              for (size_t itime=0; itime<numTimeSteps; itime++)
+              {
+                const BBox3fa b = TimeStepBounds<Mesh>::get(mesh,primID,itime);
+                lower_x[row+itime] = b.lower.x; lower_y[row+itime] = b.lower.y; lower_z[row+itime] = b.lower.z;
+                upper_x[row+itime] = b.upper.x; upper_y[row+itime] = b.upper.y; upper_z[row+itime] = b.upper.z;
+              }
+            }
+          };
+
+          if (mesh->size() < PARALLEL_THRESHOLD) fill(range<size_t>(0,mesh->size()));
+          else parallel_for(size_t(0), mesh->size(), BLOCK_SIZE, fill);
+        }
+      }
+
+      /*! returns the cached bounds of a primitive at the itime'th time step */
+      __forceinline BBox3fa bounds(const Geometry* geom, unsigned geomID, unsigned primID, size_t itime) const
+      {
+        const size_t row = offsets[geomID] + size_t(primID)*geom->numTimeSteps + itime;
+        return BBox3fa(Vec3fa(lower_x[row],lower_y[row],lower_z[row]),
+                       Vec3fa(upper_x[row],upper_y[row],upper_z[row]));
+      }
+
+      /*! calculates the linear bounds of a primitive for the specified time range from the cached bounds */
+      __forceinline LBBox3fa linearBounds(const Geometry* geom, unsigned geomID, unsigned primID, const BBox1f& time_range) const
+      {
+        auto boundsFunc = [&] (size_t itime) { return bounds(geom,geomID,primID,itime); };
+        if (likely(geom->hasUniformTimeSteps()))
+          return LBBox3fa(boundsFunc, time_range, geom->fnumTimeSegments);
+        else
+          return LBBox3fa(boundsFunc, time_range, geom->timeSteps.data(), int(geom->numTimeSegments()));
+      }
+
+    private:
+      std::vector<size_t> offsets; //!< start row of each geometry
+      mvector<float> lower_x, lower_y, lower_z;
+      mvector<float> upper_x, upper_y, upper_z;
+    };
+  }
+}
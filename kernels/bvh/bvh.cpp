@@ -23,13 +23,19 @@ namespace embree
   BVHN<N>::BVHN (const PrimitiveType& primTy, Scene* scene)
     : AccelData((N==4) ? AccelData::TY_BVH4 : (N==8) ? AccelData::TY_BVH8 : AccelData::TY_UNKNOWN),
       primTy(&primTy), primTys(nullptr),  numTypes(1), device(scene->device), scene(scene),
-      root(emptyNode), alloc(scene->device,scene->isStatic()), numPrimitives(0), numVertices(0) {}
+      root(emptyNode), alloc(scene->device,scene->isStatic()), numPrimitives(0), numVertices(0)
+  {
+    hybridSwitch.enabled = device->adaptive_hybrid_switch;
+  }
 
   template<int N>
   BVHN<N>::BVHN (const PrimitiveType** primTys, unsigned numTypes, Scene* scene)
     : AccelData((N==4) ? AccelData::TY_BVH4 : (N==8) ? AccelData::TY_BVH8 : AccelData::TY_UNKNOWN),
       primTy(nullptr), primTys(primTys), numTypes(numTypes), device(scene->device), scene(scene),
-      root(emptyNode), alloc(scene->device,scene->isStatic()), numPrimitives(0), numVertices(0) {}
+      root(emptyNode), alloc(scene->device,scene->isStatic()), numPrimitives(0), numVertices(0)
+  {
+    hybridSwitch.enabled = device->adaptive_hybrid_switch;
+  }
 
   template<int N>
   BVHN<N>::~BVHN ()
@@ -194,6 +200,10 @@ namespace embree
     }
   }
 
+#if defined(EMBREE_BVH16)
+  template class BVHN<16>;
+#else
+
 #if defined(__AVX__)
   template class BVHN<8>;
 #endif
@@ -201,5 +211,7 @@ namespace embree
 #if !defined(__AVX__) || !defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42)
   template class BVHN<4>;
 #endif
+
+#endif
 }
 
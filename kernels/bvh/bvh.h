@@ -23,6 +23,7 @@
 #include "../common/scene.h"
 #include "../geometry/primitive.h"
 #include "../common/ray.h"
+#include "bvh_hybrid_switch.h"
 
 namespace embree
 {
@@ -1504,6 +1505,7 @@ namespace embree
     Scene* scene;                      //!< scene pointer
     NodeRef root;                      //!< root node
     FastAllocator alloc;               //!< allocator used to allocate nodes
+    HybridSwitch hybridSwitch;         //!< adaptive switch from packet to single ray traversal
 
     /*! statistics data */
   public:
@@ -1524,4 +1526,5 @@ namespace embree
 
   typedef BVHN<4> BVH4;
   typedef BVHN<8> BVH8;
+  typedef BVHN<16> BVH16;
 }
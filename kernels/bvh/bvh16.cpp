@@ -0,0 +1,7 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+/* instantiates the 16-wide BVH in the AVX-512 target only */
+#define EMBREE_BVH16
+#include "bvh.cpp"
+#include "bvh_statistics.cpp"
@@ -0,0 +1,72 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "bvh16_factory.h"
+#include "../bvh/bvh.h"
+
+#include "../geometry/triangle.h"
+#include "../common/accelinstance.h"
+
+#if defined (EMBREE_TARGET_AVX512)
+
+namespace embree
+{
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH16Triangle4Intersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector4,BVH16Triangle4Intersector4Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector8,BVH16Triangle4Intersector8Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector16,BVH16Triangle4Intersector16Moeller);
+  DECLARE_SYMBOL2(Accel::IntersectorN,BVH16Triangle4IntersectorStreamFallback);
+
+  DECLARE_ISA_FUNCTION(Builder*,BVH16Triangle4SceneBuilderSAH,void* COMMA Scene* COMMA size_t);
+
+  BVH16Factory::BVH16Factory(int bfeatures, int ifeatures)
+  {
+    selectBuilders(bfeatures);
+    selectIntersectors(ifeatures);
+  }
+
+  void BVH16Factory::selectBuilders(int features)
+  {
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512(features,BVH16Triangle4SceneBuilderSAH));
+  }
+
+  void BVH16Factory::selectIntersectors(int features)
+  {
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512(features,BVH16Triangle4Intersector1Moeller));
+#if defined (EMBREE_RAY_PACKETS)
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512(features,BVH16Triangle4Intersector4Moeller));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512(features,BVH16Triangle4Intersector8Moeller));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512(features,BVH16Triangle4Intersector16Moeller));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512(features,BVH16Triangle4IntersectorStreamFallback));
+#endif
+  }
+
+  Accel::Intersectors BVH16Factory::BVH16Triangle4Intersectors(BVH16* bvh)
+  {
+    /* packets trace their rays one by one, streams get traced as packets */
+    Accel::Intersectors intersectors;
+    intersectors.ptr = bvh;
+    intersectors.intersector1  = BVH16Triangle4Intersector1Moeller();
+#if defined (EMBREE_RAY_PACKETS)
+    intersectors.intersector4  = BVH16Triangle4Intersector4Moeller();
+    intersectors.intersector8  = BVH16Triangle4Intersector8Moeller();
+    intersectors.intersector16 = BVH16Triangle4Intersector16Moeller();
+    intersectors.intersectorN  = BVH16Triangle4IntersectorStreamFallback();
+#endif
+    return intersectors;
+  }
+
+  Accel* BVH16Factory::BVH16Triangle4(Scene* scene)
+  {
+    BVH16* accel = new BVH16(Triangle4::type,scene);
+    Accel::Intersectors intersectors = BVH16Triangle4Intersectors(accel);
+    Builder* builder = nullptr;
+    if      (scene->device->tri_builder == "default") builder = BVH16Triangle4SceneBuilderSAH(accel,scene,0);
+    else if (scene->device->tri_builder == "sah"    ) builder = BVH16Triangle4SceneBuilderSAH(accel,scene,0);
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for BVH16<Triangle4>");
+
+    return new AccelInstance(accel,builder,intersectors);
+  }
+}
+
+#endif
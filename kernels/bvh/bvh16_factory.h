@@ -0,0 +1,35 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "bvh_factory.h"
+
+namespace embree
+{
+  /*! BVH16 instantiations for AVX-512 targets */
+  class BVH16Factory : public BVHFactory
+  {
+  public:
+    BVH16Factory(int bfeatures, int ifeatures);
+
+  public:
+    Accel* BVH16Triangle4(Scene* scene);
+
+  private:
+    void selectBuilders(int features);
+    void selectIntersectors(int features);
+
+  private:
+    Accel::Intersectors BVH16Triangle4Intersectors(BVH16* bvh);
+
+  private:
+    DEFINE_SYMBOL2(Accel::Intersector1,BVH16Triangle4Intersector1Moeller);
+    DEFINE_SYMBOL2(Accel::Intersector4,BVH16Triangle4Intersector4Moeller);
+    DEFINE_SYMBOL2(Accel::Intersector8,BVH16Triangle4Intersector8Moeller);
+    DEFINE_SYMBOL2(Accel::Intersector16,BVH16Triangle4Intersector16Moeller);
+    DEFINE_SYMBOL2(Accel::IntersectorN,BVH16Triangle4IntersectorStreamFallback);
+
+    DEFINE_ISA_FUNCTION(Builder*,BVH16Triangle4SceneBuilderSAH,void* COMMA Scene* COMMA size_t);
+  };
+}
@@ -49,6 +49,7 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle4Intersector1Moeller);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle4iIntersector1Moeller);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle4vIntersector1Pluecker);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle4vIntersector1Woop);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle4iIntersector1Pluecker);
 
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle4vMBIntersector1Moeller);
@@ -309,6 +310,7 @@ namespace embree
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Triangle4Intersector1Moeller));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Triangle4iIntersector1Moeller));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Triangle4vIntersector1Pluecker));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Triangle4vIntersector1Woop));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Triangle4iIntersector1Pluecker));
 
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Triangle4vMBIntersector1Moeller));
@@ -667,10 +669,14 @@ namespace embree
 
   Accel::Intersectors BVH8Factory::BVH8Triangle4vIntersectors(BVH8* bvh, IntersectVariant ivariant)
   {
-    assert(ivariant == IntersectVariant::ROBUST);
+    assert(ivariant == IntersectVariant::ROBUST || ivariant == IntersectVariant::WATERTIGHT);
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
-    intersectors.intersector1    = BVH8Triangle4vIntersector1Pluecker();
+    /* there is no packet variant of the watertight test, packets and streams use the robust intersectors */
+    if (ivariant == IntersectVariant::WATERTIGHT)
+      intersectors.intersector1    = BVH8Triangle4vIntersector1Woop();
+    else
+      intersectors.intersector1    = BVH8Triangle4vIntersector1Pluecker();
 #if defined (EMBREE_RAY_PACKETS)
     intersectors.intersector4    = BVH8Triangle4vIntersector4HybridPluecker();
     intersectors.intersector8    = BVH8Triangle4vIntersector8HybridPluecker();
@@ -1099,8 +1105,12 @@ namespace embree
   Accel* BVH8Factory::BVH8Triangle4(Scene* scene, BuildVariant bvariant, IntersectVariant ivariant)
   {
     BVH8* accel = new BVH8(Triangle4::type,scene);
-    Accel::Intersectors intersectors= BVH8Triangle4Intersectors(accel,ivariant);
-    //Accel::Intersectors intersectors = BVH8MultiFastIntersectors(accel);
+
+    Accel::Intersectors intersectors;
+    if      (scene->device->tri_traverser == "default") intersectors = BVH8Triangle4Intersectors(accel,ivariant);
+    else if (scene->device->tri_traverser == "fast"   ) intersectors = BVH8Triangle4Intersectors(accel,IntersectVariant::FAST);
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown traverser "+scene->device->tri_traverser+" for BVH8<Triangle4>");
+
     Builder* builder = nullptr;
     if (scene->device->tri_builder == "default")  {
       switch (bvariant) {
@@ -1122,7 +1132,14 @@ namespace embree
   Accel* BVH8Factory::BVH8Triangle4v(Scene* scene, BuildVariant bvariant, IntersectVariant ivariant)
   {
     BVH8* accel = new BVH8(Triangle4v::type,scene);
-    Accel::Intersectors intersectors= BVH8Triangle4vIntersectors(accel,ivariant);
+
+    Accel::Intersectors intersectors;
+    if      (scene->device->tri_traverser == "default") intersectors = BVH8Triangle4vIntersectors(accel,ivariant);
+    else if (scene->device->tri_traverser == "fast"   ) intersectors = BVH8Triangle4vIntersectors(accel,ivariant); // there is no fast Triangle4v test
+    else if (scene->device->tri_traverser == "robust" ) intersectors = BVH8Triangle4vIntersectors(accel,IntersectVariant::ROBUST);
+    else if (scene->device->tri_traverser == "watertight") intersectors = BVH8Triangle4vIntersectors(accel,IntersectVariant::WATERTIGHT);
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown traverser "+scene->device->tri_traverser+" for BVH8<Triangle4v>");
+
     Builder* builder = nullptr;
     if (scene->device->tri_builder == "default")  {
       switch (bvariant) {
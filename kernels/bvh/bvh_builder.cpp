@@ -16,7 +16,18 @@ namespace embree
       
       settings.branchingFactor = N;
       settings.maxDepth = BVH::maxBuildDepthLeaf;
-      return BVHBuilderBinnedSAH::build<NodeRef>
+
+      /* only the BVH16 builder pays for the larger per node child arrays */
+      static const size_t maxBranchingFactor = size_t(N) > GeneralBVHBuilder::MAX_BRANCHING_FACTOR ? size_t(N) : GeneralBVHBuilder::MAX_BRANCHING_FACTOR;
+
+      /* huge builds split the upper levels in Morton order to reduce passes over the primitive array */
+      const size_t mortonSplitThreshold = allocator->getDevice()->morton_split_threshold;
+      if (pinfo.size() >= mortonSplitThreshold)
+        return BVHBuilderHybridSAHT<maxBranchingFactor>::template build<NodeRef>
+          (allocator->getDevice(),FastAllocator::Create(allocator),typename BVH::AABBNode::Create2(),typename BVH::AABBNode::Set3(allocator,prims),createLeafFunc,progressFunc,prims,pinfo,
+           BVHBuilderHybridSAHT<maxBranchingFactor>::minSortedSize(mortonSplitThreshold),settings);
+
+      return BVHBuilderBinnedSAHT<maxBranchingFactor>::template build<NodeRef>
         (FastAllocator::Create(allocator),typename BVH::AABBNode::Create2(),typename BVH::AABBNode::Set3(allocator,prims),createLeafFunc,progressFunc,prims,pinfo,settings);
     }
 
@@ -56,5 +67,9 @@ namespace embree
     template struct BVHNBuilderQuantizedVirtual<8>;
     template struct BVHNBuilderMblurVirtual<8>;
 #endif
+
+#if defined(__AVX512F__)
+    template struct BVHNBuilderVirtual<16>;
+#endif
   }
 }
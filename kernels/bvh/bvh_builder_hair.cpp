@@ -20,13 +20,15 @@
 
 #include "../geometry/bezier1v.h"
 #include "../geometry/bezier1i.h"
-
-#if defined(EMBREE_GEOMETRY_HAIR)
+#include "../geometry/trianglei.h"
+#include "../geometry/quadi.h"
 
 namespace embree
 {
   namespace isa
   {
+#if defined(EMBREE_GEOMETRY_HAIR)
+
     template<int N, typename Primitive>
     struct BVHNHairBuilderSAH : public Builder
     {
@@ -215,6 +217,95 @@ namespace embree
     Builder* BVH8OBBBezier1iMBBuilder_OBB (void* bvh, Scene* scene, size_t mode) { return new BVHNHairMBlurBuilderSAH<8,Bezier1i>((BVH8*)bvh,scene); }
 #endif
 
+#endif
+
+    /*! Builds a BVH with oriented bounding boxes over long thin triangles or quads (e.g. beams, cables, or fences). */
+    template<int N, typename Mesh, typename Primitive>
+    struct BVHNOBBBuilderSAH : public Builder
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+
+      BVH* bvh;
+      Scene* scene;
+      mvector<PrimRef> prims;
+
+      BVHNOBBBuilderSAH (BVH* bvh, Scene* scene)
+        : bvh(bvh), scene(scene), prims(scene->device,0) {}
+
+      void build()
+      {
+        /* fast path for empty BVH */
+        const size_t numPrimitives = scene->getNumPrimitives<Mesh,false>();
+        if (numPrimitives == 0) {
+          prims.clear();
+          bvh->set(BVH::emptyNode,empty,0);
+          return;
+        }
+
+        double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "OBBBuilderSAH");
+
+        /* create primref array */
+        prims.resize(numPrimitives);
+        const PrimInfo pinfo = createPrimRefArray<Mesh,false>(scene,prims,scene->progressInterface);
+
+        /* estimate acceleration structure size */
+        const size_t node_bytes = pinfo.size()*sizeof(typename BVH::UnalignedNode)/(4*N);
+        const size_t leaf_bytes = size_t(1.2*Primitive::blocks(pinfo.size())*sizeof(Primitive));
+        bvh->alloc.init_estimate(node_bytes+leaf_bytes);
+
+        /* builder settings */
+        BVHBuilderHair::Settings settings;
+        settings.branchingFactor = N;
+        settings.maxDepth = BVH::maxBuildDepthLeaf;
+        settings.logBlockSize = __bsr(Primitive::max_size());
+        settings.minLeafSize = 1;
+        settings.maxLeafSize = Primitive::max_size()*BVH::maxLeafBlocks;
+
+        /* creates a leaf node */
+        auto createLeaf = [&] (const PrimRef* prims, const range<size_t>& set, const FastAllocator::CachedAllocator& alloc) -> NodeRef
+          {
+            size_t start = set.begin();
+            size_t items = Primitive::blocks(set.size());
+            Primitive* accel = (Primitive*) alloc.malloc1(items*sizeof(Primitive),BVH::byteAlignment);
+            for (size_t i=0; i<items; i++) {
+              accel[i].fill(prims,start,set.end(),bvh->scene,i==(items-1));
+            }
+            return bvh->encodeLeaf((char*)accel,Primitive::leaf_type);
+          };
+
+        /* build hierarchy, oriented bounds are considered for all primitives of the mesh type */
+        typename BVH::NodeRef root = BVHBuilderHair::build<NodeRef>
+          (typename BVH::CreateAlloc(bvh),
+           typename BVH::AlignedNode::Create(),
+           typename BVH::AlignedNode::Set(),
+           typename BVH::UnalignedNode::Create(),
+           typename BVH::UnalignedNode::Set(),
+           createLeaf,scene->progressInterface,scene,prims.data(),pinfo,settings,
+           Leaf::typeMask(Leaf::TY_TRIANGLE) | Leaf::typeMask(Leaf::TY_QUAD));
+
+        bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+
+        /* clear temporary data for static geometry */
+        if (scene->isStatic()) {
+          prims.clear();
+          bvh->shrink();
+        }
+        bvh->cleanup();
+        bvh->postBuild(t0);
+      }
+
+      void clear() {
+        prims.clear();
+      }
+    };
+
+#if defined(EMBREE_GEOMETRY_TRIANGLES)
+    Builder* BVH4OBBTriangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNOBBBuilderSAH<4,TriangleMesh,Triangle4i>((BVH4*)bvh,scene); }
+#endif
+
+#if defined(EMBREE_GEOMETRY_QUADS)
+    Builder* BVH4OBBQuad4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNOBBBuilderSAH<4,QuadMesh,Quad4i>((BVH4*)bvh,scene); }
+#endif
   }
 }
-#endif
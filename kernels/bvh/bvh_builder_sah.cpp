@@ -33,8 +33,10 @@
 #include "../geometry/trianglev.h"
 #include "../geometry/trianglev_mb.h"
 #include "../geometry/trianglei.h"
+#include "../geometry/trianglec.h"
 #include "../geometry/quadv.h"
 #include "../geometry/quadi.h"
+#include "../geometry/quadc.h"
 #include "../geometry/object.h"
 
 #include "../common/state.h"
@@ -117,16 +119,18 @@ namespace embree
       Scene* scene;
       Mesh* mesh;
       mvector<PrimRef> prims;
+      bool primsComplete; //!< true if prims still holds a reference to each primitive of the mesh
+      PrimRefCache primsCache; //!< primrefs of each geometry of dynamic scenes kept between builds
       GeneralBVHBuilder::Settings settings;
       bool primrefarrayalloc;
 
       BVHNBuilderSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize,
                       const size_t mode, bool primrefarrayalloc = false)
-        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device,0),
+        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device,0), primsComplete(false), primsCache(scene->device),
           settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), primrefarrayalloc(primrefarrayalloc) {}
 
       BVHNBuilderSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), primrefarrayalloc(false) {}
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device,0), primsComplete(false), primsCache(bvh->device), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), primrefarrayalloc(false) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
@@ -183,20 +187,27 @@ namespace embree
         if (mesh && mesh->numPrimitivesChanged) {
           bvh->alloc.clear();
           mesh->numPrimitivesChanged = false;
+          primsComplete = false;
         }
 
         /* if we use the primrefarray for allocations we have to take it back from the BVH */
-        if (settings.primrefarrayalloc != size_t(inf))
+        if (settings.primrefarrayalloc != size_t(inf)) {
           bvh->alloc.unshare(prims);
+          primsComplete = false;
+        }
 
 	/* skip build for empty scene */
         const size_t numPrimitives = mesh ? mesh->size() : scene->getNumPrimitives<Mesh,false>();
         if (numPrimitives == 0) {
           bvh->clear();
           prims.clear();
+          primsComplete = false;
           return;
         }
 
+        /* when only some vertex ranges changed the primrefs of the last build are updated in place */
+        const bool updatePrims = mesh && primsComplete && prims.size() == numPrimitives && !mesh->dirtyVertices.isAll();
+
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderSAH");
 
 #if PROFILE
@@ -221,15 +232,20 @@ namespace embree
             settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
             prims.resize(numPrimitives); 
 
-            PrimInfo pinfo = mesh ?
-              createPrimRefArray<Mesh>  (mesh ,prims,bvh->scene->progressInterface) :
+            /* for dynamic scenes only the primrefs of modified geometries are regenerated */
+            PrimInfo pinfo = updatePrims ?
+              updatePrimRefArray<Mesh>  (mesh ,prims,bvh->scene->progressInterface) : mesh ?
+              createPrimRefArray<Mesh>  (mesh ,prims,bvh->scene->progressInterface) : !scene->isStatic() ?
+              createPrimRefArray<Mesh,false>(scene,prims,primsCache,bvh->scene->progressInterface) :
               createPrimRefArray<Mesh,false>(scene,prims,bvh->scene->progressInterface);
+            primsComplete = mesh && pinfo.size() == numPrimitives;
 
             /* pinfo might has zero size due to invalid geometry */
             if (unlikely(pinfo.size() == 0))
             {
               bvh->clear();
               prims.clear();
+              primsComplete = false;
               return;
             }
 
@@ -253,6 +269,8 @@ namespace embree
         else if (staticGeom) {
           bvh->shrink();
           prims.clear();
+          primsComplete = false;
+          primsCache.clear();
         }
 	bvh->cleanup();
         bvh->postBuild(t0);
@@ -260,6 +278,8 @@ namespace embree
 
       void clear() {
         prims.clear();
+        primsComplete = false;
+        primsCache.clear();
       }
     };
 
@@ -645,10 +665,12 @@ namespace embree
     Builder* BVH4Triangle4MeshBuilderSAH  (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4>((BVH4*)bvh,mesh,4,1.0f,4,inf,mode); }
     Builder* BVH4Triangle4vMeshBuilderSAH (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4v>((BVH4*)bvh,mesh,4,1.0f,4,inf,mode); }
     Builder* BVH4Triangle4iMeshBuilderSAH (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4i>((BVH4*)bvh,mesh,4,1.0f,4,inf,mode); }
+    Builder* BVH4Triangle4cMeshBuilderSAH (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4c>((BVH4*)bvh,mesh,4,1.0f,4,inf,mode); }
 
     Builder* BVH4Triangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4Triangle4vSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4Triangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode,true); }
+    Builder* BVH4Triangle4cSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4c>((BVH4*)bvh,scene,4,1.0f,4,inf,mode,true); }
 
     Builder* BVH4Triangle4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMBlurSAH<4,TriangleMesh,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf); }
     Builder* BVH4Triangle4vMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMBlurSAH<4,TriangleMesh,Triangle4vMB>((BVH4*)bvh,scene,4,1.0f,4,inf); }
@@ -677,13 +699,19 @@ namespace embree
     Builder* BVH8Triangle4vSceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<8,TriangleMesh,Triangle4v,TriangleSplitterFactory>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
 
 #endif
+
+#if defined(__AVX512F__)
+    Builder* BVH16Triangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<16,TriangleMesh,Triangle4>((BVH16*)bvh,scene,4,1.0f,4,inf,mode); }
+#endif
 #endif
 
 #if defined(EMBREE_GEOMETRY_QUADS)
     Builder* BVH4Quad4vMeshBuilderSAH     (void* bvh, QuadMesh* mesh, size_t mode)     { return new BVHNBuilderSAH<4,QuadMesh,Quad4v>((BVH4*)bvh,mesh,4,1.0f,4,inf,mode); }
     Builder* BVH4Quad4iMeshBuilderSAH     (void* bvh, QuadMesh* mesh, size_t mode)     { return new BVHNBuilderSAH<4,QuadMesh,Quad4i>((BVH4*)bvh,mesh,4,1.0f,4,inf,mode); }
+    Builder* BVH4Quad4cMeshBuilderSAH     (void* bvh, QuadMesh* mesh, size_t mode)     { return new BVHNBuilderSAH<4,QuadMesh,Quad4c>((BVH4*)bvh,mesh,4,1.0f,4,inf,mode); }
     Builder* BVH4Quad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,QuadMesh,Quad4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4Quad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,QuadMesh,Quad4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode,true); }
+    Builder* BVH4Quad4cSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,QuadMesh,Quad4c>((BVH4*)bvh,scene,4,1.0f,4,inf,mode,true); }
     Builder* BVH4Quad4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMBlurSAH<4,QuadMesh,Quad4i>((BVH4*)bvh,scene,4,1.0f,4,inf); }
     Builder* BVH4QuantizedQuad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,QuadMesh,Quad4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4QuantizedQuad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,QuadMesh,Quad4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
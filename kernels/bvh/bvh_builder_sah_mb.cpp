@@ -197,11 +197,16 @@ namespace embree
         settings.intCost = intCost;
         settings.singleLeafTimeSegment = Primitive::singleTimeSegment;
         settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,pinfo.size(),node_bytes+leaf_bytes);
+
+        /* for many time segments cache the bounds of each time step, as the builder evaluates linear bounds very often */
+        TimeStepBoundsTable table(scene->device);
+        if (TimeStepBounds<Mesh>::supported && pinfo.max_num_time_segments >= TimeStepBoundsTable::MIN_TIME_SEGMENTS)
+          table.build<Mesh>(scene);
         
         /* build hierarchy */
         auto root =
           BVHBuilderMSMBlur::build<NodeRef>(prims,pinfo,scene->device,
-                                            RecalculatePrimRef<Mesh>(scene),
+                                            RecalculatePrimRef<Mesh>(scene, table.valid() ? &table : nullptr),
                                             typename BVH::CreateAlloc(bvh),
                                             typename BVH::AABBNodeMB4D::Create(),
                                             typename BVH::AABBNodeMB4D::Set(),
@@ -255,6 +260,13 @@ namespace embree
           return mesh->linearBounds(mesh->grid(primID),x,y,time_range);
         }
 
+        __forceinline range<int> timeSegmentRange(const PrimRefMB& prim, const BBox1f time_range) const {
+          return scene->get<GridMesh>(prim.geomID())->timeSegmentRange(time_range);
+        }
+
+        __forceinline float timeStep(const PrimRefMB& prim, size_t itime) const {
+          return scene->get<GridMesh>(prim.geomID())->timeStep(itime);
+        }
     };
 
     template<int N>
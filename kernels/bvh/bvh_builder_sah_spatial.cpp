@@ -3,6 +3,7 @@
 
 #include "bvh.h"
 #include "bvh_builder.h"
+#include "bvh_statistics.h"
 
 #include "../builders/primrefgen.h"
 #include "../builders/primrefgen_presplit.h"
@@ -60,16 +61,17 @@ namespace embree
       mvector<PrimRef> prims0;
       GeneralBVHBuilder::Settings settings;
       const float splitFactor;
+      const bool adaptiveSplits;
       unsigned int geomID_ = std::numeric_limits<unsigned int>::max();
       unsigned int numPreviousPrimitives = 0;
 
       BVHNBuilderFastSpatialSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(scene), mesh(nullptr), prims0(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD),
-          splitFactor(scene->device->max_spatial_split_replications) {}
+          splitFactor(scene->device->max_spatial_split_replications), adaptiveSplits(scene->device->adaptive_spatial_splits) {}
 
       BVHNBuilderFastSpatialSAH (BVH* bvh, Mesh* mesh, const unsigned int geomID, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(nullptr), mesh(mesh), prims0(bvh->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD),
-          splitFactor(scene->device->max_spatial_split_replications), geomID_(geomID) {}
+          splitFactor(bvh->device->max_spatial_split_replications), adaptiveSplits(bvh->device->adaptive_spatial_splits), geomID_(geomID) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
@@ -90,7 +92,7 @@ namespace embree
         }
 
         const unsigned int maxGeomID = mesh ? geomID_ : scene->getMaxGeomID<Mesh,false>();
-        const bool usePreSplits = scene->device->useSpatialPreSplits || (maxGeomID >= ((unsigned int)1 << (32-RESERVED_NUM_SPATIAL_SPLITS_GEOMID_BITS)));
+        const bool usePreSplits = bvh->device->useSpatialPreSplits || (maxGeomID >= ((unsigned int)1 << (32-RESERVED_NUM_SPATIAL_SPLITS_GEOMID_BITS)));
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + (usePreSplits ? "BuilderFastSpatialPresplitSAH" : "BuilderFastSpatialSAH"));
 
         /* create primref array */
@@ -109,8 +111,8 @@ namespace embree
 	  {		     
             /* spatial presplit SAH BVH builder */
 	    pinfo = mesh ?
-	      createPrimRefArray_presplit<Mesh,Splitter>(mesh,maxGeomID,numOriginalPrimitives,prims0,bvh->scene->progressInterface) :
-	      createPrimRefArray_presplit<Mesh,Splitter>(scene,Mesh::geom_type,false,numOriginalPrimitives,prims0,bvh->scene->progressInterface);
+	      createPrimRefArray_presplit<Mesh,Splitter>(bvh->scene,mesh,maxGeomID,numOriginalPrimitives,prims0,bvh->scene->progressInterface,adaptiveSplits) :
+	      createPrimRefArray_presplit<Mesh,Splitter>(scene,Mesh::geom_type,false,numOriginalPrimitives,prims0,bvh->scene->progressInterface,adaptiveSplits);
 
 	    const size_t node_bytes = pinfo.size()*sizeof(typename BVH::AABBNode)/(4*N);
 	    const size_t leaf_bytes = size_t(1.2*Primitive::blocks(pinfo.size())*sizeof(Primitive));
@@ -130,7 +132,7 @@ namespace embree
 	      createPrimRefArray(mesh,geomID_,numSplitPrimitives,prims0,bvh->scene->progressInterface) :
 	      createPrimRefArray(scene,Mesh::geom_type,false,numSplitPrimitives,prims0,bvh->scene->progressInterface);
 	
-	    Splitter splitter(scene);
+	    Splitter splitter(mesh ? bvh->scene : scene);
 
 	    const size_t node_bytes = pinfo.size()*sizeof(typename BVH::AABBNode)/(4*N);
 	    const size_t leaf_bytes = size_t(1.2*Primitive::blocks(pinfo.size())*sizeof(Primitive));
@@ -164,6 +166,17 @@ namespace embree
         }
 	bvh->cleanup();
         bvh->postBuild(t0);
+
+        /* report how much of the split budget got spent */
+        if (bvh->device->verbosity(1))
+        {
+          BVHNStatistics<N> stat(bvh);
+          const size_t numReferences = stat.numReferences();
+          Lock<MutexSys> lock(g_printMutex);
+          std::cout << "  spatial splits: " << (adaptiveSplits ? "adaptive" : "fixed") << " budget, ";
+          std::cout << numReferences << " references for " << numOriginalPrimitives << " primitives (";
+          std::cout << 100.0*double(numReferences)/double(numOriginalPrimitives) << "%), sah = " << stat.sah() << std::endl;
+        }
       }
 
       void clear() {
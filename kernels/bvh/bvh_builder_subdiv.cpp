@@ -515,6 +515,14 @@ namespace embree
       __forceinline LBBox3fa linearBounds(const PrimRefMB& prim, const BBox1f time_range) const {
         return LBBox3fa([&] (size_t itime) { return bounds[prim.ID()+itime]; }, time_range, (float)prim.totalTimeSegments());
       }
+
+      __forceinline range<int> timeSegmentRange(const PrimRefMB& prim, const BBox1f time_range) const {
+        return getTimeSegmentRange(time_range, (float)prim.totalTimeSegments());
+      }
+
+      __forceinline float timeStep(const PrimRefMB& prim, size_t itime) const {
+        return float(itime)/float(prim.totalTimeSegments());
+      }
     };
 
     template<int N>
@@ -0,0 +1,51 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "../common/default.h"
+
+namespace embree
+{
+  /*! Adapts the number of active rays at which the hybrid packet
+   *  traversal of a BVH switches to single ray traversal. The lane
+   *  occupancy of the packet node visits of sampled traversals gets
+   *  averaged over time. Packets of coherent rays keep most lanes active
+   *  and switch late, packets of incoherent rays switch early. */
+  struct HybridSwitch
+  {
+    /*! every SAMPLE_RATE'th traversal of a thread updates the occupancy */
+    static const unsigned int SAMPLE_RATE = 16;
+
+    HybridSwitch ()
+      : enabled(false), occupancy(0.5f) {}
+
+    /*! returns the switch threshold interpolated between the thresholds for coherent and incoherent rays */
+    __forceinline size_t threshold(size_t coherentThreshold, size_t incoherentThreshold) const
+    {
+      /* occupancies below 25% count as incoherent and above 75% as coherent */
+      const float f = clamp(2.0f*(occupancy.load(std::memory_order_relaxed)-0.25f),0.0f,1.0f);
+      return size_t(float(incoherentThreshold) + f*(float(coherentThreshold)-float(incoherentThreshold)) + 0.5f);
+    }
+
+    /*! returns true if the current traversal of this thread should update the occupancy */
+    static __forceinline bool sample()
+    {
+      static __thread unsigned int count = 0;
+      return (count++ % SAMPLE_RATE) == 0;
+    }
+
+    /*! averages the occupancy of the packet node visits of a traversal of K wide packets into the running occupancy */
+    __forceinline void update(size_t K, size_t nodes, size_t lanes)
+    {
+      if (nodes == 0) return;
+      const float o = float(lanes)/float(nodes*K);
+      const float cur = occupancy.load(std::memory_order_relaxed);
+      occupancy.store(cur + (o-cur)*(1.0f/16.0f),std::memory_order_relaxed);
+    }
+
+  public:
+    bool enabled;                   //!< true if the switch threshold gets adapted
+    std::atomic<float> occupancy;   //!< running average of the fraction of active lanes at packet node visits
+  };
+}
@@ -23,8 +23,10 @@
 #include "../geometry/trianglev_intersector.h"
 #include "../geometry/trianglev_mb_intersector.h"
 #include "../geometry/trianglei_intersector.h"
+#include "../geometry/trianglec_intersector.h"
 #include "../geometry/quadv_intersector.h"
 #include "../geometry/quadi_intersector.h"
+#include "../geometry/quadc_intersector.h"
 #include "../geometry/bezier1v_intersector.h"
 #include "../geometry/bezier1i_intersector.h"
 #include "../geometry/linei_intersector.h"
@@ -153,6 +155,27 @@ namespace embree
       assert(ray.tnear >= 0.0f);
       assert(!(types & BVH_MB) || (ray.time >= 0.0f && ray.time <= 1.0f));
 
+      /*! test the leaf of the last occluder of the ray group first,
+       *  instanced BVHs traversed from here do not use the cache */
+      OccluderCache* cache = context->occluderCache;
+      if (unlikely(cache != nullptr))
+      {
+        context->occluderCache = nullptr;
+        bool occluded = false;
+        if (cache->bvh == bvh) {
+          STAT3(shadow.trav_leaves,1,1,1);
+          context->geomID_to_instID = nullptr;
+          size_t num; Primitive* prim = (Primitive*) NodeRef(cache->leaf).leaf(num);
+          size_t lazy_node = 0;
+          occluded = PrimitiveIntersector1::occluded(pre,ray,context,prim,num,lazy_node);
+        }
+        if (occluded || cache->cacheOnly) {
+          if (occluded) { ray.geomID = 0; STAT3(shadow.trav_cache_hits,1,1,1); }
+          context->occluderCache = cache;
+          return;
+        }
+      }
+
       /*! load the ray into SIMD registers */
       context->geomID_to_instID = nullptr;
       TravRay<N,Nx> vray(ray.org,ray.dir);
@@ -202,6 +225,11 @@ namespace embree
         size_t lazy_node = 0;
         if (PrimitiveIntersector1::occluded(pre,ray,context,prim,num,lazy_node)) {
           ray.geomID = 0;
+          /* cache the leaf unless it got reached through a transformation node */
+          if (unlikely(cache != nullptr) && context->geomID_to_instID == nullptr) {
+            cache->bvh = bvh;
+            cache->leaf = cur;
+          }
           break;
         }
 
@@ -211,7 +239,41 @@ namespace embree
           stackPtr++;
         }
       }
+      if (unlikely(cache != nullptr))
+        context->occluderCache = cache;
       AVX_ZERO_UPPER();
     }
+
+    template<int N, int K, typename Intersector1>
+    void BVHNIntersectorKFrom1<N,K,Intersector1>::intersect(vint<K>* __restrict__ valid_i, Accel::Intersectors* __restrict__ This, RayK<K>& __restrict__ ray, IntersectContext* __restrict__ context)
+    {
+      const BVH* __restrict__ bvh = (const BVH*)This->ptr;
+      if (bvh->root == BVH::emptyNode) return;
+
+      const vbool<K> valid = (*valid_i == -1) & (ray.tnear <= ray.tfar);
+      for (size_t bits = movemask(valid); bits != 0; )
+      {
+        const size_t k = __bscf(bits);
+        Ray ray1; ray.get(k,ray1);
+        Intersector1::intersect(bvh,ray1,context);
+        ray.set(k,ray1);
+      }
+    }
+
+    template<int N, int K, typename Intersector1>
+    void BVHNIntersectorKFrom1<N,K,Intersector1>::occluded(vint<K>* __restrict__ valid_i, Accel::Intersectors* __restrict__ This, RayK<K>& __restrict__ ray, IntersectContext* __restrict__ context)
+    {
+      const BVH* __restrict__ bvh = (const BVH*)This->ptr;
+      if (bvh->root == BVH::emptyNode) return;
+
+      const vbool<K> valid = (*valid_i == -1) & (ray.tnear <= ray.tfar);
+      for (size_t bits = movemask(valid); bits != 0; )
+      {
+        const size_t k = __bscf(bits);
+        Ray ray1; ray.get(k,ray1);
+        Intersector1::occluded(bvh,ray1,context);
+        ray.set(k,ray1);
+      }
+    }
   }
 }
@@ -30,5 +30,17 @@ namespace embree
       static void occluded  (const Accel::Intersectors* This, Ray& ray, RayQueryContext* context);
       static bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context);
     };
+
+    /*! BVH packet intersector that traces the active rays of a packet one
+     *  by one with a single ray intersector, for BVHs without packet traversal. */
+    template<int N, int K, typename Intersector1>
+    class BVHNIntersectorKFrom1
+    {
+      typedef BVHN<N> BVH;
+
+    public:
+      static void intersect(vint<K>* valid, Accel::Intersectors* This, RayK<K>& ray, IntersectContext* context);
+      static void occluded (vint<K>* valid, Accel::Intersectors* This, RayK<K>& ray, IntersectContext* context);
+    };
   }
 }
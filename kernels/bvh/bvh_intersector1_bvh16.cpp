@@ -0,0 +1,25 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "bvh_intersector1.cpp"
+
+namespace embree
+{
+  namespace isa
+  {
+    ////////////////////////////////////////////////////////////////////////////////
+    /// BVH16Intersector1 Definitions
+    ////////////////////////////////////////////////////////////////////////////////
+
+    IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH16Triangle4Intersector1Moeller, BVHNIntersector1<16 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<TriangleMIntersector1Moeller<SIMD_MODE(4) COMMA true> > >));
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// BVH16IntersectorK Definitions
+    ////////////////////////////////////////////////////////////////////////////////
+
+    /* there is no packet traversal for BVH16, packets trace their active rays one by one */
+    IF_ENABLED_TRIS(DEFINE_INTERSECTOR4 (BVH16Triangle4Intersector4Moeller,  BVHNIntersectorKFrom1<16 COMMA 4  COMMA BVHNIntersector1<16 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<TriangleMIntersector1Moeller<SIMD_MODE(4) COMMA true> > > >));
+    IF_ENABLED_TRIS(DEFINE_INTERSECTOR8 (BVH16Triangle4Intersector8Moeller,  BVHNIntersectorKFrom1<16 COMMA 8  COMMA BVHNIntersector1<16 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<TriangleMIntersector1Moeller<SIMD_MODE(4) COMMA true> > > >));
+    IF_ENABLED_TRIS(DEFINE_INTERSECTOR16(BVH16Triangle4Intersector16Moeller, BVHNIntersectorKFrom1<16 COMMA 16 COMMA BVHNIntersector1<16 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<TriangleMIntersector1Moeller<SIMD_MODE(4) COMMA true> > > >));
+  }
+}
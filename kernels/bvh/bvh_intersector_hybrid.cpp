@@ -23,8 +23,10 @@
 #include "../geometry/trianglev_intersector.h"
 #include "../geometry/trianglev_mb_intersector.h"
 #include "../geometry/trianglei_intersector.h"
+#include "../geometry/trianglec_intersector.h"
 #include "../geometry/quadv_intersector.h"
 #include "../geometry/quadi_intersector.h"
+#include "../geometry/quadc_intersector.h"
 #include "../geometry/bezier1v_intersector.h"
 #include "../geometry/bezier1i_intersector.h"
 #include "../geometry/linei_intersector.h"
@@ -181,8 +183,12 @@ namespace embree
         nearXYZ.z = select(rdir.z >= 0.0f,vint<K>(4*(int)sizeof(vfloat<N>)),vint<K>(5*(int)sizeof(vfloat<N>)));
       }
 
-      /* determine switch threshold based on flags */
-      const size_t switchThreshold = (context->user && isCoherent(context->user->flags)) ? 2 : switchThresholdIncoherent;
+      /* an explicit coherent flag fixes the switch threshold, otherwise it gets determined adaptively from the lane occupancy of previous traversals */
+      const bool coherent = context->user && isCoherent(context->user->flags);
+      const bool adaptive = !coherent && bvh->hybridSwitch.enabled && HybridSwitch::sample();
+      const size_t switchThreshold = coherent ? 2 :
+        bvh->hybridSwitch.enabled ? bvh->hybridSwitch.threshold(2,switchThresholdIncoherent) : switchThresholdIncoherent;
+      size_t packetNodes = 0, activeLanes = 0;
 
       vint<K> octant = ray.octant();
       octant = select(valid, octant, vint<K>(0xffffffff));
@@ -229,6 +235,12 @@ namespace embree
           if (unlikely(none(active)))
             continue;
 
+          /* sample the occupancy before the switch test, such that nodes that switch to single rays count too */
+          const NodeRef popped = cur;
+          if (unlikely(adaptive)) {
+            packetNodes++; activeLanes += popcnt(active);
+          }
+
           /* switch to single ray traversal */
 #if (!defined(__WIN32__) || defined(__X86_64__)) && defined(__SSE4_2__)
 #if FORCE_SINGLE_MODE == 0
@@ -240,6 +252,7 @@ namespace embree
             if (unlikely(__popcnt(bits) <= switchThreshold))
 #endif
             {
+              STAT3(normal.trav_switches,1,__popcnt(bits),K);
               for (; bits!=0; ) {
                 const size_t i = __bscf(bits);
                 intersect1(bvh, cur, i, pre, ray, ray_org, ray_dir, rdir, ray_tnear, ray_tfar, nearXYZ, context);
@@ -254,6 +267,9 @@ namespace embree
             /* process nodes */
             const vbool<K> valid_node = ray_tfar > curDist;
             STAT3(normal.trav_nodes,1,popcnt(valid_node),K);
+            if (unlikely(adaptive) && cur != popped) {
+              packetNodes++; activeLanes += popcnt(valid_node);
+            }
             const NodeRef nodeRef = cur;
             const BaseNode* __restrict__ const node = nodeRef.baseNode(types);
 
@@ -371,6 +387,8 @@ namespace embree
         }
       } while(valid_bits);
 
+      if (unlikely(adaptive))
+        bvh->hybridSwitch.update(K,packetNodes,activeLanes);
       AVX_ZERO_UPPER();
     }
 
@@ -810,8 +828,12 @@ namespace embree
         nearXYZ.z = select(rdir.z >= 0.0f,vint<K>(4*(int)sizeof(vfloat<N>)),vint<K>(5*(int)sizeof(vfloat<N>)));
       }
 
-      /* determine switch threshold based on flags */
-      const size_t switchThreshold = (context->user && isCoherent(context->user->flags)) ? 2 : switchThresholdIncoherent;
+      /* an explicit coherent flag fixes the switch threshold, otherwise it gets determined adaptively from the lane occupancy of previous traversals */
+      const bool coherent = context->user && isCoherent(context->user->flags);
+      const bool adaptive = !coherent && bvh->hybridSwitch.enabled && HybridSwitch::sample();
+      const size_t switchThreshold = coherent ? 2 :
+        bvh->hybridSwitch.enabled ? bvh->hybridSwitch.threshold(2,switchThresholdIncoherent) : switchThresholdIncoherent;
+      size_t packetNodes = 0, activeLanes = 0;
 
       /* allocate stack and push root node */
       vfloat<K> stack_near[stackSizeChunk];
@@ -842,12 +864,19 @@ namespace embree
         if (unlikely(none(active)))
           continue;
 
+        /* sample the occupancy before the switch test, such that nodes that switch to single rays count too */
+        const NodeRef popped = cur;
+        if (unlikely(adaptive)) {
+          packetNodes++; activeLanes += popcnt(active);
+        }
+
         /* switch to single ray traversal */
 #if (!defined(__WIN32__) || defined(__X86_64__)) && defined(__SSE4_2__)
         if (single)
         {
           size_t bits = movemask(active);
           if (unlikely(__popcnt(bits) <= switchThreshold)) {
+            STAT3(shadow.trav_switches,1,__popcnt(bits),K);
             for (; bits!=0; ) {
               const size_t i = __bscf(bits);
               if (occluded1(bvh,cur,i,pre,ray,ray_org,ray_dir,rdir,ray_tnear,ray_tfar,nearXYZ,context))
@@ -865,6 +894,9 @@ namespace embree
           /* process nodes */
           const vbool<K> valid_node = ray_tfar > curDist;
           STAT3(shadow.trav_nodes,1,popcnt(valid_node),K);
+          if (unlikely(adaptive) && cur != popped) {
+            packetNodes++; activeLanes += popcnt(valid_node);
+          }
           const NodeRef nodeRef = cur;
           const BaseNode* __restrict__ const node = nodeRef.baseNode(types);
 
@@ -944,6 +976,9 @@ namespace embree
           *sptr_near = neg_inf;   sptr_near++;
         }
       }
+
+      if (unlikely(adaptive))
+        bvh->hybridSwitch.update(K,packetNodes,activeLanes);
 #endif
       vint<K>::store(valid & terminated,&ray.geomID,0);
       AVX_ZERO_UPPER();
@@ -271,6 +271,24 @@ namespace embree
       return mask;
     }
     
+    template<>
+      __forceinline size_t intersectNode<16,16>(const typename BVH16::AlignedNode* node, const TravRay<16,16>& ray, const vfloat16& tnear, const vfloat16& tfar, vfloat16& dist)
+    {
+      /* all 16 children of the node are tested with a single vfloat16 operation per slab */
+      const vfloat16 tNearX = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.nearX)), ray.rdir.x, ray.org_rdir.x);
+      const vfloat16 tNearY = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.nearY)), ray.rdir.y, ray.org_rdir.y);
+      const vfloat16 tNearZ = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.nearZ)), ray.rdir.z, ray.org_rdir.z);
+      const vfloat16 tFarX  = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.farX )), ray.rdir.x, ray.org_rdir.x);
+      const vfloat16 tFarY  = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.farY )), ray.rdir.y, ray.org_rdir.y);
+      const vfloat16 tFarZ  = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.farZ )), ray.rdir.z, ray.org_rdir.z);
+      const vfloat16 tNear  = max(tNearX,tNearY,tNearZ,tnear);
+      const vfloat16 tFar   = min(tFarX ,tFarY ,tFarZ ,tfar);
+      const vbool16 vmask   = tNear <= tFar;
+      const size_t mask     = movemask(vmask);
+      dist = tNear;
+      return mask;
+    }
+
 #endif
 
     template<int N, int K>
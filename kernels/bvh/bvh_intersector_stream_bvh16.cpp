@@ -0,0 +1,17 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "bvh_intersector_stream.cpp"
+
+namespace embree
+{
+  namespace isa
+  {
+    ////////////////////////////////////////////////////////////////////////////////
+    /// BVH16IntersectorStream Definitions
+    ////////////////////////////////////////////////////////////////////////////////
+
+    /* streams are traced as ray packets, which BVH16 traces one ray at a time */
+    IF_ENABLED_TRIS(DEFINE_INTERSECTORN(BVH16Triangle4IntersectorStreamFallback, BVHNIntersectorStreamPacketFallback<16 COMMA 16 COMMA VSIZEX>));
+  }
+}
@@ -14,6 +14,7 @@
 #include "../geometry/instance_array.h"
 
 #include "../../common/algorithms/parallel_for.h"
+#include "../../common/algorithms/parallel_reduce.h"
 
 namespace embree
 {
@@ -31,7 +32,7 @@ namespace embree
 
     template<int N>
     BVHNRefitter<N>::BVHNRefitter (BVH* bvh, const LeafBoundsInterface& leafBounds)
-      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0)
+      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0), linked(false), epoch(0), sahArea(0.0)
     {
     }
 
@@ -47,18 +48,155 @@ namespace embree
         numSubTrees = 0;
         gather_subtree_refs(bvh->root,numSubTrees,0);
         if (numSubTrees)
-          parallel_for(size_t(0), numSubTrees, size_t(1), [&](const range<size_t>& r) {
+          parallel_for_affinity(size_t(0), numSubTrees, size_t(1), [&](const range<size_t>& r) {
               for (size_t i=r.begin(); i<r.end(); i++) {
                 NodeRef& ref = subTrees[i];
                 subTreeBounds[i] = recurse_bottom(ref);
               }
-            });
+            },subTreeAffinity);
 
         numSubTrees = 0;        
         bvh->bounds = LBBox3fa(refit_toplevel(bvh->root,numSubTrees,subTreeBounds,0));
       }    
+
+      if (linked)
+        sahArea = sah_area();
   }
 
+    template<int N>
+    void BVHNRefitter<N>::link()
+    {
+      nodes.clear(); nodeParents.clear(); nodeDepths.clear();
+      leaves.clear(); leafParents.clear();
+      link(bvh->root,ParentLink(-1,0),0);
+
+      nodeEpochs.reset(new std::atomic<unsigned>[nodes.size()]);
+      for (size_t i=0; i<nodes.size(); i++) nodeEpochs[i] = 0;
+      dirtyNodes.resize(nodes.size());
+      epoch = 0;
+      sahArea = sah_area();
+      linked = true;
+    }
+
+    template<int N>
+    void BVHNRefitter<N>::link(NodeRef ref, const ParentLink& parent, unsigned depth)
+    {
+      if (unlikely(ref == BVH::emptyNode))
+        return;
+
+      if (ref.isLeaf()) {
+        leaves.push_back(ref);
+        leafParents.push_back(parent);
+        return;
+      }
+
+      const unsigned nodeID = (unsigned) nodes.size();
+      AABBNode* node = ref.getAABBNode();
+      nodes.push_back(node);
+      nodeParents.push_back(parent);
+      nodeDepths.push_back(depth);
+      for (size_t i=0; i<N; i++)
+        link(node->child(i),ParentLink(nodeID,(unsigned)i),depth+1);
+    }
+
+    template<int N>
+    void BVHNRefitter<N>::unlink()
+    {
+      linked = false;
+      nodes.clear(); nodeParents.clear(); nodeDepths.clear();
+      leaves.clear(); leafParents.clear();
+      dirtyNodes.clear();
+      nodeEpochs.reset();
+    }
+
+    template<int N>
+    double BVHNRefitter<N>::setChildBounds(const ParentLink& parent, const BBox3fa& bounds, float weight)
+    {
+      AABBNode* node = nodes[parent.parent];
+      const BBox3fa old = node->bounds(parent.slot);
+      node->setBounds(parent.slot,bounds);
+      return double(weight)*(double(halfArea(bounds))-double(halfArea(old)));
+    }
+
+    template<int N>
+    double BVHNRefitter<N>::sah_area() const
+    {
+      return parallel_reduce(size_t(0), nodes.size(), size_t(1024), 0.0, [&](const range<size_t>& r) -> double
+      {
+        double area = 0.0;
+        for (size_t i=r.begin(); i<r.end(); i++)
+        {
+          const AABBNode* node = nodes[i];
+          for (size_t j=0; j<N; j++) {
+            if (unlikely(node->child(j) == BVH::emptyNode)) continue;
+            area += double(weight(node->child(j)))*double(halfArea(node->bounds(j)));
+          }
+        }
+        return area;
+      }, std::plus<double>());
+    }
+
+    template<int N>
+    float BVHNRefitter<N>::sah() const
+    {
+      const float rootArea = halfArea(bvh->bounds.bounds());
+      if (rootArea <= 0.0f) return 1.0f;
+      return float(1.0 + sahArea/double(rootArea));
+    }
+
+    template<int N>
+    void BVHNRefitter<N>::refit_partial(const vector<unsigned>& leafIDs)
+    {
+      assert(linked);
+      const unsigned current = ++epoch;
+      std::atomic<size_t> numDirtyNodes(0);
+
+      /* refit leaves and mark all their ancestors, the first leaf reaching a node marks it */
+      sahArea += parallel_reduce(size_t(0), leafIDs.size(), size_t(64), 0.0, [&](const range<size_t>& r) -> double
+      {
+        double delta = 0.0;
+        for (size_t i=r.begin(); i<r.end(); i++)
+        {
+          const unsigned leafID = leafIDs[i];
+          const BBox3fa bounds = leafBounds.leafBounds(leaves[leafID]);
+          const ParentLink& parent = leafParents[leafID];
+          if (unlikely(parent.parent == unsigned(-1))) {
+            bvh->bounds = LBBox3fa(bounds);
+            continue;
+          }
+          delta += setChildBounds(parent,bounds,weight(leaves[leafID]));
+
+          for (unsigned n=parent.parent; n!=unsigned(-1) && nodeEpochs[n].exchange(current) != current; n=nodeParents[n].parent)
+            dirtyNodes[numDirtyNodes++] = n;
+        }
+        return delta;
+      }, std::plus<double>());
+
+      /* refit marked nodes bottom up, all nodes of the same depth are independent */
+      const size_t numDirty = numDirtyNodes;
+      std::sort(dirtyNodes.begin(),dirtyNodes.begin()+numDirty,[&] (unsigned a, unsigned b) { return nodeDepths[a] > nodeDepths[b]; });
+
+      for (size_t begin=0, end=0; begin<numDirty; begin=end)
+      {
+        const unsigned depth = nodeDepths[dirtyNodes[begin]];
+        for (end=begin+1; end<numDirty && nodeDepths[dirtyNodes[end]] == depth; end++);
+
+        sahArea += parallel_reduce(begin, end, size_t(64), 0.0, [&](const range<size_t>& r) -> double
+        {
+          double delta = 0.0;
+          for (size_t i=r.begin(); i<r.end(); i++)
+          {
+            const unsigned nodeID = dirtyNodes[i];
+            const BBox3fa bounds = nodes[nodeID]->bounds();
+            const ParentLink& parent = nodeParents[nodeID];
+            if (parent.parent == unsigned(-1)) bvh->bounds = LBBox3fa(bounds);
+            else delta += setChildBounds(parent,bounds,1.0f);
+          }
+          return delta;
+        }, std::plus<double>());
+      }
+    }
+
     template<int N>
     void BVHNRefitter<N>::gather_subtree_refs(NodeRef& ref,
                                               size_t &subtrees,
@@ -171,7 +309,7 @@ namespace embree
 
     template<int N, typename Mesh, typename Primitive>
     BVHNRefitT<N,Mesh,Primitive>::BVHNRefitT (BVH* bvh, Builder* builder, Mesh* mesh, size_t mode)
-      : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh), topologyVersion(0) {}
+      : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh), topologyVersion(0), buildSAH(1.0f) {}
 
     template<int N, typename Mesh, typename Primitive>
     void BVHNRefitT<N,Mesh,Primitive>::clear()
@@ -185,10 +323,107 @@ namespace embree
     {
       if (mesh->topologyChanged(topologyVersion)) {
         topologyVersion = mesh->getTopologyVersion();
-        builder->build();
+        vertexPrimOffsets.clear();
+        vertexPrims.clear();
+        rebuild();
+        return;
       }
-      else
+
+      /* the links are established on the first refit after a build, this also records the SAH of the build */
+      if (!refitter->linked) {
+        refitter->link();
+        buildSAH = refitter->sah();
+      }
+
+      if (!refit_partial(SupportsPartialRefit()))
         refitter->refit();
+
+      /* rebuild once refitting degraded the BVH too much */
+      if (refitter->sah() > buildSAH*mesh->scene->device->refit_rebuild_threshold)
+        rebuild();
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    void BVHNRefitT<N,Mesh,Primitive>::rebuild()
+    {
+      builder->build();
+      refitter->unlink();
+      primLeaves.clear();
+      leafEpochs.clear();
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    bool BVHNRefitT<N,Mesh,Primitive>::refit_partial(std::true_type)
+    {
+      typedef RefitPrimitiveVertices<Mesh> PrimitiveVertices;
+
+      DirtyRanges& dirty = mesh->dirtyVertices;
+      if (dirty.isAll()) return false;
+      dirty.normalize();
+
+      /* refitting everything is faster if a large part of the mesh deformed */
+      const size_t numVertices = mesh->numVertices();
+      if (dirty.numItems() > numVertices/4) return false;
+
+      /* the primitives using each vertex only change with the topology */
+      const size_t numPrims = mesh->size();
+      if (vertexPrimOffsets.size() != numVertices+1)
+      {
+        vertexPrimOffsets.resize(numVertices+1);
+        for (size_t i=0; i<=numVertices; i++) vertexPrimOffsets[i] = 0;
+        for (size_t i=0; i<numPrims; i++)
+          for (size_t j=0; j<PrimitiveVertices::N; j++) {
+            const unsigned v = PrimitiveVertices::get(mesh,i,j);
+            if (v < numVertices) vertexPrimOffsets[v+1]++;
+          }
+        for (size_t i=0; i<numVertices; i++) vertexPrimOffsets[i+1] += vertexPrimOffsets[i];
+
+        vertexPrims.resize(vertexPrimOffsets[numVertices]);
+        vector<unsigned> fill(numVertices);
+        for (size_t i=0; i<numVertices; i++) fill[i] = vertexPrimOffsets[i];
+        for (size_t i=0; i<numPrims; i++)
+          for (size_t j=0; j<PrimitiveVertices::N; j++) {
+            const unsigned v = PrimitiveVertices::get(mesh,i,j);
+            if (v < numVertices) vertexPrims[fill[v]++] = (unsigned) i;
+          }
+      }
+
+      /* the leaf containing each primitive only changes with the BVH */
+      const vector<NodeRef>& leaves = refitter->leaves;
+      if (primLeaves.size() != numPrims)
+      {
+        primLeaves.resize(numPrims);
+        for (size_t i=0; i<numPrims; i++) primLeaves[i] = unsigned(-1); // invalid primitives are not contained in any leaf
+        parallel_for(size_t(0), leaves.size(), size_t(256), [&](const range<size_t>& r) {
+            for (size_t l=r.begin(); l<r.end(); l++)
+            {
+              size_t ty; Primitive* prim = (Primitive*) leaves[l].leaf(ty);
+              for (size_t i=0;; i++) {
+                for (size_t j=0; j<Primitive::max_size(); j++)
+                  if (prim[i].valid(j)) primLeaves[prim[i].primID(j)] = (unsigned) l;
+                if (prim[i].last()) break;
+              }
+            }
+          });
+        leafEpochs.resize(leaves.size());
+        for (size_t l=0; l<leaves.size(); l++) leafEpochs[l] = 0;
+      }
+
+      /* gather the leaves of all primitives using a modified vertex */
+      const unsigned current = refitter->epoch+1;
+      vector<unsigned> leafIDs;
+      for (const auto& r : dirty.ranges)
+        for (size_t v=r.begin(); v<r.end(); v++)
+          for (size_t k=vertexPrimOffsets[v]; k<vertexPrimOffsets[v+1]; k++)
+          {
+            const unsigned leafID = primLeaves[vertexPrims[k]];
+            if (leafID == unsigned(-1) || leafEpochs[leafID] == current) continue;
+            leafEpochs[leafID] = current;
+            leafIDs.push_back(leafID);
+          }
+
+      refitter->refit_partial(leafIDs);
+      return true;
     }
 
     template class BVHNRefitter<4>;
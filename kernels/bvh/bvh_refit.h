@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../bvh/bvh.h"
+#include "../../common/algorithms/parallel_for.h"
 
 namespace embree
 {
@@ -23,6 +24,17 @@ namespace embree
         virtual const BBox3fa leafBounds(NodeRef& ref) const = 0;
       };
 
+      /*! parent of a node or leaf, required to propagate bounds upwards */
+      struct ParentLink
+      {
+        __forceinline ParentLink () {}
+        __forceinline ParentLink (unsigned parent, unsigned slot)
+          : parent(parent), slot(slot) {}
+
+        unsigned parent; //!< index of parent node, or -1 for the root
+        unsigned slot;   //!< child slot inside the parent node
+      };
+
     public:
     
       /*! Constructor. */
@@ -31,6 +43,35 @@ namespace embree
       /*! refits the BVH */
       void refit();
 
+      /*! links all nodes and leaves to their parents, required for partial refits and SAH tracking */
+      void link();
+
+      /*! invalidates the links after the BVH got rebuilt */
+      void unlink();
+
+      /*! refits the specified leaves and all their ancestors only */
+      void refit_partial(const vector<unsigned>& leafIDs);
+
+      /*! returns the SAH cost of the linked BVH */
+      float sah() const;
+
+    private:
+      /* single-threaded linking of nodes and leaves to their parents */
+      void link(NodeRef ref, const ParentLink& parent, unsigned depth);
+
+      /* updates the bounds of a child slot, returns the weighted change of the SAH area */
+      double setChildBounds(const ParentLink& parent, const BBox3fa& bounds, float weight);
+
+      /* calculates the sum of the weighted areas of all child slots */
+      double sah_area() const;
+
+      /* SAH weight of a child, leaves are weighted by their number of primitive blocks */
+      static __forceinline float weight(NodeRef ref) {
+        if (ref.isAABBNode()) return 1.0f;
+        size_t num; ref.leaf(num);
+        return float(num);
+      }
+
     private:
       /* single-threaded subtree extraction based on BVH depth */
       void gather_subtree_refs(NodeRef& ref, 
@@ -54,6 +95,39 @@ namespace embree
       static const size_t MAX_NUM_SUB_TREES             = (N==4) ? 256 : (N==8) ? 512 : N*N*N; // N ^ MAX_SUB_TREE_EXTRACTION_DEPTH
       size_t numSubTrees;
       NodeRef subTrees[MAX_NUM_SUB_TREES];
+      affinity_partitioner subTreeAffinity;  //!< refits each subtree on the same thread as in the last refit
+
+    public:
+      bool linked;                                      //!< true if nodes and leaves are linked to their parents
+      vector<AABBNode*> nodes;                          //!< all nodes of the BVH, the root first
+      vector<ParentLink> nodeParents;                   //!< parent of each node
+      vector<unsigned> nodeDepths;                      //!< depth of each node
+      vector<NodeRef> leaves;                           //!< all leaves of the BVH
+      vector<ParentLink> leafParents;                   //!< parent of each leaf
+      std::unique_ptr<std::atomic<unsigned>[]> nodeEpochs; //!< epoch in which a node got last marked for refitting
+      vector<unsigned> dirtyNodes;                      //!< nodes marked for refitting
+      unsigned epoch;                                   //!< current partial refit
+      double sahArea;                                   //!< sum of weighted areas of all child slots
+    };
+
+    /*! access to the vertices of primitives of meshes supporting partial refits */
+    template<typename Mesh>
+    struct RefitPrimitiveVertices {
+      static const size_t N = 0;
+    };
+
+    template<>
+    struct RefitPrimitiveVertices<TriangleMesh>
+    {
+      static const size_t N = 3;
+      static __forceinline unsigned get(const TriangleMesh* mesh, size_t primID, size_t i) { return mesh->triangle(primID).v[i]; }
+    };
+
+    template<>
+    struct RefitPrimitiveVertices<QuadMesh>
+    {
+      static const size_t N = 4;
+      static __forceinline unsigned get(const QuadMesh* mesh, size_t primID, size_t i) { return mesh->quad(primID).v[i]; }
     };
 
     template<int N, typename Mesh, typename Primitive>
@@ -65,6 +139,7 @@ namespace embree
       typedef BVHN<N> BVH;
       typedef typename BVH::AABBNode AABBNode;
       typedef typename BVH::NodeRef NodeRef;
+      typedef std::integral_constant<bool,RefitPrimitiveVertices<Mesh>::N != 0> SupportsPartialRefit;
       
     public:
       BVHNRefitT (BVH* bvh, Builder* builder, Mesh* mesh, size_t mode);
@@ -86,12 +161,25 @@ namespace embree
         return bounds;
       }
       
+    private:
+      /* rebuilds the BVH and invalidates all information about the previous BVH */
+      void rebuild();
+
+      /* refits the leaves of primitives using modified vertices, returns false if a full refit is required */
+      bool refit_partial(std::true_type);
+      bool refit_partial(std::false_type) { return false; }
+
     private:
       BVH* bvh;
       std::unique_ptr<Builder> builder;
       std::unique_ptr<BVHNRefitter<N>> refitter;
       Mesh* mesh;
       unsigned int topologyVersion;
+      float buildSAH;                    //!< SAH cost of the BVH directly after the build
+      vector<unsigned> vertexPrimOffsets; //!< offsets of the primitives using a vertex into vertexPrims
+      vector<unsigned> vertexPrims;       //!< primitives using each vertex
+      vector<unsigned> primLeaves;        //!< leaf containing each primitive
+      vector<unsigned> leafEpochs;        //!< refit in which a leaf got last gathered
     };
   }
 }
@@ -31,7 +31,7 @@ namespace embree
   {
     std::ostringstream stream;
     stream.setf(std::ios::fixed, std::ios::floatfield);
-    stream << "  primitives = " << bvh->numPrimitives << ", vertices = " << bvh->numVertices << ", depth = " << stat.depth << std::endl;
+    stream << "  primitives = " << bvh->numPrimitives << ", references = " << numReferences() << ", vertices = " << bvh->numVertices << ", depth = " << stat.depth << std::endl;
     size_t totalBytes = stat.bytes(bvh);
     double totalSAH = stat.sah(bvh);
     stream << "  total            : sah = "  << std::setw(7) << std::setprecision(3) << totalSAH << " (100.00%), ";
@@ -188,6 +188,10 @@ namespace embree
     return s;
   } 
 
+#if defined(EMBREE_BVH16)
+  template class BVHNStatistics<16>;
+#else
+
 #if defined(__AVX__)
   template class BVHNStatistics<8>;
 #endif
@@ -195,4 +199,6 @@ namespace embree
 #if !defined(__AVX__) || !defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42)
   template class BVHNStatistics<4>;
 #endif
+
+#endif
 }
@@ -203,6 +203,14 @@ namespace embree
             n += stat[i].numLeaves;
           return n;
         }
+
+        size_t numPrims() const
+        {
+          size_t n = 0;
+          for (size_t i=0; i<M; i++)
+            n += stat[i].numPrims;
+          return n;
+        }
         
         double fillRateNom (BVH* bvh) const 
         { 
@@ -357,6 +365,11 @@ namespace embree
       return stat.bytes(bvh);
     }
 
+    /*! number of primitive references stored in leaves, exceeds the number of primitives for spatial splits */
+    size_t numReferences() const {
+      return stat.statLeaf.numPrims();
+    }
+
   private:
     Statistics statistics(NodeRef node, const double A, const BBox1f dt);
 
@@ -367,4 +380,5 @@ namespace embree
 
   typedef BVHNStatistics<4> BVH4Statistics;
   typedef BVHNStatistics<8> BVH8Statistics;
+  typedef BVHNStatistics<16> BVH16Statistics;
 }
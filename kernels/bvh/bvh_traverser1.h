@@ -712,5 +712,95 @@ namespace embree
         }
       }
     };
+
+    /* Specialization for BVH16. */
+#if defined(__AVX512F__)
+    template<int Nx, int types>
+    class BVHNNodeTraverser1Hit<16, Nx, types>
+    {
+      typedef BVH16 BVH;
+      typedef BVH16::NodeRef NodeRef;
+      typedef BVH16::BaseNode BaseNode;
+
+    public:
+      /* Traverses a node with at least one hit child. The sort keys of the hit
+       * children get compressed into the lower lanes, each key stores the child
+       * index in the lowest 4 bits of the (non-negative) distance. */
+      static __forceinline void traverseClosestHit(NodeRef& cur,
+                                                   size_t mask,
+                                                   const vfloat<Nx>& tNear,
+                                                   StackItemT<NodeRef>*& stackPtr,
+                                                   StackItemT<NodeRef>* stackEnd)
+      {
+        assert(mask != 0);
+        const BaseNode* node = cur.baseNode();
+
+        /*! one child is hit, continue with that child */
+        if (likely((mask & (mask-1)) == 0)) {
+          cur = node->child(bsf(mask));
+          cur.prefetch(types);
+          assert(cur != BVH::emptyNode);
+          return;
+        }
+
+        const size_t hits = popcnt(mask);
+        vint16 keys = (asInt(tNear) & vint16(0xfffffff0)) | vint16(step);
+        keys = vint16::compact((int)mask,keys);
+        int sorted[16];
+        vint16::storeu(sorted,keys);
+
+        /*! insertion sort in descending order, thus the closest child ends up last */
+        for (size_t i=1; i<hits; i++) {
+          const int key = sorted[i];
+          size_t j = i;
+          for (; j>0 && sorted[j-1] < key; j--) sorted[j] = sorted[j-1];
+          sorted[j] = key;
+        }
+
+        /*! push all but the closest child and continue with the closest one */
+        for (size_t i=0; i<hits-1; i++) {
+          assert(stackPtr < stackEnd);
+          const size_t r = sorted[i] & 0xf;
+          stackPtr->ptr = node->child(r);
+          stackPtr->dist = ((unsigned int*)&tNear)[r];
+          stackPtr++;
+        }
+        cur = node->child(sorted[hits-1] & 0xf);
+        cur.prefetch(types);
+        assert(cur != BVH::emptyNode);
+      }
+
+      /* Traverses a node with at least one hit child. Optimized for finding any hit (occlusion). */
+      static __forceinline void traverseAnyHit(NodeRef& cur,
+                                               size_t mask,
+                                               const vfloat<Nx>& tNear,
+                                               NodeRef*& stackPtr,
+                                               NodeRef* stackEnd)
+      {
+        const BaseNode* node = cur.baseNode();
+
+        /*! one child is hit, continue with that child */
+        size_t r = bscf(mask);
+        cur = node->child(r);
+        cur.prefetch(types);
+
+        /* simpler in sequence traversal order */
+        assert(cur != BVH::emptyNode);
+        if (likely(mask == 0)) return;
+        assert(stackPtr < stackEnd);
+        *stackPtr = cur; stackPtr++;
+
+        for (; ;)
+        {
+          r = bscf(mask);
+          cur = node->child(r); cur.prefetch(types);
+          assert(cur != BVH::emptyNode);
+          if (likely(mask == 0)) return;
+          assert(stackPtr < stackEnd);
+          *stackPtr = cur; stackPtr++;
+        }
+      }
+    };
+#endif
   }
 }
@@ -0,0 +1,111 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+#include "buffer.h"
+
+namespace embree
+{
+  /*! Stores the vertex motion of all time steps but the first one as
+   *  per-vertex deltas to the first time step, quantized to 16 bits
+   *  relative to the delta bounds of each time step. This reduces
+   *  the memory of each additional time step from 16 to 6 bytes per
+   *  vertex. */
+  class CompressedMotion
+  {
+    /*! marks a vertex that was invalid in the original vertex buffer */
+    static const int16_t INVALID = -32768;
+
+  public:
+
+    CompressedMotion ()
+      : numVertices(0), numTimeSteps(0) {}
+
+    /*! returns true if no motion is stored */
+    __forceinline bool empty() const {
+      return numTimeSteps == 0;
+    }
+
+    /*! returns number of bytes used by the compressed motion */
+    __forceinline size_t bytes() const {
+      return deltas.size()*sizeof(int16_t) + 2*numTimeSteps*sizeof(Vec3fa);
+    }
+
+    /*! releases the compressed motion */
+    void clear()
+    {
+      numVertices = numTimeSteps = 0;
+      center.clear();
+      scale.clear();
+      deltas.clear();
+    }
+
+    /*! compresses time steps 1 to N-1 of the vertex buffers relative to time step 0 */
+    void compress(const vector<APIBuffer<Vec3fa>>& vertices)
+    {
+      numTimeSteps = vertices.size();
+      numVertices = vertices[0].size();
+      center.resize(numTimeSteps);
+      scale.resize(numTimeSteps);
+      deltas.resize(3*numVertices*(numTimeSteps-1));
+      center[0] = scale[0] = Vec3fa(zero);
+
+      for (size_t t=1; t<numTimeSteps; t++)
+      {
+        /* calculate bounds of all valid deltas of this time step */
+        BBox3fa bounds(empty);
+        for (size_t i=0; i<numVertices; i++)
+        {
+          const Vec3fa v0 = vertices[0][i];
+          const Vec3fa v1 = vertices[t][i];
+          if (isvalid(v0) && isvalid(v1)) bounds.extend(v1-v0);
+        }
+        if (bounds.empty()) bounds = BBox3fa(Vec3fa(zero));
+
+        /* quantize deltas symmetrically around the center of the bounds */
+        const Vec3fa c = bounds.center();
+        const Vec3fa h = 0.5f*bounds.size();
+        const Vec3fa s = h*(1.0f/32767.0f);
+        const Vec3fa rs(h.x > 0.0f ? 32767.0f/h.x : 0.0f,
+                        h.y > 0.0f ? 32767.0f/h.y : 0.0f,
+                        h.z > 0.0f ? 32767.0f/h.z : 0.0f);
+        center[t] = c;
+        scale[t] = s;
+
+        int16_t* q = &deltas[3*numVertices*(t-1)];
+        for (size_t i=0; i<numVertices; i++, q+=3)
+        {
+          const Vec3fa v0 = vertices[0][i];
+          const Vec3fa v1 = vertices[t][i];
+          if (unlikely(!isvalid(v1))) {
+            q[0] = q[1] = q[2] = INVALID;
+            continue;
+          }
+          const Vec3fa d = isvalid(v0) ? (v1-v0-c)*rs : Vec3fa(zero);
+          q[0] = (int16_t) clamp(int(floorf(d.x+0.5f)),-32767,32767);
+          q[1] = (int16_t) clamp(int(floorf(d.y+0.5f)),-32767,32767);
+          q[2] = (int16_t) clamp(int(floorf(d.z+0.5f)),-32767,32767);
+        }
+      }
+    }
+
+    /*! decodes the i'th vertex of the itime'th time step from the vertex v0 of the first time step */
+    __forceinline Vec3fa decode(const Vec3fa& v0, size_t i, size_t itime) const
+    {
+      assert(itime > 0 && itime < numTimeSteps);
+      assert(i < numVertices);
+      const int16_t* q = &deltas[3*(numVertices*(itime-1)+i)];
+      if (unlikely(q[0] == INVALID)) return Vec3fa(float(nan));
+      return v0 + center[itime] + Vec3fa(float(q[0]),float(q[1]),float(q[2]))*scale[itime];
+    }
+
+  private:
+    size_t numVertices;      //!< number of vertices per time step
+    size_t numTimeSteps;     //!< number of time steps including the uncompressed first one
+    avector<Vec3fa> center;  //!< center of the delta bounds of each time step
+    avector<Vec3fa> scale;   //!< dequantization scale of each time step
+    vector<int16_t> deltas;  //!< quantized deltas for time steps 1 to N-1
+  };
+}
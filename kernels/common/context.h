@@ -18,6 +18,9 @@
 
 #include "default.h"
 #include "rtcore.h"
+#include "multi_hit.h"
+#include "ray_cone.h"
+#include "occluder_cache.h"
 
 namespace embree
 {
@@ -36,7 +39,7 @@ namespace isa
 
   public:
     __forceinline IntersectContext(Scene* scene, const RTCIntersectContext* user_context)
-      : scene(scene), user(user_context), flags(INPUT_RAY_DATA_AOS), geomID_to_instID(nullptr) {}
+      : scene(scene), user(user_context), flags(INPUT_RAY_DATA_AOS), geomID_to_instID(nullptr), multiHits(nullptr), rayCone(nullptr), occluderCache(nullptr) {}
 
   public:
     Scene* scene;
@@ -45,6 +48,9 @@ namespace isa
     const unsigned* geomID_to_instID; // required for xfm node handling
     unsigned instID; // required for xfm node handling
     unsigned geomID; // required for xfm node handling
+    MultiHit* multiHits; // per ray hit buffers in multi-hit mode, otherwise nullptr
+    RayConeHit* rayCone; // footprint data of the nearest hit when tracing a ray cone, otherwise nullptr
+    OccluderCache* occluderCache; // last occluder of a group of shadow rays, otherwise nullptr
 
     static __forceinline size_t encodeSIMDWidth(const size_t width)
     {
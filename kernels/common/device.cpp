@@ -18,6 +18,7 @@
 
 #include "../bvh/bvh4_factory.h"
 #include "../bvh/bvh8_factory.h"
+#include "../bvh/bvh16_factory.h"
 
 #include "../../common/tasking/taskscheduler.h"
 #include "../../common/sys/alloc.h"
@@ -120,6 +121,10 @@ namespace embree
     bvh8_factory = make_unique(new BVH8Factory(enabled_builder_cpu_features, enabled_cpu_features));
 #endif
 
+#if defined(EMBREE_TARGET_SIMD16)
+    bvh16_factory = make_unique(new BVH16Factory(enabled_builder_cpu_features, enabled_cpu_features));
+#endif
+
     /* setup tasking system */
     initTaskingSystem(numThreads);
 
@@ -54,6 +54,7 @@ namespace isa
 {
   class BVH4Factory;
   class BVH8Factory;
+  class BVH16Factory;
   class InstanceFactory;
 
   class Device : public DeviceInterface, public State, public MemoryMonitorInterface
@@ -115,6 +116,9 @@ namespace isa
 #if defined(__AVX__)
     std::unique_ptr<BVH8Factory> bvh8_factory;
 #endif
+#if defined(EMBREE_TARGET_SIMD16)
+    std::unique_ptr<BVH16Factory> bvh16_factory;
+#endif
     
 #if USE_TASK_ARENA
     std::unique_ptr<tbb::task_arena> arena;
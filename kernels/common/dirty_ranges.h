@@ -0,0 +1,105 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  /*! Item ranges of a buffer that got modified since the last commit. A
+   *  full buffer update invalidates the ranges, and once too many ranges
+   *  got added they are merged into fewer but larger ranges. */
+  struct DirtyRanges
+  {
+    /*! maximal number of ranges tracked before merging */
+    static const size_t MAX_RANGES = 256;
+
+    __forceinline DirtyRanges ()
+      : all(true) {}
+
+    /*! marks all items as modified */
+    __forceinline void setAll() {
+      all = true; ranges.clear();
+    }
+
+    /*! marks no item as modified */
+    __forceinline void clear() {
+      all = false; ranges.clear();
+    }
+
+    /*! returns true if all items have to be considered modified */
+    __forceinline bool isAll() const {
+      return all;
+    }
+
+    /*! returns true if no item got modified */
+    __forceinline bool empty() const {
+      return !all && ranges.empty();
+    }
+
+    /*! marks a range of items as modified */
+    void add(const range<size_t>& r)
+    {
+      if (all || r.empty()) return;
+      ranges.push_back(r);
+      if (ranges.size() > MAX_RANGES)
+        merge(MAX_RANGES/2);
+    }
+
+    /*! sorts the ranges and merges overlapping and adjacent ranges */
+    void normalize()
+    {
+      if (ranges.size() <= 1) return;
+      std::sort(ranges.begin(),ranges.end(),[] (const range<size_t>& a, const range<size_t>& b) { return a.begin() < b.begin(); });
+      size_t j=0;
+      for (size_t i=1; i<ranges.size(); i++) {
+        if (ranges[i].begin() <= ranges[j].end()) ranges[j]._end = max(ranges[j].end(),ranges[i].end());
+        else ranges[++j] = ranges[i];
+      }
+      ranges.resize(j+1);
+    }
+
+    /*! returns true if the item got modified, ranges have to be normalized */
+    __forceinline bool contains(size_t item) const
+    {
+      if (all) return true;
+      size_t lo = 0, hi = ranges.size();
+      while (lo < hi) {
+        const size_t mid = (lo+hi)/2;
+        if (ranges[mid].end() <= item) lo = mid+1;
+        else hi = mid;
+      }
+      return lo < ranges.size() && ranges[lo].begin() <= item;
+    }
+
+    /*! returns the number of modified items, ranges have to be normalized */
+    size_t numItems() const
+    {
+      size_t N = 0;
+      for (const auto& r : ranges) N += r.size();
+      return N;
+    }
+
+  private:
+
+    /*! merges the ranges separated by the smallest gaps until at most maxRanges remain */
+    void merge(size_t maxRanges)
+    {
+      normalize();
+      while (ranges.size() > maxRanges)
+      {
+        size_t best = 0;
+        for (size_t i=1; i+1<ranges.size(); i++)
+          if (ranges[i+1].begin()-ranges[i].end() < ranges[best+1].begin()-ranges[best].end()) best = i;
+        ranges[best]._end = ranges[best+1].end();
+        for (size_t i=best+1; i+1<ranges.size(); i++) ranges[i] = ranges[i+1];
+        ranges.resize(ranges.size()-1);
+      }
+    }
+
+  public:
+    vector<range<size_t>> ranges; //!< modified item ranges
+    bool all;                     //!< true if all items are considered modified
+  };
+}
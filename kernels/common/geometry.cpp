@@ -52,6 +52,7 @@ namespace embree
       quality(RTC_BUILD_QUALITY_MEDIUM),
       state((unsigned)State::MODIFIED),
       enabled(true),
+      modCounter_(1),
       argumentFilterEnabled(false),
       intersectionFilterN(nullptr), occlusionFilterN(nullptr), pointQueryFunc(nullptr)
   {
@@ -112,6 +113,7 @@ namespace embree
   {
     ++modCounter_; // FIXME: required?
     state = (unsigned)State::MODIFIED;
+    dirtyVertices.setAll();
   }
   
   void Geometry::commit() 
@@ -128,6 +130,7 @@ namespace embree
 
   void Geometry::postCommit()
   {
+    dirtyVertices.clear();
   }
 
   void Geometry::enable () 
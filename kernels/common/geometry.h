@@ -17,6 +17,7 @@
 #pragma once
 
 #include "default.h"
+#include "dirty_ranges.h"
 #include "../builders/priminfo.h"
 
 namespace embree
@@ -49,6 +50,103 @@ namespace embree
     return make_range(itime_lower, itime_upper);
   }
 
+  /* calculate time segment itime and fractional time ftime for non-uniformly spaced time steps */
+  __forceinline int getTimeSegment(float time, const float* times, size_t numTimeSegments, float& ftime)
+  {
+    const float* upper = std::upper_bound(times+1, times+numTimeSegments, time);
+    const int itime = int(upper-times)-1;
+    ftime = (time-times[itime])/(times[itime+1]-times[itime]);
+    return itime;
+  }
+
+  /* calculate overlapping time segment range for non-uniformly spaced time steps */
+  __forceinline range<int> getTimeSegmentRange(const BBox1f& time_range, const float* times, size_t numTimeSegments)
+  {
+    const int itime_lower = int(std::upper_bound(times, times+numTimeSegments+1, time_range.lower)-times)-1;
+    const int itime_upper = int(std::lower_bound(times, times+numTimeSegments+1, time_range.upper)-times);
+    return make_range(max(itime_lower,0), min(itime_upper,int(numTimeSegments)));
+  }
+
+  /*! instances translated at least this far from the world origin transform rays relative to their origin */
+  static const int INSTANCE_REBASE_DISTANCE = 1 << 16;
+
+  /*! transforms a ray origin or query point into the local space of an
+   *  instance. Instances whose origin at the time of the ray is far away
+   *  from the world origin first subtract that origin, which avoids adding
+   *  the large, nearly cancelling terms of xfmPoint. The difference is exact
+   *  for points within a factor of two of the origin and the linear part of
+   *  the transform then rounds once more, thus the result is not as exact
+   *  as a double precision transform but keeps the error relative to the
+   *  distance from the instance origin. */
+  template<typename Space>
+  __forceinline Vec3fa xfmInstanceOrigin(const Space& world2local, const Vec3fa& origin, const Vec3fa& org)
+  {
+    if (unlikely(reduce_max(abs(origin)) >= float(INSTANCE_REBASE_DISTANCE))) return xfmVector(world2local,org-origin);
+    return xfmPoint(world2local,org);
+  }
+
+  template<typename Space, int K>
+  __forceinline Vec3vf<K> xfmInstanceOrigin(const Space& world2local, const Vec3vf<K>& origin, const Vec3vf<K>& org)
+  {
+    const vbool<K> rebase = reduce_max(abs(origin)) >= vfloat<K>(float(INSTANCE_REBASE_DISTANCE));
+    if (likely(none(rebase))) return xfmPoint(world2local,org);
+    return select(rebase,xfmVector(world2local,org-origin),xfmPoint(world2local,org));
+  }
+
+  /*! Built-in filters evaluated directly by the leaf intersectors,
+   *  these replace the most common filter callbacks (visibility
+   *  masks and alpha cutouts) without the cost of a function call. */
+  struct BuiltinFilters
+  {
+    BuiltinFilters ()
+      : primMask(nullptr), primMaskStride(0),
+        opacity(nullptr), opacityStride(0), opacityCutoff(0.0f),
+        alphaTexels(nullptr), alphaWidth(0), alphaHeight(0), alphaCutoff(0.0f), texcoordSlot(0),
+        indices(nullptr), indexStride(0), texcoords(nullptr), texcoordStride(0), numPrimVertices(0) {}
+
+    /*! returns true if any built-in filter is enabled */
+    __forceinline bool enabled() const {
+      return primMask || opacity || alphaTexels;
+    }
+
+    /*! returns the visibility mask of some primitive */
+    __forceinline unsigned getPrimMask(size_t primID) const {
+      return *(const unsigned*)(primMask + primID*primMaskStride);
+    }
+
+    /*! returns the opacity of some primitive */
+    __forceinline float getOpacity(size_t primID) const {
+      return *(const float*)(opacity + primID*opacityStride);
+    }
+
+    /*! returns the index of the i'th vertex of some primitive */
+    __forceinline unsigned getVertexIndex(size_t primID, size_t i) const {
+      return ((const unsigned*)(indices + primID*indexStride))[i];
+    }
+
+    /*! returns the texture coordinate of some vertex */
+    __forceinline Vec2f getTexcoord(size_t vtxID) const {
+      const float* st = (const float*)(texcoords + vtxID*texcoordStride);
+      return Vec2f(st[0],st[1]);
+    }
+
+    const char* primMask;             //!< per primitive visibility mask tested against the ray mask
+    size_t primMaskStride;            //!< stride of per primitive visibility masks
+    const char* opacity;              //!< per primitive opacity
+    size_t opacityStride;             //!< stride of per primitive opacities
+    float opacityCutoff;              //!< hits with opacity below cutoff are ignored
+    const unsigned char* alphaTexels; //!< 8 bit alpha texture
+    unsigned alphaWidth;              //!< width of alpha texture
+    unsigned alphaHeight;             //!< height of alpha texture
+    float alphaCutoff;                //!< hits with alpha below cutoff are ignored
+    unsigned texcoordSlot;            //!< user vertex buffer holding the texture coordinates
+    const char* indices;              //!< index buffer of the geometry, set on commit
+    size_t indexStride;               //!< stride of index buffer
+    const char* texcoords;            //!< texture coordinates, set on commit
+    size_t texcoordStride;            //!< stride of texture coordinates
+    unsigned numPrimVertices;         //!< number of vertices per primitive, 3 for triangles and 4 for quads
+  };
+
   /*! Base class all geometries are derived from */
   class Geometry
   {
@@ -106,6 +204,9 @@ namespace embree
     /*! clears modified flag */
     __forceinline void clearModified() { modified = false; }
 
+    /*! returns a counter that changes with every update and commit of the geometry */
+    __forceinline unsigned int getModCounter() const { return modCounter_; }
+
     /*! test if this is a static geometry */
     __forceinline bool isStatic() const { return flags == RTC_GEOMETRY_STATIC; }
 
@@ -118,6 +219,9 @@ namespace embree
     /*! returns geometry type */
     __forceinline Type getType() const { return type; }
 
+    /*! tests if the i'th primitive may have changed since the last commit, geometries tracking modified ranges hide this function */
+    __forceinline bool primitiveModified(size_t i) const { return true; }
+
     /*! returns number of primitives */
     __forceinline size_t size() const { return numPrimitives; }
 
@@ -143,6 +247,21 @@ namespace embree
     virtual void updateBuffer (RTCBufferType type) {
       update(); // update everything for geometries not supporting this call
     }
+
+    /*! Update a range of items of a geometry buffer. */
+    virtual void updateBufferRange (RTCBufferType type, unsigned int slot, const range<size_t>& items) {
+      update(); // update everything for geometries not tracking modified ranges
+    }
+
+    /*! Update a range of bytes of a geometry buffer. */
+    virtual void updateBufferByteRange (RTCBufferType type, unsigned int slot, const range<size_t>& bytes) {
+      update(); // update everything for geometries not tracking modified ranges
+    }
+
+    /*! returns the range of items overlapping a range of bytes of a buffer */
+    static __forceinline range<size_t> itemRange(const range<size_t>& bytes, size_t stride) {
+      return range<size_t>(bytes.begin()/stride,(bytes.end()+stride-1)/stride);
+    }
     
     /*! Disable geometry. */
     virtual void disable ();
@@ -347,11 +466,92 @@ namespace embree
       throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! Sets the times of the time steps for non-uniformly spaced motion blur keys. */
+    virtual void setTimeSteps (const float* times, size_t numTimes) { 
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
+    /*! Enables compressed storage of the vertex motion. */
+    virtual void setMotionCompression (bool enable) { 
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
+    /*! Sets a per primitive visibility mask that gets tested against the ray mask. */
+    virtual void setPrimitiveMaskBuffer (const unsigned* masks, size_t stride) { 
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
+    /*! Sets a per primitive opacity, hits of primitives with opacity below the cutoff are ignored. */
+    virtual void setPrimitiveOpacityBuffer (const float* opacity, size_t stride, float cutoff) { 
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
+    /*! Sets an 8 bit alpha texture, hits with texture alpha below the cutoff are ignored. */
+    virtual void setAlphaTexture (const unsigned char* texels, unsigned width, unsigned height, unsigned texcoordSlot, float cutoff) { 
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
+    /*! Sets the format of the vertex buffer of some slot, only geometries supporting compact vertices accept half and quantized formats. */
+    virtual void setVertexFormat (RTCFormat format, unsigned int slot) 
+    {
+      if (format == RTC_FORMAT_HALF3 || format == RTC_FORMAT_USHORT3)
+        throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
+    /*! Sets the bounds quantized 16 bit vertices are relative to. */
+    virtual void setQuantizationBounds (const BBox3fa& bounds) { 
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
+    /*! Sets the distances at which instances switch to the next level of detail. */
+    virtual void setInstanceLODs (const float* distances, size_t numDistances, float blendWidth) { 
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! returns number of time segments */
     __forceinline unsigned numTimeSegments () const {
       return numTimeSteps-1;
     }
 
+    /*! returns true if the time steps are uniformly spaced */
+    __forceinline bool hasUniformTimeSteps () const {
+      return timeSteps.size() == 0;
+    }
+
+    /*! returns the time of the itime'th time step */
+    __forceinline float timeStep (size_t itime) const 
+    {
+      if (likely(hasUniformTimeSteps())) return float(itime)/fnumTimeSegments;
+      return timeSteps[itime];
+    }
+
+    /*! calculates time segment itime and fractional time ftime */
+    __forceinline int timeSegment (float time, float& ftime) const
+    {
+      if (likely(hasUniformTimeSteps())) return getTimeSegment(time, fnumTimeSegments, ftime);
+      return getTimeSegment(time, timeSteps.data(), numTimeSegments(), ftime);
+    }
+
+    /*! calculates time segments itime and fractional times ftime */
+    template<int N>
+    __forceinline vint<N> timeSegment (const vfloat<N>& time, vfloat<N>& ftime) const
+    {
+      if (likely(hasUniformTimeSteps())) return getTimeSegment(time, vfloat<N>(fnumTimeSegments), ftime);
+
+      vint<N> itime;
+      for (size_t i=0; i<N; i++) {
+        float f; itime[i] = getTimeSegment(time[i], timeSteps.data(), numTimeSegments(), f); ftime[i] = f;
+      }
+      return itime;
+    }
+
+    /*! calculates the range of time segments overlapping the specified time range */
+    __forceinline range<int> timeSegmentRange (const BBox1f& time_range) const
+    {
+      if (likely(hasUniformTimeSteps())) return getTimeSegmentRange(time_range, fnumTimeSegments);
+      return getTimeSegmentRange(time_range, timeSteps.data(), numTimeSegments());
+    }
+
   public:
     __forceinline bool hasIntersectionFilter1() const { return (hasIntersectionFilterMask & (HAS_FILTER1 | HAS_FILTERN)) != 0;  }
     __forceinline bool hasOcclusionFilter1   () const { return (hasOcclusionFilterMask    & (HAS_FILTER1 | HAS_FILTERN)) != 0; }
@@ -361,6 +561,9 @@ namespace embree
     template<typename simd> __forceinline bool hasISPCIntersectionFilter() const;
     template<typename simd> __forceinline bool hasISPCOcclusionFilter() const;
 
+    /*! returns true if any built-in filter is enabled */
+    __forceinline bool hasBuiltinFilters() const { return builtinFilters.enabled(); }
+
   public:
     Scene* scene;              //!< pointer to scene this mesh belongs to
     unsigned geomID;           //!< internal geometry ID
@@ -369,9 +572,12 @@ namespace embree
     bool numPrimitivesChanged; //!< true if number of primitives changed
     unsigned numTimeSteps;     //!< number of time steps
     float fnumTimeSegments;    //!< number of time segments (precalculation)
+    vector<float> timeSteps;   //!< times of the time steps, empty for uniformly spaced time steps
+    DirtyRanges dirtyVertices; //!< vertices modified since the last commit
     RTCGeometryFlags flags;    //!< flags of geometry
     bool enabled;              //!< true if geometry is enabled
     bool modified;             //!< true if geometry is modified
+    std::atomic<unsigned int> modCounter_; //!< counter for every modification, used to detect modified geometries between builds
     void* userPtr;             //!< user pointer
     unsigned mask;             //!< for masking out geometry
     std::atomic<size_t> used;  //!< counts by how many enabled instances this geometry is used
@@ -398,6 +604,9 @@ namespace embree
     int hasOcclusionFilterMask;
     int ispcIntersectionFilterMask;
     int ispcOcclusionFilterMask;
+
+  public:
+    BuiltinFilters builtinFilters; //!< filters evaluated without callback
   };
 
 #if defined(__SSE__)
@@ -0,0 +1,71 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  /*! Collects the nearest hits of a single ray sorted by distance. Once
+   *  the buffer is full, the distance of the farthest hit is used to
+   *  cull the remaining traversal. */
+  struct MultiHit
+  {
+    /*! maximal number of hits that can get collected */
+    static const unsigned MAX_HITS = 16;
+
+    __forceinline MultiHit ()
+      : maxHits(0), numHits(0) {}
+
+    __forceinline MultiHit (unsigned maxHits)
+      : maxHits(min(maxHits,MAX_HITS)), numHits(0) {}
+
+    /*! returns true if the maximal number of hits got collected */
+    __forceinline bool full() const {
+      return numHits == maxHits;
+    }
+
+    /*! returns the distance of the farthest collected hit */
+    __forceinline float farthest() const {
+      return t[numHits-1];
+    }
+
+    /*! inserts a hit, returns false if the hit is not among the nearest hits */
+    __forceinline bool insert(float tt, float uu, float vv, const Vec3fa& Ng, unsigned geomID_i, unsigned primID_i, unsigned instID_i)
+    {
+      if (unlikely(maxHits == 0)) return false;
+      if (full() && tt >= farthest()) return false;
+
+      /* the same primitive may be referenced from multiple leaves */
+      for (unsigned j=0; j<numHits; j++)
+        if (primID[j] == primID_i && geomID[j] == geomID_i && instID[j] == instID_i) return false;
+
+      /* insertion sort, the farthest hit drops out when the buffer is full */
+      if (full()) numHits--;
+      unsigned j = numHits++;
+      for (; j>0 && t[j-1] > tt; j--) {
+        t[j] = t[j-1]; u[j] = u[j-1]; v[j] = v[j-1];
+        Ng_x[j] = Ng_x[j-1]; Ng_y[j] = Ng_y[j-1]; Ng_z[j] = Ng_z[j-1];
+        geomID[j] = geomID[j-1]; primID[j] = primID[j-1]; instID[j] = instID[j-1];
+      }
+      t[j] = tt; u[j] = uu; v[j] = vv;
+      Ng_x[j] = Ng.x; Ng_y[j] = Ng.y; Ng_z[j] = Ng.z;
+      geomID[j] = geomID_i; primID[j] = primID_i; instID[j] = instID_i;
+      return true;
+    }
+
+  public:
+    unsigned maxHits;          //!< number of hits to collect
+    unsigned numHits;          //!< number of hits collected
+    float t[MAX_HITS];         //!< hit distances in ascending order
+    float u[MAX_HITS];
+    float v[MAX_HITS];
+    float Ng_x[MAX_HITS];
+    float Ng_y[MAX_HITS];
+    float Ng_z[MAX_HITS];
+    unsigned geomID[MAX_HITS];
+    unsigned primID[MAX_HITS];
+    unsigned instID[MAX_HITS];
+  };
+}
@@ -0,0 +1,29 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  /*! Caches the leaf of the last occluder of a group of shadow rays.
+   *  Shadow rays from a shading point towards the same light are mostly
+   *  blocked by the same primitives, thus the BVH tests this leaf first
+   *  before traversing. */
+  struct OccluderCache
+  {
+    __forceinline OccluderCache ()
+      : bvh(nullptr), leaf(0), cacheOnly(false) {}
+
+    /*! returns true if a leaf got cached */
+    __forceinline bool valid() const {
+      return bvh != nullptr;
+    }
+
+  public:
+    const void* bvh;  //!< BVH the cached leaf belongs to
+    size_t leaf;      //!< node reference of the leaf of the last occluder
+    bool cacheOnly;   //!< only test the cached leaf without traversing the BVH
+  };
+}
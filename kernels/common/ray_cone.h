@@ -0,0 +1,51 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  /*! Footprint data of the nearest hit of a ray cone. It gets recorded by
+   *  the triangle and quad intersectors as the unnormalized geometry
+   *  normal of the hit triangle, which is the cross product of two of its
+   *  edges and thus twice its area. */
+  struct RayConeHit
+  {
+    __forceinline RayConeHit ()
+      : t(neg_inf), Ng(zero), hasArea(false) {}
+
+    /*! records the unnormalized geometry normal of a hit, the epilogs are
+     *  shared with lines, points and curves which have no triangle area */
+    template<typename Geometry>
+    __forceinline void record(float tt, const Vec3fa& Ng_i, const Geometry* geometry)
+    {
+      t = tt;
+      Ng = Ng_i;
+      hasArea = (geometry->getTypeMask() & (Geometry::MTY_TRIANGLE_MESH | Geometry::MTY_QUAD_MESH | Geometry::MTY_GRID_MESH)) != 0;
+    }
+
+    /*! records the geometry normal of a hit of a primitive without triangle area, e.g. a curve */
+    __forceinline void recordNoArea(float tt, const Vec3fa& Ng_i)
+    {
+      t = tt;
+      Ng = Ng_i;
+      hasArea = false;
+    }
+
+    /*! transforms the geometry normal of a hit at distance tt found inside
+     *  an instance into the space of the parent, scaled such that it stays
+     *  twice the area of the transformed triangle */
+    __forceinline void leaveInstance(float tt, const AffineSpace3fa& local2world)
+    {
+      if (t != tt) return;
+      Ng = abs(det(local2world.l))*xfmNormal(local2world,Ng);
+    }
+
+  public:
+    float t;       //!< hit distance the footprint data got recorded for
+    Vec3fa Ng;     //!< unnormalized geometry normal, zero if unknown
+    bool hasArea;  //!< the length of Ng is twice the area of the hit triangle
+  };
+}
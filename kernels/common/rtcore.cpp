@@ -838,6 +838,434 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  static_assert(MultiHit::MAX_HITS == RTC_MAX_MULTI_HIT_COUNT, "multi-hit buffer size mismatch");
+
+  /*! copies the hits collected for a ray to the API hit buffer */
+  static void storeMultiHit(const MultiHit& src, RTCMultiHit& dst)
+  {
+    dst.hitCount = src.numHits;
+    for (unsigned j=0; j<src.numHits; j++)
+    {
+      RTCHit& hit = dst.hit[j];
+      dst.tfar[j] = src.t[j];
+      hit.Ng_x = src.Ng_x[j];
+      hit.Ng_y = src.Ng_y[j];
+      hit.Ng_z = src.Ng_z[j];
+      hit.u = src.u[j];
+      hit.v = src.v[j];
+      hit.primID = src.primID[j];
+      hit.geomID = src.geomID[j];
+      for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) {
+        hit.instID[l] = l == 0 ? src.instID[j] : RTC_INVALID_GEOMETRY_ID;
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+        hit.instPrimID[l] = RTC_INVALID_GEOMETRY_ID;
+#endif
+      }
+    }
+  }
+
+  /*! stores the nearest collected hit of the i'th ray of a packet in the ray packet */
+  template<typename RTCRayHitN>
+  static void storeNearestHitN(const MultiHit& src, RTCRayHitN& rayhit, size_t i)
+  {
+    if (src.numHits == 0) return;
+    rayhit.ray.tfar[i] = src.t[0];
+    rayhit.hit.Ng_x[i] = src.Ng_x[0];
+    rayhit.hit.Ng_y[i] = src.Ng_y[0];
+    rayhit.hit.Ng_z[i] = src.Ng_z[0];
+    rayhit.hit.u[i] = src.u[0];
+    rayhit.hit.v[i] = src.v[0];
+    rayhit.hit.primID[i] = src.primID[0];
+    rayhit.hit.geomID[i] = src.geomID[0];
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) {
+      rayhit.hit.instID[l][i] = l == 0 ? src.instID[0] : RTC_INVALID_GEOMETRY_ID;
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+      rayhit.hit.instPrimID[l][i] = RTC_INVALID_GEOMETRY_ID;
+#endif
+    }
+  }
+
+  /*! stores the nearest collected hit of a single ray */
+  static void storeNearestHitN(const MultiHit& src, RTCRayHit& rayhit, size_t i)
+  {
+    if (src.numHits == 0) return;
+    rayhit.ray.tfar = src.t[0];
+    rayhit.hit.Ng_x = src.Ng_x[0];
+    rayhit.hit.Ng_y = src.Ng_y[0];
+    rayhit.hit.Ng_z = src.Ng_z[0];
+    rayhit.hit.u = src.u[0];
+    rayhit.hit.v = src.v[0];
+    rayhit.hit.primID = src.primID[0];
+    rayhit.hit.geomID = src.geomID[0];
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) {
+      rayhit.hit.instID[l] = l == 0 ? src.instID[0] : RTC_INVALID_GEOMETRY_ID;
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+      rayhit.hit.instPrimID[l] = RTC_INVALID_GEOMETRY_ID;
+#endif
+    }
+  }
+
+  /*! traces the valid rays of a packet one by one through the single ray intersector */
+  template<int N, typename RayHitN, typename RTCRayHitN>
+  static void intersectRays1(const int* valid, Scene* scene, RTCRayHitN& rayhit, RayQueryContext* context)
+  {
+    MultiHit* buffers = context->multiHits;
+    RayHitN* rayN = (RayHitN*) &rayhit;
+    for (size_t i=0; i<N; i++) {
+      if (valid[i] != -1) continue;
+      RayHit ray1; rayN->get(i,ray1);
+      context->multiHits = buffers ? &buffers[i] : nullptr;
+      scene->intersectors.intersect((RTCRayHit&)ray1,context);
+      rayN->set(i,ray1);
+    }
+    context->multiHits = buffers;
+  }
+
+  /*! traces a single ray or a ray packet, packets fall back to single rays if the scene has no packet intersector */
+  static __forceinline void intersectN(const int* valid, Scene* scene, RTCRayHit& rayhit, RayQueryContext* context) {
+    scene->intersectors.intersect(rayhit,context);
+  }
+
+  static __forceinline void intersectN(const int* valid, Scene* scene, RTCRayHit4& rayhit, RayQueryContext* context)
+  {
+    if (likely(scene->intersectors.intersector4)) scene->intersectors.intersect4(valid,rayhit,context);
+    else intersectRays1<4,RayHit4>(valid,scene,rayhit,context);
+  }
+
+  static __forceinline void intersectN(const int* valid, Scene* scene, RTCRayHit8& rayhit, RayQueryContext* context)
+  {
+    if (likely(scene->intersectors.intersector8)) scene->intersectors.intersect8(valid,rayhit,context);
+    else intersectRays1<8,RayHit8>(valid,scene,rayhit,context);
+  }
+
+  static __forceinline void intersectN(const int* valid, Scene* scene, RTCRayHit16& rayhit, RayQueryContext* context)
+  {
+    if (likely(scene->intersectors.intersector16)) scene->intersectors.intersect16(valid,rayhit,context);
+    else intersectRays1<16,RayHit16>(valid,scene,rayhit,context);
+  }
+
+  /*! checks occlusion of a ray packet, only called if the scene has a packet intersector of that width */
+  static __forceinline void occludedN(const int* valid, Scene* scene, RTCRay4& ray, RayQueryContext* context) {
+    scene->intersectors.occluded4(valid,ray,context);
+  }
+
+  static __forceinline void occludedN(const int* valid, Scene* scene, RTCRay8& ray, RayQueryContext* context) {
+    scene->intersectors.occluded8(valid,ray,context);
+  }
+
+  static __forceinline void occludedN(const int* valid, Scene* scene, RTCRay16& ray, RayQueryContext* context) {
+    scene->intersectors.occluded16(valid,ray,context);
+  }
+
+  /*! collects the nearest hits of each valid ray of a packet, rays are valid if their valid mask is -1 */
+  template<int N, typename RTCRayHitN>
+  static void intersectMultiN(const int* valid, Scene* scene, RTCRayHitN* rayhit, unsigned int maxHitCount, RTCMultiHit* hits, RTCIntersectArguments* args)
+  {
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(scene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (N > 1 && (((size_t)valid) & (4*N-1))) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to packet size");   
+    if (((size_t)rayhit) & max(4*N-1,0x0F)) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to packet size");   
+#endif
+    if (maxHitCount == 0 || maxHitCount > RTC_MAX_MULTI_HIT_COUNT)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid number of hits");
+    STAT(size_t cnt=0; for (size_t i=0; i<N; i++) cnt += valid[i] == -1;);
+    STAT3(normal.travs,cnt,cnt,cnt);
+
+    RTCIntersectArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitIntersectArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+
+    MultiHit buffers[N];
+    for (size_t i=0; i<N; i++)
+      buffers[i] = MultiHit(maxHitCount);
+
+    context.multiHits = buffers;
+    intersectN(valid,scene,*rayhit,&context);
+
+    for (size_t i=0; i<N; i++) {
+      if (valid[i] != -1) continue;
+      storeMultiHit(buffers[i],hits[i]);
+      storeNearestHitN(buffers[i],*rayhit,i);
+    }
+  }
+
+  RTC_API void rtcIntersectMulti1 (RTCScene hscene, RTCRayHit* rayhit, unsigned int maxHitCount, RTCMultiHit* hits, RTCIntersectArguments* args) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersectMulti1);
+    const int valid[1] = { -1 };
+    intersectMultiN<1>(valid,scene,rayhit,maxHitCount,hits,args);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcIntersectMulti4 (const int* valid, RTCScene hscene, RTCRayHit4* rayhit, unsigned int maxHitCount, RTCMultiHit* hits, RTCIntersectArguments* args) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersectMulti4);
+    intersectMultiN<4>(valid,scene,rayhit,maxHitCount,hits,args);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcIntersectMulti8 (const int* valid, RTCScene hscene, RTCRayHit8* rayhit, unsigned int maxHitCount, RTCMultiHit* hits, RTCIntersectArguments* args) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersectMulti8);
+    intersectMultiN<8>(valid,scene,rayhit,maxHitCount,hits,args);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcIntersectMulti16 (const int* valid, RTCScene hscene, RTCRayHit16* rayhit, unsigned int maxHitCount, RTCMultiHit* hits, RTCIntersectArguments* args) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersectMulti16);
+    intersectMultiN<16>(valid,scene,rayhit,maxHitCount,hits,args);
+    RTC_CATCH_END2(scene);
+  }
+
+  /*! traverses the rays of a tile in blocks of up to MAX_INTERNAL_STREAM_SIZE
+   *  rays, each block is compact on screen and traced in SIMD packets */
+  template<typename Ray, typename Func>
+  static void traverseTile(Ray* rays, unsigned int width, unsigned int height, const Func& func)
+  {
+    /* 8x8 pixel blocks for tiles and 64 consecutive rays for ray arrays */
+    const unsigned int blockWidth  = height == 1 ? MAX_INTERNAL_STREAM_SIZE : 8;
+    const unsigned int blockHeight = MAX_INTERNAL_STREAM_SIZE/blockWidth;
+
+    Ray* block[MAX_INTERNAL_STREAM_SIZE];
+    for (unsigned int by=0; by<height; by+=blockHeight)
+    {
+      for (unsigned int bx=0; bx<width; bx+=blockWidth)
+      {
+        size_t N = 0;
+        for (unsigned int y=by; y<min(by+blockHeight,height); y++)
+          for (unsigned int x=bx; x<min(bx+blockWidth,width); x++)
+            block[N++] = &rays[size_t(y)*width+x];
+        func(block,N);
+      }
+    }
+  }
+
+  /*! copies a ray into and out of lane i of a ray packet */
+  template<typename RTCRayN>
+  static __forceinline void setRayN(RTCRayN& dst, size_t i, const RTCRay& src)
+  {
+    dst.org_x[i] = src.org_x; dst.org_y[i] = src.org_y; dst.org_z[i] = src.org_z; dst.tnear[i] = src.tnear;
+    dst.dir_x[i] = src.dir_x; dst.dir_y[i] = src.dir_y; dst.dir_z[i] = src.dir_z; dst.time[i] = src.time;
+    dst.tfar[i] = src.tfar; dst.mask[i] = src.mask; dst.id[i] = src.id; dst.flags[i] = src.flags;
+  }
+
+  /*! copies a hit into and out of lane i of a hit packet */
+  template<typename RTCHitN>
+  static __forceinline void setHitN(RTCHitN& dst, size_t i, const RTCHit& src)
+  {
+    dst.Ng_x[i] = src.Ng_x; dst.Ng_y[i] = src.Ng_y; dst.Ng_z[i] = src.Ng_z;
+    dst.u[i] = src.u; dst.v[i] = src.v;
+    dst.primID[i] = src.primID; dst.geomID[i] = src.geomID;
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) {
+      dst.instID[l][i] = src.instID[l];
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+      dst.instPrimID[l][i] = src.instPrimID[l];
+#endif
+    }
+  }
+
+  template<typename RTCHitN>
+  static __forceinline void getHitN(const RTCHitN& src, size_t i, RTCHit& dst)
+  {
+    dst.Ng_x = src.Ng_x[i]; dst.Ng_y = src.Ng_y[i]; dst.Ng_z = src.Ng_z[i];
+    dst.u = src.u[i]; dst.v = src.v[i];
+    dst.primID = src.primID[i]; dst.geomID = src.geomID[i];
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) {
+      dst.instID[l] = src.instID[l][i];
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+      dst.instPrimID[l] = src.instPrimID[l][i];
+#endif
+    }
+  }
+
+  /*! traces a block of tile rays in packets of K rays, unused lanes repeat the last ray and are disabled */
+  template<int K, typename RTCRayHitK>
+  static void intersectBlockK(Scene* scene, RTCRayHit** block, size_t N, RayQueryContext* context)
+  {
+    for (size_t b=0; b<N; b+=K)
+    {
+      __aligned(64) int valid[K];
+      RTCRayHitK packet;
+      for (size_t i=0; i<K; i++) {
+        const RTCRayHit& rayhit = *block[min(b+i,N-1)];
+        setRayN(packet.ray,i,rayhit.ray);
+        setHitN(packet.hit,i,rayhit.hit);
+        valid[i] = b+i < N ? -1 : 0;
+      }
+      intersectN(valid,scene,packet,context);
+      for (size_t i=0; i<K && b+i<N; i++) {
+        block[b+i]->ray.tfar = packet.ray.tfar[i];
+        getHitN(packet.hit,i,block[b+i]->hit);
+      }
+    }
+  }
+
+  template<int K, typename RTCRayK>
+  static void occludedBlockK(Scene* scene, RTCRay** block, size_t N, RayQueryContext* context)
+  {
+    for (size_t b=0; b<N; b+=K)
+    {
+      __aligned(64) int valid[K];
+      RTCRayK packet;
+      for (size_t i=0; i<K; i++) {
+        setRayN(packet,i,*block[min(b+i,N-1)]);
+        valid[i] = b+i < N ? -1 : 0;
+      }
+      occludedN(valid,scene,packet,context);
+      for (size_t i=0; i<K && b+i<N; i++)
+        block[b+i]->tfar = packet.tfar[i];
+    }
+  }
+
+  /*! traces a block of tile rays in the widest packets the scene supports */
+  static void intersectBlock(Scene* scene, RTCRayHit** block, size_t N, RayQueryContext* context)
+  {
+    if      (scene->intersectors.intersector16) intersectBlockK<16,RTCRayHit16>(scene,block,N,context);
+    else if (scene->intersectors.intersector8 ) intersectBlockK<8, RTCRayHit8 >(scene,block,N,context);
+    else if (scene->intersectors.intersector4 ) intersectBlockK<4, RTCRayHit4 >(scene,block,N,context);
+    else for (size_t i=0; i<N; i++) scene->intersectors.intersect(*block[i],context);
+  }
+
+  static void occludedBlock(Scene* scene, RTCRay** block, size_t N, RayQueryContext* context)
+  {
+    if      (scene->intersectors.intersector16) occludedBlockK<16,RTCRay16>(scene,block,N,context);
+    else if (scene->intersectors.intersector8 ) occludedBlockK<8, RTCRay8 >(scene,block,N,context);
+    else if (scene->intersectors.intersector4 ) occludedBlockK<4, RTCRay4 >(scene,block,N,context);
+    else for (size_t i=0; i<N; i++) scene->intersectors.occluded(*block[i],context);
+  }
+
+  RTC_API void rtcIntersectTile (RTCScene hscene, RTCRayHit* rayhits, unsigned int width, unsigned int height, RTCIntersectArguments* args)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersectTile);
+
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)rayhits) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhits not aligned to 16 bytes");   
+#endif
+    const size_t numRays = size_t(width)*size_t(height);
+    if (numRays == 0 || numRays > RTC_MAX_TILE_RAY_COUNT)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid number of rays in tile");
+    STAT3(normal.travs,numRays,numRays,numRays);
+
+    RTCIntersectArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitIntersectArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+
+    traverseTile(rayhits,width,height,[&] (RTCRayHit** block, size_t N) {
+        intersectBlock(scene,block,N,&context);
+      });
+    RTC_CATCH_END2(scene);
+  }
+
+  /*! finds the geometry of a hit and the transformation from its space to
+   *  world space, returns nullptr for hits inside instance arrays as their
+   *  instanced scene may depend on the level of detail */
+  static Geometry* getHitGeometry(Scene* scene, const RTCHit& hit, float time, AffineSpace3fa& local2world)
+  {
+    local2world = one;
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT && hit.instID[l] != RTC_INVALID_GEOMETRY_ID; l++)
+    {
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+      if (hit.instPrimID[l] != RTC_INVALID_GEOMETRY_ID) return nullptr;
+#endif
+      Instance* instance = scene->get<Instance>(hit.instID[l]);
+      local2world = local2world*instance->getLocal2World(time);
+      scene = instance->object;
+    }
+    return scene->get(hit.geomID);
+  }
+
+  RTC_API void rtcIntersectCone1 (RTCScene hscene, RTCRayHit* rayhit, const RTCRayCone* cone, RTCRayConeHit* footprint, RTCIntersectArguments* args)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersectCone1);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)rayhit) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
+#endif
+    STAT3(normal.travs,1,1,1);
+
+    RTCIntersectArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitIntersectArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+
+    RayConeHit coneHit;
+    context.rayCone = &coneHit;
+    scene->intersectors.intersect(*rayhit,&context);
+    if (rayhit->hit.geomID != RTC_INVALID_GEOMETRY_ID)
+    {
+      /* hits accepted by intersection filter callbacks and hits of user
+       * geometries are not recorded by the intersectors, for these the
+       * returned geometry normal is transformed to world space */
+      if (coneHit.t != rayhit->ray.tfar)
+      {
+        AffineSpace3fa local2world;
+        Geometry* geometry = getHitGeometry(scene,rayhit->hit,rayhit->ray.time,local2world);
+        const Vec3fa Ng(rayhit->hit.Ng_x,rayhit->hit.Ng_y,rayhit->hit.Ng_z);
+        if (geometry)
+          coneHit.record(rayhit->ray.tfar,Ng,geometry);
+        else
+          coneHit.recordNoArea(rayhit->ray.tfar,Vec3fa(zero));
+        coneHit.leaveInstance(rayhit->ray.tfar,local2world);
+      }
+
+      const Vec3fa dir(rayhit->ray.dir_x,rayhit->ray.dir_y,rayhit->ray.dir_z);
+      const float dirLength = length(dir);
+      const float NgLength = length(coneHit.Ng);
+      const float distance = rayhit->ray.tfar*dirLength;
+      footprint->distance = distance;
+      footprint->width = cone->width + distance*cone->spreadAngle;
+      footprint->area = coneHit.hasArea ? 0.5f*NgLength : 0.0f;
+      footprint->cosTheta = NgLength > 0.0f ? abs(dot(dir,coneHit.Ng))/(dirLength*NgLength) : 0.0f;
+    }
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcForwardIntersect16(const int* valid, const RTCIntersectFunctionNArguments* args, RTCScene hscene, RTCRay16* iray, unsigned int instID)
   {
     RTC_TRACE(rtcForwardIntersect16);
@@ -1133,6 +1561,165 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcOccludedTile (RTCScene hscene, RTCRay* rays, unsigned int width, unsigned int height, RTCOccludedArguments* args)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcOccludedTile);
+
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)rays) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rays not aligned to 16 bytes");   
+#endif
+    const size_t numRays = size_t(width)*size_t(height);
+    if (numRays == 0 || numRays > RTC_MAX_TILE_RAY_COUNT)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid number of rays in tile");
+    STAT3(shadow.travs,numRays,numRays,numRays);
+
+    RTCOccludedArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitOccludedArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+
+    traverseTile(rays,width,height,[&] (RTCRay** block, size_t N) {
+        occludedBlock(scene,block,N,&context);
+      });
+    RTC_CATCH_END2(scene);
+  }
+
+  /*! checks occlusion of a batch ray in the internal ray layout, where
+   *  the traversal marks occluded rays by a zero geometry ID */
+  static __forceinline bool occludedBatchRay(Scene* scene, RTCRay& rtcray, RayQueryContext* context)
+  {
+    Ray ray(Vec3fa(rtcray.org_x,rtcray.org_y,rtcray.org_z),Vec3fa(rtcray.dir_x,rtcray.dir_y,rtcray.dir_z),
+            rtcray.tnear,rtcray.tfar,rtcray.time,rtcray.mask);
+    scene->intersectors.occluded((RTCRay&)ray,context);
+    if (ray.geomID != 0) return false;
+    rtcray.tfar = neg_inf;
+    return true;
+  }
+
+  /*! checks occlusion of a block of batch rays in packets of K rays, unused lanes are disabled */
+  template<int K, typename RTCRayK>
+  static void occludedBatchK(Scene* scene, RTCRay** block, size_t N, RayQueryContext* context)
+  {
+    for (size_t b=0; b<N; b+=K)
+    {
+      __aligned(64) int valid[K];
+      RayK<K> packet;
+      for (size_t i=0; i<K; i++)
+      {
+        const RTCRay& ray = *block[min(b+i,N-1)];
+        packet.org.x[i] = ray.org_x; packet.org.y[i] = ray.org_y; packet.org.z[i] = ray.org_z;
+        packet.dir.x[i] = ray.dir_x; packet.dir.y[i] = ray.dir_y; packet.dir.z[i] = ray.dir_z;
+        packet.tnear[i] = ray.tnear; packet.tfar[i] = ray.tfar; packet.time[i] = ray.time; packet.mask[i] = ray.mask;
+        packet.geomID[i] = RTC_INVALID_GEOMETRY_ID;
+        valid[i] = b+i < N ? -1 : 0;
+      }
+      occludedN(valid,scene,(RTCRayK&)packet,context);
+      for (size_t i=0; i<K && b+i<N; i++)
+        if (packet.geomID[i] == 0) block[b+i]->tfar = neg_inf;
+    }
+  }
+
+  static void occludedBatch(Scene* scene, RTCRay** block, size_t N, RayQueryContext* context)
+  {
+    if      (scene->intersectors.intersector16) occludedBatchK<16,RTCRay16>(scene,block,N,context);
+    else if (scene->intersectors.intersector8 ) occludedBatchK<8, RTCRay8 >(scene,block,N,context);
+    else if (scene->intersectors.intersector4 ) occludedBatchK<4, RTCRay4 >(scene,block,N,context);
+    else for (size_t i=0; i<N; i++) occludedBatchRay(scene,*block[i],context);
+  }
+
+  /*! number of rays of a group traced individually to find an occluder to cache */
+  static const size_t MAX_OCCLUDER_PROBES = 4;
+
+  RTC_API void rtcOccludedBatch (RTCScene hscene, RTCRay* rays, const unsigned int* groupOffsets, unsigned int numGroups, RTCOccludedArguments* args)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcOccludedBatch);
+
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)rays) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rays not aligned to 16 bytes");   
+#endif
+    if (numGroups == 0) return;
+    if (groupOffsets == nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid group offsets");
+    for (unsigned int g=0; g<numGroups; g++) {
+      if (groupOffsets[g] > groupOffsets[g+1])
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"group offsets not ascending");
+    }
+    STAT(size_t cnt = groupOffsets[numGroups]-groupOffsets[0]);
+    STAT3(shadow.travs,cnt,cnt,cnt);
+
+    /* the rays of a group share an origin or a light and thus are coherent */
+    RTCOccludedArguments batchArgs;
+    if (unlikely(args == nullptr)) rtcInitOccludedArguments(&batchArgs);
+    else batchArgs = *args;
+    batchArgs.flags = (RTCRayQueryFlags) (batchArgs.flags | RTC_RAY_QUERY_FLAG_COHERENT);
+    RTCRayQueryContext* user_context = batchArgs.context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,&batchArgs);
+
+    RTCRay* block[MAX_INTERNAL_STREAM_SIZE];
+    for (unsigned int g=0; g<numGroups; g++)
+    {
+      /* each group remembers the leaf of its last occluder */
+      OccluderCache cache;
+      context.occluderCache = &cache;
+      size_t numProbes = 0;
+
+      for (size_t i=groupOffsets[g]; i<groupOffsets[g+1]; i+=MAX_INTERNAL_STREAM_SIZE)
+      {
+        const size_t end = min(i+size_t(MAX_INTERNAL_STREAM_SIZE),size_t(groupOffsets[g+1]));
+
+        /* as long as no occluder got cached, the first rays of the group
+         * get traced individually to find one, all later rays test the
+         * cached occluder first, the rays it does not block get collected */
+        size_t N = 0;
+        for (size_t j=i; j<end; j++)
+        {
+          if (!cache.valid() && numProbes < MAX_OCCLUDER_PROBES) {
+            numProbes++;
+            occludedBatchRay(scene,rays[j],&context);
+            continue;
+          }
+          if (cache.valid()) {
+            cache.cacheOnly = true;
+            const bool occluded = occludedBatchRay(scene,rays[j],&context);
+            cache.cacheOnly = false;
+            if (occluded) continue;
+          }
+          block[N++] = &rays[j];
+        }
+        if (N == 0) continue;
+
+        /* the remaining rays get traced in coherent packets without the cache */
+        context.occluderCache = nullptr;
+        occludedBatch(scene,block,N,&context);
+        context.occluderCache = &cache;
+      }
+    }
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcForwardOccluded16(const int* valid, const RTCOccludedFunctionNArguments* args, RTCScene hscene, RTCRay16* iray, unsigned int instID)
   {
     RTC_TRACE(rtcForwardOccluded16);
@@ -1195,6 +1782,19 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryInstanceLODs(RTCGeometry hgeometry, const float* distances, unsigned int numDistances, float blendWidth)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryInstanceLODs);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    if (numDistances && distances == nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid level of detail distances");
+    geometry->setInstanceLODs(distances, numDistances, blendWidth);
+    RTC_CATCH_END2(geometry);
+  }
+
   AffineSpace3fa loadTransform(RTCFormat format, const float* xfm)
   {
     AffineSpace3fa space = one;
@@ -1556,6 +2156,46 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryTimeStepTimes(RTCGeometry hgeometry, const float* times, unsigned int timeStepCount)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryTimeStepTimes);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+
+    if (times && timeStepCount > RTC_MAX_TIME_STEP_COUNT)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"number of time steps is out of range");
+
+    geometry->setTimeSteps(times,timeStepCount);
+    RTC_CATCH_END2(geometry);
+  }
+
+  RTC_API void rtcSetGeometryVertexMotionCompression(RTCGeometry hgeometry, bool enable)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryVertexMotionCompression);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    geometry->setMotionCompression(enable);
+    RTC_CATCH_END2(geometry);
+  }
+
+  RTC_API void rtcSetGeometryVertexQuantizationBounds(RTCGeometry hgeometry, const RTCBounds* bounds)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryVertexQuantizationBounds);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    if (bounds == nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid quantization bounds");
+    geometry->setQuantizationBounds(BBox3fa(Vec3fa(bounds->lower_x,bounds->lower_y,bounds->lower_z),
+                                            Vec3fa(bounds->upper_x,bounds->upper_y,bounds->upper_z)));
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometryVertexAttributeCount(RTCGeometry hgeometry, unsigned int N)
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1658,6 +2298,8 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
     if (itemCount > 0xFFFFFFFFu)
       throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"buffer too large");
     
+    if (type == RTC_BUFFER_TYPE_VERTEX)
+      geometry->setVertexFormat(format,slot);
     geometry->setBuffer(type, slot, format, buffer, byteOffset, byteStride, (unsigned int)itemCount);
     RTC_CATCH_END2(geometry);
   }
@@ -1674,6 +2316,8 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
       throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"buffer too large");
 
     Ref<Buffer> buffer = new Buffer(geometry->device, itemCount*byteStride, (char*)ptr + byteOffset);
+    if (type == RTC_BUFFER_TYPE_VERTEX)
+      geometry->setVertexFormat(format,slot);
     geometry->setBuffer(type, slot, format, buffer, 0, byteStride, (unsigned int)itemCount);
     RTC_CATCH_END2(geometry);
   }
@@ -1695,6 +2339,8 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
       bytes += (16 - (byteStride%16))%16;
       
     Ref<Buffer> buffer = new Buffer(geometry->device, bytes);
+    if (type == RTC_BUFFER_TYPE_VERTEX)
+      geometry->setVertexFormat(format,slot);
     geometry->setBuffer(type, slot, format, buffer, 0, byteStride, (unsigned int)itemCount);
     return buffer->data();
     RTC_CATCH_END2(geometry);
@@ -1735,6 +2381,32 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcUpdateGeometryBufferRange (RTCGeometry hgeometry, RTCBufferType type, unsigned int slot, size_t itemOffset, size_t itemCount) 
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcUpdateGeometryBufferRange);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    if (itemOffset+itemCount < itemOffset)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid buffer range");
+    geometry->updateBufferRange(type, slot, range<size_t>(itemOffset, itemOffset+itemCount));
+    RTC_CATCH_END2(geometry);
+  }
+
+  RTC_API void rtcUpdateGeometryBufferByteRange (RTCGeometry hgeometry, RTCBufferType type, unsigned int slot, size_t byteOffset, size_t byteSize) 
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcUpdateGeometryBufferByteRange);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    if (byteOffset+byteSize < byteOffset)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid buffer range");
+    geometry->updateBufferByteRange(type, slot, range<size_t>(byteOffset, byteOffset+byteSize));
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcDisableGeometry (RTCGeometry hgeometry) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1938,6 +2610,43 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryPrimitiveMaskBuffer (RTCGeometry hgeometry, const unsigned int* masks, size_t byteStride) 
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryPrimitiveMaskBuffer);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    if (masks && byteStride < sizeof(unsigned int))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"stride of primitive mask buffer too small");
+    geometry->setPrimitiveMaskBuffer(masks,byteStride);
+    RTC_CATCH_END2(geometry);
+  }
+
+  RTC_API void rtcSetGeometryPrimitiveOpacityBuffer (RTCGeometry hgeometry, const float* opacities, size_t byteStride, float cutoff) 
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryPrimitiveOpacityBuffer);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    if (opacities && byteStride < sizeof(float))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"stride of primitive opacity buffer too small");
+    geometry->setPrimitiveOpacityBuffer(opacities,byteStride,cutoff);
+    RTC_CATCH_END2(geometry);
+  }
+
+  RTC_API void rtcSetGeometryAlphaTexture (RTCGeometry hgeometry, const unsigned char* texels, unsigned int width, unsigned int height, unsigned int texcoordSlot, float cutoff) 
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryAlphaTexture);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    geometry->setAlphaTexture(texels,width,height,texcoordSlot,cutoff);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcInterpolate(const RTCInterpolateArguments* const args)
   {
     Geometry* geometry = (Geometry*) args->geometry;
@@ -28,6 +28,10 @@
 
 #include "../builders/bvh_builder_sah.h"
 #include "../builders/bvh_builder_morton.h"
+#include "../../common/sys/condition.h"
+#include "../../common/sys/thread.h"
+
+#include <deque>
 
 namespace embree
 { 
@@ -36,14 +40,17 @@ namespace embree
     struct BVH
     {
       BVH (Device* device)
-        : device(device), isStatic(false), allocator(device,true), morton_src(device,0), morton_tmp(device,0) {}
+        : device(device), isStatic(false), isStreaming(false), allocator(device,true), morton_src(device,0), morton_tmp(device,0), flat_nodes(device,0), flat_primIDs(device,0) {}
 
     public:
       Device* device;
       bool isStatic;
+      bool isStreaming;
       FastAllocator allocator;
       mvector<BVHBuilderMorton::BuildPrim> morton_src;
       mvector<BVHBuilderMorton::BuildPrim> morton_tmp;
+      mvector<vfloat4> flat_nodes;
+      mvector<unsigned> flat_primIDs;
     };
 
     RTCORE_API RTCBVH rtcNewBVH(RTCDevice device)
@@ -333,6 +340,8 @@ namespace embree
       /* if we made this BVH static, we can not re-build it anymore  */
       if (bvh->isStatic)
         throw_RTCError(RTC_INVALID_OPERATION,"static BVH cannot get rebuild");
+      if (bvh->isStreaming)
+        throw_RTCError(RTC_INVALID_OPERATION,"BVH is used by a streaming build");
 
       /* initialize the allocator */
       bvh->allocator.init_estimate(numPrimitives*sizeof(BBox3fa));
@@ -356,6 +365,768 @@ namespace embree
       return nullptr;
     }
 
+    /*! Temporary tree the flat BVH builders create through the thread
+     *  local allocator. Leaves are tagged by setting the lowest pointer
+     *  bit and directly store the primIDs of their primitives. */
+    struct FlatBuildNode
+    {
+      static const size_t MAX_BRANCHING_FACTOR = 8;
+
+      size_t numChildren;
+      void* children[MAX_BRANCHING_FACTOR];
+      BBox3fa bounds[MAX_BRANCHING_FACTOR];
+    };
+
+    struct FlatBuildLeaf
+    {
+      static __forceinline void* create(const FastAllocator::CachedAllocator& alloc, size_t numPrims, unsigned*& primIDs_o)
+      {
+        FlatBuildLeaf* leaf = (FlatBuildLeaf*) alloc.malloc0(sizeof(FlatBuildLeaf)+numPrims*sizeof(unsigned),16);
+        leaf->numPrims = numPrims;
+        primIDs_o = leaf->primIDs();
+        return (void*)(size_t(leaf) | 1);
+      }
+
+      static __forceinline bool isLeaf(void* ptr) { return size_t(ptr) & 1; }
+      static __forceinline FlatBuildLeaf* get(void* ptr) { return (FlatBuildLeaf*)(size_t(ptr) & ~size_t(1)); }
+
+      __forceinline unsigned* primIDs() { return (unsigned*)(this+1); }
+
+      size_t numPrims;
+      size_t reserved;
+    };
+
+    /*! quantizes the bounds of one dimension conservatively to 8 bits, like QuantizedBaseNode::init_dim */
+    static void quantizeFlatBVHDim(const float* lower, const float* upper, size_t N, unsigned char* qlower, unsigned char* qupper, float* start, float* scale)
+    {
+      float minF = pos_inf, maxF = neg_inf;
+      for (size_t i=0; i<N; i++) {
+        if (lower[i] == float(pos_inf)) continue;
+        minF = min(minF,lower[i]);
+        maxF = max(maxF,upper[i]);
+      }
+      if (minF > maxF) minF = maxF = 0.0f;
+
+      /* the bounds stay conservative with a margin of a few ulps, whether or not start + q * scale gets decoded with a fused multiply add */
+      const float eps = 4.0f*float(ulp)*max(abs(minF),abs(maxF));
+      const float diff = (1.0f+2.0f*float(ulp))*(maxF - minF) + 2.0f*eps;
+      float decode_scale = diff / 255.0f;
+      if (decode_scale == 0.0f) decode_scale = 2.0f*FLT_MIN;
+      const float encode_scale = diff > 0 ? (255.0f / diff) : 0.0f;
+
+      for (size_t i=0; i<N; i++)
+      {
+        /* empty slots get an inverted range */
+        if (lower[i] == float(pos_inf)) {
+          qlower[i] = 255; qupper[i] = 0;
+          continue;
+        }
+        int ilower = max((int)floorf((lower[i]-minF)*encode_scale),0);
+        int iupper = min((int)ceilf ((upper[i]-minF)*encode_scale),255);
+        if (madd(float(ilower),decode_scale,minF) > lower[i]-eps) ilower = max(ilower-1,0);
+        if (madd(float(iupper),decode_scale,minF) < upper[i]+eps) iupper = min(iupper+1,255);
+        qlower[i] = (unsigned char) ilower;
+        qupper[i] = (unsigned char) iupper;
+      }
+      *start = minF;
+      *scale = decode_scale;
+    }
+
+    /*! returns the size of a flat BVH node */
+    static size_t flatBVHNodeByteStride(RTCFlatBVHNodeLayout layout, size_t N)
+    {
+      if (layout == RTC_FLAT_BVH_NODE_LAYOUT_SOA_QUANTIZED)
+        return alignTo(6*sizeof(float)+6*N*sizeof(unsigned char)+2*N*sizeof(unsigned),16);
+      else
+        return N*sizeof(RTCFlatBVHChild);
+    }
+
+    /*! Writes the temporary tree in depth first order into the output
+     *  arrays. The inner children of a node are stored next to each other
+     *  and the primitives of leaves in the order the leaves are reached. */
+    struct FlatBVHWriter
+    {
+      FlatBVHWriter (BVH* bvh, RTCFlatBVHNodeLayout layout, size_t N)
+        : bvh(bvh), layout(layout), N(N), stride(flatBVHNodeByteStride(layout,N)), nodeCount(0), primCount(0) {}
+
+      __forceinline char* node(size_t nodeID) {
+        return (char*)bvh->flat_nodes.data() + nodeID*stride;
+      }
+
+      void setChild(char* ptr, size_t i, const BBox3fa& bounds, unsigned offset, unsigned count)
+      {
+        if (layout == RTC_FLAT_BVH_NODE_LAYOUT_AOS)
+        {
+          RTCFlatBVHChild& child = ((RTCFlatBVHChild*)ptr)[i];
+          child.lower_x = bounds.lower.x; child.lower_y = bounds.lower.y; child.lower_z = bounds.lower.z;
+          child.upper_x = bounds.upper.x; child.upper_y = bounds.upper.y; child.upper_z = bounds.upper.z;
+          child.offset = offset;
+          child.primitiveCount = count;
+        }
+        else if (layout == RTC_FLAT_BVH_NODE_LAYOUT_SOA)
+        {
+          float* f = (float*) ptr;
+          f[0*N+i] = bounds.lower.x; f[1*N+i] = bounds.upper.x;
+          f[2*N+i] = bounds.lower.y; f[3*N+i] = bounds.upper.y;
+          f[4*N+i] = bounds.lower.z; f[5*N+i] = bounds.upper.z;
+          unsigned* u = (unsigned*)(f+6*N);
+          u[0*N+i] = offset;
+          u[1*N+i] = count;
+        }
+        else
+        {
+          /* float bounds are collected and quantized once all children are known */
+          float* f = tmp_bounds;
+          f[0*N+i] = bounds.lower.x; f[1*N+i] = bounds.upper.x;
+          f[2*N+i] = bounds.lower.y; f[3*N+i] = bounds.upper.y;
+          f[4*N+i] = bounds.lower.z; f[5*N+i] = bounds.upper.z;
+          unsigned* u = (unsigned*)(ptr+6*sizeof(float)+6*N);
+          u[0*N+i] = offset;
+          u[1*N+i] = count;
+        }
+      }
+
+      void finishNode(char* ptr)
+      {
+        if (layout != RTC_FLAT_BVH_NODE_LAYOUT_SOA_QUANTIZED) return;
+        float* start = (float*) ptr;
+        unsigned char* q = (unsigned char*)(start+6);
+        for (size_t dim=0; dim<3; dim++)
+          quantizeFlatBVHDim(tmp_bounds+(2*dim+0)*N,tmp_bounds+(2*dim+1)*N,N,q+(2*dim+0)*N,q+(2*dim+1)*N,start+dim,start+3+dim);
+      }
+
+      unsigned writeLeaf(void* ptr)
+      {
+        FlatBuildLeaf* leaf = FlatBuildLeaf::get(ptr);
+        const size_t offset = primCount;
+        for (size_t i=0; i<leaf->numPrims; i++)
+          bvh->flat_primIDs[primCount++] = leaf->primIDs()[i];
+        return (unsigned) offset;
+      }
+
+      void writeNode(const FlatBuildNode* src, size_t nodeID)
+      {
+        size_t childIDs[FlatBuildNode::MAX_BRANCHING_FACTOR];
+        for (size_t i=0; i<src->numChildren; i++)
+          if (!FlatBuildLeaf::isLeaf(src->children[i])) childIDs[i] = nodeCount++;
+
+        char* ptr = node(nodeID);
+        for (size_t i=0; i<N; i++)
+        {
+          if (i >= src->numChildren)
+            setChild(ptr,i,BBox3fa(empty),RTC_FLAT_BVH_EMPTY_CHILD,0);
+          else if (FlatBuildLeaf::isLeaf(src->children[i]))
+            setChild(ptr,i,src->bounds[i],writeLeaf(src->children[i]),(unsigned)FlatBuildLeaf::get(src->children[i])->numPrims);
+          else
+            setChild(ptr,i,src->bounds[i],(unsigned)childIDs[i],0);
+        }
+        finishNode(ptr);
+
+        for (size_t i=0; i<src->numChildren; i++)
+          if (!FlatBuildLeaf::isLeaf(src->children[i]))
+            writeNode((const FlatBuildNode*)src->children[i],childIDs[i]);
+      }
+
+      void write(void* root, const BBox3fa& bounds, size_t numNodes, size_t numPrims)
+      {
+        /* a root leaf gets wrapped into a node with a single child */
+        FlatBuildNode wrapper;
+        if (FlatBuildLeaf::isLeaf(root)) {
+          wrapper.numChildren = 1;
+          wrapper.children[0] = root;
+          wrapper.bounds[0] = bounds;
+          root = &wrapper;
+          numNodes++;
+        }
+
+        bvh->flat_nodes.resize((numNodes*stride)/sizeof(vfloat4));
+        bvh->flat_primIDs.resize(numPrims);
+        nodeCount = 1;
+        writeNode((const FlatBuildNode*)root,0);
+        assert(nodeCount == numNodes);
+        assert(primCount <= numPrims);
+      }
+
+    public:
+      BVH* bvh;
+      RTCFlatBVHNodeLayout layout;
+      size_t N;
+      size_t stride;
+      size_t nodeCount;
+      size_t primCount;
+      float tmp_bounds[6*FlatBuildNode::MAX_BRANCHING_FACTOR];
+    };
+
+    /*! creates temporary nodes for the different SAH builders */
+    struct FlatBuildCreateNode
+    {
+      FlatBuildCreateNode (std::atomic<size_t>& numNodes)
+        : numNodes(numNodes) {}
+
+      template<typename BuildRecord>
+      __forceinline void* operator() (BuildRecord* children, const size_t N, const FastAllocator::CachedAllocator& alloc) const
+      {
+        numNodes++;
+        FlatBuildNode* node = (FlatBuildNode*) alloc.malloc0(sizeof(FlatBuildNode),16);
+        node->numChildren = N;
+        for (size_t i=0; i<N; i++) node->bounds[i] = children[i].prims.geomBounds;
+        return node;
+      }
+
+      std::atomic<size_t>& numNodes;
+    };
+
+    /*! links temporary nodes to their children for the different SAH builders */
+    struct FlatBuildUpdateNode
+    {
+      template<typename BuildRecord>
+      __forceinline void* operator() (const BuildRecord& precord, const BuildRecord* crecords, void* node, void** children, const size_t N) const
+      {
+        FlatBuildNode* fnode = (FlatBuildNode*) node;
+        for (size_t i=0; i<N; i++) fnode->children[i] = children[i];
+        return node;
+      }
+    };
+
+    /*! Forwards the progress of a flat BVH build to the application as the
+     *  fraction of processed primitives, and cancels the build on request. */
+    struct FlatBuildProgress
+    {
+      FlatBuildProgress (const RTCBuildArguments* args)
+        : buildProgress(args->buildProgress), userPtr(args->userPtr), numPrimitives(args->primitiveCount), processed(0) {}
+
+      void operator() (size_t dn)
+      {
+        if (!buildProgress) return;
+        const size_t n = processed.fetch_add(dn)+dn;
+        const double f = std::min(1.0,double(n)/double(max(numPrimitives,size_t(1))));
+        if (!buildProgress(userPtr,f))
+          throw_RTCError(RTC_CANCELLED,"progress monitor forced termination");
+      }
+
+      RTCProgressMonitorFunction buildProgress;
+      void* userPtr;
+      size_t numPrimitives;
+      std::atomic<size_t> processed;
+    };
+
+    /*! converts the build arguments to the settings of the internal builders */
+    static RTCBuildSettings buildSettings(const RTCBuildArguments* args)
+    {
+      RTCBuildSettings settings;
+      settings.size = sizeof(settings);
+      settings.quality = args->buildQuality;
+      settings.maxBranchingFactor = args->maxBranchingFactor;
+      settings.maxDepth = args->maxDepth;
+      settings.sahBlockSize = args->sahBlockSize;
+      settings.minLeafSize = args->minLeafSize;
+      settings.maxLeafSize = args->maxLeafSize;
+      settings.travCost = args->traversalCost;
+      settings.intCost = args->intersectionCost;
+      settings.extraSpace = args->primitiveArrayCapacity > args->primitiveCount ? unsigned(args->primitiveArrayCapacity-args->primitiveCount) : 0;
+      return settings;
+    }
+
+    std::pair<void*,BBox3fa> rtcBuildFlatBVHMorton(BVH* bvh,
+                                                   const RTCBuildSettings& settings,
+                                                   RTCBuildPrimitive* prims_i,
+                                                   size_t numPrimitives,
+                                                   std::atomic<size_t>& numNodes,
+                                                   FlatBuildProgress& progress)
+    {
+      /* initialize temporary arrays for morton builder */
+      PrimRef* prims = (PrimRef*) prims_i;
+      mvector<BVHBuilderMorton::BuildPrim>& morton_src = bvh->morton_src;
+      mvector<BVHBuilderMorton::BuildPrim>& morton_tmp = bvh->morton_tmp;
+      morton_src.resize(numPrimitives);
+      morton_tmp.resize(numPrimitives);
+
+      /* compute centroid bounds */
+      const BBox3fa centBounds = parallel_reduce ( size_t(0), numPrimitives, BBox3fa(empty), [&](const range<size_t>& r) -> BBox3fa {
+
+          BBox3fa bounds(empty);
+          for (size_t i=r.begin(); i<r.end(); i++) 
+            bounds.extend(prims[i].bounds().center2());
+          return bounds;
+        }, BBox3fa::merge);
+      
+      /* compute morton codes */
+      BVHBuilderMorton::MortonCodeMapping mapping(centBounds);
+      parallel_for ( size_t(0), numPrimitives, [&](const range<size_t>& r) {
+          BVHBuilderMorton::MortonCodeGenerator generator(mapping,&morton_src[r.begin()]);
+          for (size_t i=r.begin(); i<r.end(); i++) {
+            generator(prims[i].bounds(),(unsigned) i);
+          }
+        });
+
+      /* start morton build */
+      return BVHBuilderMorton::build<std::pair<void*,BBox3fa>>(
+        
+        /* thread local allocator for fast allocations */
+        [&] () -> FastAllocator::CachedAllocator { 
+          return bvh->allocator.getCachedAllocator();
+        },
+        
+        /* lambda function that allocates BVH nodes */
+        [&] ( const FastAllocator::CachedAllocator& alloc, size_t N ) -> void* {
+          numNodes++;
+          FlatBuildNode* node = (FlatBuildNode*) alloc.malloc0(sizeof(FlatBuildNode),16);
+          node->numChildren = N;
+          return node;
+        },
+        
+        /* lambda function that sets bounds */
+        [&] (void* node, const std::pair<void*,BBox3fa>* children, size_t N) -> std::pair<void*,BBox3fa>
+        {
+          FlatBuildNode* fnode = (FlatBuildNode*) node;
+          BBox3fa bounds = empty;
+          for (size_t i=0; i<N; i++) {
+            bounds.extend(children[i].second);
+            fnode->children[i] = children[i].first;
+            fnode->bounds[i] = children[i].second;
+          }
+          return std::make_pair(node,bounds);
+        },
+        
+        /* lambda function that creates BVH leaves */
+        [&]( const range<unsigned>& current, const FastAllocator::CachedAllocator& alloc) -> std::pair<void*,BBox3fa>
+        {
+          unsigned* primIDs = nullptr;
+          void* leaf = FlatBuildLeaf::create(alloc,current.size(),primIDs);
+          BBox3fa bounds = empty;
+          for (size_t i=current.begin(); i<current.end(); i++) {
+            const PrimRef& prim = prims[morton_src[i].index];
+            bounds.extend(prim.bounds());
+            *primIDs++ = prim.primID();
+          }
+          return std::make_pair(leaf,bounds);
+        },
+        
+        /* lambda that calculates the bounds for some primitive */
+        [&] (const BVHBuilderMorton::BuildPrim& morton) -> BBox3fa {
+          return prims[morton.index].bounds();
+        },
+        
+        /* progress monitor function */
+        [&] (size_t dn) { progress(dn); },
+        
+        morton_src.data(),morton_tmp.data(),numPrimitives,
+        settings);
+    }
+
+    void* rtcBuildFlatBVHSAH(BVH* bvh,
+                             const RTCBuildSettings& settings,
+                             RTCBuildPrimitive* prims,
+                             size_t numPrimitives,
+                             const PrimInfo& pinfo,
+                             std::atomic<size_t>& numNodes,
+                             RTCSplitPrimitiveFunction splitPrimitive,
+                             FlatBuildProgress& progress,
+                             void* userPtr)
+    {
+      FlatBuildCreateNode createNode(numNodes);
+      FlatBuildUpdateNode updateNode;
+
+      /* lambda function that creates BVH leaves */
+      auto createLeaf = [&] (const PrimRef* prims, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> void*
+      {
+        unsigned* primIDs = nullptr;
+        void* leaf = FlatBuildLeaf::create(alloc,range.size(),primIDs);
+        for (size_t i=range.begin(); i<range.end(); i++)
+          *primIDs++ = prims[i].primID();
+        return leaf;
+      };
+
+      /* progress monitor function */
+      auto progressFunc = [&] (size_t dn) { progress(dn); };
+
+      if (splitPrimitive == nullptr || settings.extraSpace == 0 || settings.quality != RTC_BUILD_QUALITY_HIGH)
+      {
+        return BVHBuilderBinnedSAH::build<void*>(
+          [&] () -> FastAllocator::CachedAllocator { return bvh->allocator.getCachedAllocator(); },
+          createNode,updateNode,createLeaf,progressFunc,
+          (PrimRef*)prims,pinfo,settings);
+      }
+
+      /* function that splits a build primitive */
+      struct Splitter
+      {
+        Splitter (RTCSplitPrimitiveFunction splitPrimitive, unsigned geomID, unsigned primID, void* userPtr)
+          : splitPrimitive(splitPrimitive), geomID(geomID), primID(primID), userPtr(userPtr) {}
+        
+        __forceinline void operator() (PrimRef& prim, const size_t dim, const float pos, PrimRef& left_o, PrimRef& right_o) const 
+        {
+          prim.geomIDref() &= BVHBuilderBinnedFastSpatialSAH::GEOMID_MASK;
+          splitPrimitive((const RTCBuildPrimitive*)&prim,(unsigned)dim,pos,(RTCBounds*)&left_o,(RTCBounds*)&right_o,userPtr);
+          left_o.geomIDref()  = geomID; left_o.primIDref()  = primID;
+          right_o.geomIDref() = geomID; right_o.primIDref() = primID;
+        }
+
+        __forceinline void operator() (const BBox3fa& box, const size_t dim, const float pos, BBox3fa& left_o, BBox3fa& right_o) const 
+        {
+          PrimRef prim(box,geomID & BVHBuilderBinnedFastSpatialSAH::GEOMID_MASK,primID);
+          splitPrimitive((const RTCBuildPrimitive*)&prim,(unsigned)dim,pos,(RTCBounds*)&left_o,(RTCBounds*)&right_o,userPtr);
+        }
+   
+        RTCSplitPrimitiveFunction splitPrimitive;
+        unsigned geomID;
+        unsigned primID;
+        void* userPtr;
+      };
+
+      return BVHBuilderBinnedFastSpatialSAH::build<void*>(
+        [&] () -> FastAllocator::CachedAllocator { return bvh->allocator.getCachedAllocator(); },
+        createNode,updateNode,createLeaf,
+        [&] ( const PrimRef& prim ) -> Splitter {
+          return Splitter(splitPrimitive,prim.geomID(),prim.primID(),userPtr);
+        },
+        progressFunc,
+        (PrimRef*)prims,
+        pinfo.size()+settings.extraSpace,
+        pinfo,settings);
+    }
+
+    RTCORE_API void rtcBuildFlatBVH(const RTCBuildArguments* args,
+                                    RTCFlatBVHNodeLayout layout,
+                                    RTCFlatBVH* flatBVH)
+    {
+      BVH* bvh = args ? (BVH*) args->bvh : nullptr;
+      RTCORE_CATCH_BEGIN;
+      RTCORE_TRACE(rtcBuildFlatBVH);
+      RTCORE_VERIFY_HANDLE(args);
+      RTCORE_VERIFY_HANDLE(bvh);
+      RTCORE_VERIFY_HANDLE(flatBVH);
+
+      const RTCBuildSettings settings = buildSettings(args);
+      RTCBuildPrimitive* prims = args->primitives;
+      const size_t numPrimitives = args->primitiveCount;
+      const RTCSplitPrimitiveFunction splitPrimitive = args->splitPrimitive;
+      FlatBuildProgress progress(args);
+
+      /* if we made this BVH static, we can not re-build it anymore  */
+      if (bvh->isStatic)
+        throw_RTCError(RTC_INVALID_OPERATION,"static BVH cannot get rebuild");
+      if (bvh->isStreaming)
+        throw_RTCError(RTC_INVALID_OPERATION,"BVH is used by a streaming build");
+
+      const size_t N = settings.maxBranchingFactor;
+      if (N != 2 && N != 4 && N != 8)
+        throw_RTCError(RTC_INVALID_ARGUMENT,"flat BVH requires a branching factor of 2, 4, or 8");
+      if (layout != RTC_FLAT_BVH_NODE_LAYOUT_AOS && layout != RTC_FLAT_BVH_NODE_LAYOUT_SOA && layout != RTC_FLAT_BVH_NODE_LAYOUT_SOA_QUANTIZED)
+        throw_RTCError(RTC_INVALID_ARGUMENT,"invalid flat BVH node layout");
+      if (settings.quality != RTC_BUILD_QUALITY_LOW && settings.quality != RTC_BUILD_QUALITY_MEDIUM && settings.quality != RTC_BUILD_QUALITY_HIGH)
+        throw_RTCError(RTC_INVALID_OPERATION,"invalid build quality");
+
+      /* initialize the allocator for the temporary tree */
+      bvh->allocator.init_estimate(numPrimitives*sizeof(BBox3fa));
+      bvh->allocator.reset();
+
+      std::atomic<size_t> numNodes(0);
+      void* root = nullptr;
+      BBox3fa bounds = empty;
+      size_t numPrims = numPrimitives;
+
+      if (numPrimitives == 0)
+      {
+        bvh->flat_nodes.clear();
+        bvh->flat_primIDs.clear();
+      }
+      else if (settings.quality == RTC_BUILD_QUALITY_LOW)
+      {
+        std::pair<void*,BBox3fa> r = rtcBuildFlatBVHMorton(bvh,settings,prims,numPrimitives,numNodes,progress);
+        root = r.first; bounds = r.second;
+      }
+      else
+      {
+        /* calculate priminfo */
+        auto computeBounds = [&](const range<size_t>& r) -> CentGeomBBox3fa
+          {
+            CentGeomBBox3fa bounds(empty);
+            for (size_t j=r.begin(); j<r.end(); j++)
+              bounds.extend((BBox3fa&)prims[j],Leaf::TY_TRIANGLE);
+            return bounds;
+          };
+        const CentGeomBBox3fa cbounds = 
+          parallel_reduce(size_t(0),numPrimitives,size_t(1024),size_t(1024),CentGeomBBox3fa(empty), computeBounds, CentGeomBBox3fa::merge2);
+
+        const PrimInfo pinfo(0,numPrimitives,cbounds);
+        root = rtcBuildFlatBVHSAH(bvh,settings,prims,numPrimitives,pinfo,numNodes,splitPrimitive,progress,args->userPtr);
+        bounds = pinfo.geomBounds;
+
+        /* spatial splits may have duplicated primitives */
+        if (splitPrimitive && settings.quality == RTC_BUILD_QUALITY_HIGH)
+          numPrims += settings.extraSpace;
+      }
+
+      /* write the temporary tree into the flat arrays */
+      FlatBVHWriter writer(bvh,layout,N);
+      if (root) writer.write(root,bounds,numNodes,numPrims);
+      bvh->allocator.cleanup();
+
+      flatBVH->branchingFactor = (unsigned) N;
+      flatBVH->nodeLayout = layout;
+      flatBVH->nodeByteStride = writer.stride;
+      flatBVH->nodeCount = writer.nodeCount;
+      flatBVH->nodes = bvh->flat_nodes.data();
+      flatBVH->primitiveCount = writer.primCount;
+      flatBVH->primitiveIDs = bvh->flat_primIDs.data();
+      flatBVH->bounds = (RTCBounds&) bounds;
+
+      RTCORE_CATCH_END(bvh ? bvh->device : nullptr);
+    }
+
+    /*! Streaming build session. Added chunks of primitives get queued and
+     *  a worker thread builds one subtree per chunk while the application
+     *  produces the next chunk. Finishing the session merges the subtrees
+     *  with an SAH build over their bounds. */
+    struct BVHStream
+    {
+      /*! subtree built over a single chunk */
+      struct Subtree
+      {
+        Subtree (void* root, const BBox3fa& bounds)
+          : root(root), bounds(bounds) {}
+
+        void* root;
+        BBox3fa bounds;
+      };
+
+      BVHStream (BVH* bvh, const RTCBuildArguments* args)
+        : bvh(bvh), settings(buildSettings(args)),
+          createNode((RTCCreateNodeFunc)args->createNode), setNodeChildren((RTCSetNodeChildrenFunc)args->setNodeChildren),
+          setNodeBounds((RTCSetNodeBoundsFunc)args->setNodeBounds), createLeaf((RTCCreateLeafFunc)args->createLeaf),
+          buildProgress(args->buildProgress), userPtr(args->userPtr),
+          numAddedPrimitives(0), numBuiltPrimitives(0), finishing(false), thread(nullptr)
+      {
+        bvh->isStreaming = true;
+        bvh->allocator.reset();
+        thread = createThread((thread_func)threadFunc,this);
+      }
+
+      ~BVHStream ()
+      {
+        if (thread) close();
+        for (size_t i=0; i<chunks.size(); i++) delete chunks[i];
+        bvh->isStreaming = false;
+      }
+
+      /*! queues a copy of the primitives for the worker thread */
+      void add(const RTCBuildPrimitive* prims, size_t numPrimitives)
+      {
+        if (numPrimitives == 0) return;
+        avector<PrimRef>* chunk = new avector<PrimRef>(numPrimitives);
+        memcpy(chunk->data(),prims,numPrimitives*sizeof(PrimRef));
+        
+        Lock<MutexSys> lock(mutex);
+        chunks.push_back(chunk);
+        numAddedPrimitives += numPrimitives;
+        condition.notify_all();
+      }
+
+      Device* device() const {
+        return bvh->device;
+      }
+
+      /*! waits for the worker thread and merges the subtrees */
+      void* finish()
+      {
+        close();
+        if (error) std::rethrow_exception(error);
+        
+        void* root = nullptr;
+        if (subtrees.size() == 1) root = subtrees[0].root;
+        else if (subtrees.size() > 1) root = merge();
+        bvh->allocator.cleanup();
+        return root;
+      }
+
+    private:
+      
+      static void threadFunc(BVHStream* stream) {
+        stream->run();
+      }
+
+      void run()
+      {
+        while (true)
+        {
+          avector<PrimRef>* chunk = nullptr;
+          {
+            Lock<MutexSys> lock(mutex);
+            condition.wait(mutex,[&] () { return !chunks.empty() || finishing; });
+            if (chunks.empty()) return;
+            chunk = chunks.front();
+            chunks.pop_front();
+          }
+
+          /* after an error the remaining chunks only get discarded */
+          if (!error)
+          {
+            try {
+              subtrees.push_back(build(*chunk));
+              progress(chunk->size());
+            } catch (...) {
+              error = std::current_exception();
+            }
+          }
+          delete chunk;
+        }
+      }
+
+      /*! reports the fraction of the primitives added so far that are built */
+      void progress(size_t dn)
+      {
+        if (!buildProgress) return;
+        numBuiltPrimitives += dn;
+        size_t numAdded = 0;
+        {
+          Lock<MutexSys> lock(mutex);
+          numAdded = numAddedPrimitives;
+        }
+        if (!buildProgress(userPtr,double(numBuiltPrimitives)/double(numAdded)))
+          throw_RTCError(RTC_CANCELLED,"progress monitor forced termination");
+      }
+
+      /*! stops the worker thread once all chunks are processed */
+      void close()
+      {
+        {
+          Lock<MutexSys> lock(mutex);
+          finishing = true;
+          condition.notify_all();
+        }
+        join(thread);
+        thread = nullptr;
+      }
+
+      /*! builds the subtree of a chunk, the bounds of the chunk are computed along */
+      Subtree build(avector<PrimRef>& prims)
+      {
+        RTCBuildPrimitive* prims_i = (RTCBuildPrimitive*) prims.data();
+        const size_t numPrimitives = prims.size();
+        const BBox3fa bounds = parallel_reduce(size_t(0),numPrimitives,size_t(1024),BBox3fa(empty), [&](const range<size_t>& r) -> BBox3fa {
+            BBox3fa bounds(empty);
+            for (size_t i=r.begin(); i<r.end(); i++)
+              bounds.extend(prims[i].bounds());
+            return bounds;
+          }, BBox3fa::merge);
+        
+        if (settings.quality == RTC_BUILD_QUALITY_LOW)
+          return Subtree(rtcBuildBVHMorton(bvh,settings,prims_i,numPrimitives,createNode,setNodeChildren,setNodeBounds,createLeaf,nullptr,userPtr),bounds);
+        else
+          return Subtree(rtcBuildBVHBinnedSAH(bvh,settings,prims_i,numPrimitives,createNode,setNodeChildren,setNodeBounds,createLeaf,nullptr,userPtr),bounds);
+      }
+
+      /*! builds the top of the BVH over the subtrees of all chunks */
+      void* merge()
+      {
+        avector<PrimRef> prims(subtrees.size());
+        CentGeomBBox3fa bounds(empty);
+        for (size_t i=0; i<subtrees.size(); i++) {
+          prims[i] = PrimRef(subtrees[i].bounds,0,(unsigned)i);
+          bounds.extend(subtrees[i].bounds,Leaf::TY_TRIANGLE);
+        }
+        const PrimInfo pinfo(0,subtrees.size(),bounds);
+
+        /* each subtree becomes a single leaf of the top */
+        GeneralBVHBuilder::Settings topSettings(settings);
+        topSettings.minLeafSize = topSettings.maxLeafSize = 1;
+        topSettings.logBlockSize = 0;
+        
+        return BVHBuilderBinnedSAH::build<void*>(
+          [&] () -> FastAllocator::CachedAllocator { 
+            return bvh->allocator.getCachedAllocator();
+          },
+          [&] (BVHBuilderBinnedSAH::BuildRecord* children, const size_t N, const FastAllocator::CachedAllocator& alloc) -> void*
+          {
+            void* node = createNode((RTCThreadLocalAllocator)&alloc,N,userPtr);
+            const RTCBounds* cbounds[GeneralBVHBuilder::MAX_BRANCHING_FACTOR];
+            for (size_t i=0; i<N; i++) cbounds[i] = (const RTCBounds*) &children[i].prims.geomBounds;
+            setNodeBounds(node,cbounds,N,userPtr);
+            return node;
+          },
+          [&] (const BVHBuilderBinnedSAH::BuildRecord& precord, const BVHBuilderBinnedSAH::BuildRecord* crecords, void* node, void** children, const size_t N) -> void* {
+            setNodeChildren(node,children,N,userPtr);
+            return node;
+          },
+          [&] (const PrimRef* prims, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> void* {
+            assert(range.size() == 1);
+            return subtrees[prims[range.begin()].primID()].root;
+          },
+          [&] (size_t dn) {},
+          prims.data(),pinfo,topSettings);
+      }
+
+    private:
+      BVH* bvh;
+      RTCBuildSettings settings;
+      RTCCreateNodeFunc createNode;
+      RTCSetNodeChildrenFunc setNodeChildren;
+      RTCSetNodeBoundsFunc setNodeBounds;
+      RTCCreateLeafFunc createLeaf;
+      RTCProgressMonitorFunction buildProgress;  //!< invoked once per built chunk
+      void* userPtr;
+
+      size_t numAddedPrimitives;             //!< protected by the mutex
+      size_t numBuiltPrimitives;             //!< only accessed by the worker thread
+      MutexSys mutex;
+      ConditionSys condition;
+      std::deque<avector<PrimRef>*> chunks;  //!< chunks waiting for their subtree build
+      bool finishing;                        //!< set once no more chunks get added
+      thread_t thread;                       //!< worker thread building the subtrees
+      std::vector<Subtree> subtrees;         //!< only accessed by the worker thread until it got joined
+      std::exception_ptr error;              //!< first error of a subtree build
+    };
+
+    RTCORE_API RTCBVHStream rtcBeginBVHStream(const RTCBuildArguments* args)
+    {
+      BVH* bvh = args ? (BVH*) args->bvh : nullptr;
+      RTCORE_CATCH_BEGIN;
+      RTCORE_TRACE(rtcBeginBVHStream);
+      RTCORE_VERIFY_HANDLE(args);
+      RTCORE_VERIFY_HANDLE(bvh);
+      RTCORE_VERIFY_HANDLE(args->createNode);
+      RTCORE_VERIFY_HANDLE(args->setNodeChildren);
+      RTCORE_VERIFY_HANDLE(args->setNodeBounds);
+      RTCORE_VERIFY_HANDLE(args->createLeaf);
+
+      if (bvh->isStatic)
+        throw_RTCError(RTC_INVALID_OPERATION,"static BVH cannot get rebuild");
+      if (bvh->isStreaming)
+        throw_RTCError(RTC_INVALID_OPERATION,"BVH is already used by a streaming build");
+      if (args->buildQuality != RTC_BUILD_QUALITY_LOW && args->buildQuality != RTC_BUILD_QUALITY_MEDIUM && args->buildQuality != RTC_BUILD_QUALITY_HIGH)
+        throw_RTCError(RTC_INVALID_OPERATION,"invalid build quality");
+
+      return (RTCBVHStream) new BVHStream(bvh,args);
+      RTCORE_CATCH_END(bvh ? bvh->device : nullptr);
+      return nullptr;
+    }
+
+    RTCORE_API void rtcAddBVHStreamPrimitives(RTCBVHStream hstream, const RTCBuildPrimitive* prims, size_t numPrimitives)
+    {
+      BVHStream* stream = (BVHStream*) hstream;
+      RTCORE_CATCH_BEGIN;
+      RTCORE_TRACE(rtcAddBVHStreamPrimitives);
+      RTCORE_VERIFY_HANDLE(hstream);
+      if (numPrimitives) RTCORE_VERIFY_HANDLE(prims);
+      stream->add(prims,numPrimitives);
+      RTCORE_CATCH_END(stream ? stream->device() : nullptr);
+    }
+
+    RTCORE_API void* rtcFinishBVHStream(RTCBVHStream hstream)
+    {
+      BVHStream* stream = (BVHStream*) hstream;
+      Device* device = stream ? stream->device() : nullptr;
+      void* root = nullptr;
+      RTCORE_CATCH_BEGIN;
+      RTCORE_TRACE(rtcFinishBVHStream);
+      RTCORE_VERIFY_HANDLE(hstream);
+      std::unique_ptr<BVHStream> owner(stream);
+      root = stream->finish();
+      RTCORE_CATCH_END(device);
+      return root;
+    }
+
     RTCORE_API void* rtcThreadLocalAlloc(RTCThreadLocalAllocator localAllocator, size_t bytes, size_t align)
     {
       FastAllocator::CachedAllocator* alloc = (FastAllocator::CachedAllocator*) localAllocator;
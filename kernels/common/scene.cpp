@@ -18,6 +18,7 @@
 
 #include "../bvh/bvh4_factory.h"
 #include "../bvh/bvh8_factory.h"
+#include "../bvh/bvh16_factory.h"
  
 namespace embree
 {
@@ -39,7 +40,7 @@ namespace embree
       needQuadIndices(false), needQuadVertices(false), 
       needBezierIndices(false), needBezierVertices(false),
       needLineIndices(false), needLineVertices(false),
-      needSubdivIndices(false), needSubdivVertices(false),
+      needSubdivIndices(false), needSubdivVertices(false), compactVertices(false),
       is_build(false), modified(true),
       progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0), 
       numIntersectionFilters1(0), numIntersectionFilters4(0), numIntersectionFilters8(0), numIntersectionFilters16(0), numIntersectionFiltersN(0)
@@ -163,8 +164,11 @@ namespace embree
 #if defined(EMBREE_GEOMETRY_TRIANGLES)
     if (device->tri_accel == "default") 
     {
+      /* watertight scenes need the vertices of Triangle4v for the watertight test */
+      const bool compact = isCompact() && !isWatertight();
+      const BVHFactory::IntersectVariant robust = isWatertight() ? BVHFactory::IntersectVariant::WATERTIGHT : BVHFactory::IntersectVariant::ROBUST;
       if (isStatic()) {
-        int mode =  2*(int)isCompact() + 1*(int)isRobust(); 
+        int mode =  2*(int)compact + 1*(int)isRobust(); 
         switch (mode) {
         case /*0b00*/ 0: 
 #if defined (EMBREE_TARGET_AVX)
@@ -188,14 +192,14 @@ namespace embree
         case /*0b01*/ 1: 
 #if defined (EMBREE_TARGET_AVX)
           if (device->hasISA(AVX)) 
-            accels.add(device->bvh8_factory->BVH8Triangle4v(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST));
+            accels.add(device->bvh8_factory->BVH8Triangle4v(this,BVHFactory::BuildVariant::STATIC,robust));
           else
 #endif
-            accels.add(device->bvh4_factory->BVH4Triangle4v(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST));
+            accels.add(device->bvh4_factory->BVH4Triangle4v(this,BVHFactory::BuildVariant::STATIC,robust));
 
           break;
-        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST  )); break;
-        case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST)); break;
+        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4c(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST  )); break;
+        case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4c(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST)); break;
         }
       }
       else /* dynamic */
@@ -203,23 +207,23 @@ namespace embree
 #if defined (EMBREE_TARGET_AVX)
           if (device->hasISA(AVX))
 	  {
-            int mode =  2*(int)isCompact() + 1*(int)isRobust();
+            int mode =  2*(int)compact + 1*(int)isRobust();
             switch (mode) {
             case /*0b00*/ 0: accels.add(device->bvh8_factory->BVH8Triangle4 (this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST  )); break;
-            case /*0b01*/ 1: accels.add(device->bvh8_factory->BVH8Triangle4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
-            case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST  )); break;
-            case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
+            case /*0b01*/ 1: accels.add(device->bvh8_factory->BVH8Triangle4v(this,BVHFactory::BuildVariant::DYNAMIC,robust)); break;
+            case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4c(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST  )); break;
+            case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4c(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
             }
           }
           else
 #endif
           {
-            int mode =  2*(int)isCompact() + 1*(int)isRobust();
+            int mode =  2*(int)compact + 1*(int)isRobust();
             switch (mode) {
             case /*0b00*/ 0: accels.add(device->bvh4_factory->BVH4Triangle4 (this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST  )); break;
-            case /*0b01*/ 1: accels.add(device->bvh4_factory->BVH4Triangle4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
-            case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST  )); break;
-            case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
+            case /*0b01*/ 1: accels.add(device->bvh4_factory->BVH4Triangle4v(this,BVHFactory::BuildVariant::DYNAMIC,robust)); break;
+            case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4c(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST  )); break;
+            case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4c(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
             }
           }
       }
@@ -227,7 +231,9 @@ namespace embree
     else if (device->tri_accel == "bvh4.triangle4")       accels.add(device->bvh4_factory->BVH4Triangle4 (this));
     else if (device->tri_accel == "bvh4.triangle4v")      accels.add(device->bvh4_factory->BVH4Triangle4v(this));
     else if (device->tri_accel == "bvh4.triangle4i")      accels.add(device->bvh4_factory->BVH4Triangle4i(this));
+    else if (device->tri_accel == "bvh4.triangle4c")      accels.add(device->bvh4_factory->BVH4Triangle4c(this));
     else if (device->tri_accel == "qbvh4.triangle4i")     accels.add(device->bvh4_factory->BVH4QuantizedTriangle4i(this));
+    else if (device->tri_accel == "bvh4obb.triangle4i")   accels.add(device->bvh4_factory->BVH4OBBTriangle4i(this));
 
 #if defined (EMBREE_TARGET_AVX)
     else if (device->tri_accel == "bvh8.triangle4")       accels.add(device->bvh8_factory->BVH8Triangle4 (this));
@@ -236,6 +242,10 @@ namespace embree
     else if (device->tri_accel == "qbvh8.triangle4i")     accels.add(device->bvh8_factory->BVH8QuantizedTriangle4i(this));
     else if (device->tri_accel == "qbvh8.triangle4")      accels.add(device->bvh8_factory->BVH8QuantizedTriangle4(this));
 #endif
+
+#if defined (EMBREE_TARGET_SIMD16)
+    else if (device->tri_accel == "bvh16.triangle4")      accels.add(device->bvh16_factory->BVH16Triangle4(this));
+#endif
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown triangle acceleration structure "+device->tri_accel);
 #endif
   }
@@ -245,6 +255,7 @@ namespace embree
 #if defined(EMBREE_GEOMETRY_TRIANGLES)
     if (device->tri_accel_mb == "default")
     {
+      /* there is no watertight motion blur triangle test, watertight scenes use the robust intersectors here */
       int mode =  2*(int)isCompact() + 1*(int)isRobust(); 
       
 #if defined (EMBREE_TARGET_AVX)
@@ -316,8 +327,8 @@ namespace embree
             accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST));
           break;
 
-        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Quad4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST)); break;
-        case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Quad4i(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST)); break;
+        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Quad4c(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::FAST)); break;
+        case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Quad4c(this,BVHFactory::BuildVariant::STATIC,BVHFactory::IntersectVariant::ROBUST)); break;
         }
       }
       else /* dynamic */
@@ -329,8 +340,8 @@ namespace embree
             switch (mode) {
             case /*0b00*/ 0: accels.add(device->bvh8_factory->BVH8Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST)); break;
             case /*0b01*/ 1: accels.add(device->bvh8_factory->BVH8Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
-            case /*0b10*/ 2: accels.add(device->bvh8_factory->BVH8Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST)); break;
-            case /*0b11*/ 3: accels.add(device->bvh8_factory->BVH8Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
+            case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Quad4c(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST)); break;
+            case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Quad4c(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
             }
           }
           else
@@ -340,15 +351,17 @@ namespace embree
             switch (mode) {
             case /*0b00*/ 0: accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST)); break;
             case /*0b01*/ 1: accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
-            case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST)); break;
-            case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Quad4v(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
+            case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Quad4c(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::FAST)); break;
+            case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Quad4c(this,BVHFactory::BuildVariant::DYNAMIC,BVHFactory::IntersectVariant::ROBUST)); break;
             }
           }
       }
     }
     else if (device->quad_accel == "bvh4.quad4v")       accels.add(device->bvh4_factory->BVH4Quad4v(this));
     else if (device->quad_accel == "bvh4.quad4i")       accels.add(device->bvh4_factory->BVH4Quad4i(this));
+    else if (device->quad_accel == "bvh4.quad4c")       accels.add(device->bvh4_factory->BVH4Quad4c(this));
     else if (device->quad_accel == "qbvh4.quad4i")      accels.add(device->bvh4_factory->BVH4QuantizedQuad4i(this));
+    else if (device->quad_accel == "bvh4obb.quad4i")    accels.add(device->bvh4_factory->BVH4OBBQuad4i(this));
 
 #if defined (EMBREE_TARGET_AVX)
     else if (device->quad_accel == "bvh8.quad4v")       accels.add(device->bvh8_factory->BVH8Quad4v(this));
@@ -762,11 +775,22 @@ namespace embree
         if (geometries[i]) geometries[i]->preCommit();
       });
 
-    /* select fast code path if no intersection filter is present */
-    accels.select(numIntersectionFiltersN+numIntersectionFilters4,
-                  numIntersectionFiltersN+numIntersectionFilters8,
-                  numIntersectionFiltersN+numIntersectionFilters16,
-                  numIntersectionFiltersN);
+    /* the index based triangle and quad leaves have to decode vertices if some mesh stores them compactly */
+    compactVertices = false;
+    size_t numBuiltinFilters = 0;
+    for (const auto geometry : geometries)
+    {
+      if (geometry == nullptr) continue;
+      if (geometry->getType() == Geometry::TRIANGLE_MESH) compactVertices |= ((TriangleMesh*)geometry)->hasCompactVertices();
+      if (geometry->getType() == Geometry::QUAD_MESH    ) compactVertices |= ((QuadMesh*)    geometry)->hasCompactVertices();
+      if (geometry->isEnabled() && geometry->hasBuiltinFilters()) numBuiltinFilters++;
+    }
+
+    /* select fast code path if no intersection filter is present, the built-in filters are evaluated on the filter path too */
+    accels.select(numBuiltinFilters+numIntersectionFiltersN+numIntersectionFilters4,
+                  numBuiltinFilters+numIntersectionFiltersN+numIntersectionFilters8,
+                  numBuiltinFilters+numIntersectionFiltersN+numIntersectionFilters16,
+                  numBuiltinFilters+numIntersectionFiltersN);
   
     /* build all hierarchies of this scene */
     accels.build();
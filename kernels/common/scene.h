@@ -257,7 +257,8 @@ namespace embree
 
     __forceinline bool isCompact() const { return embree::isCompact(flags); }
     __forceinline bool isCoherent() const { return embree::isCoherent(flags); }
-    __forceinline bool isRobust() const { return embree::isRobust(flags); }
+    __forceinline bool isRobust() const { return embree::isRobust(flags) || embree::isWatertight(flags); }
+    __forceinline bool isWatertight() const { return embree::isWatertight(flags); }
     __forceinline bool isHighQuality() const { return embree::isHighQuality(flags); }
     __forceinline bool isInterpolatable() const { return embree::isInterpolatable(aflags); }
     __forceinline bool isStreamMode() const { return embree::isStreamMode(aflags); }
@@ -295,6 +296,7 @@ namespace embree
     bool needLineVertices;
     bool needSubdivIndices;
     bool needSubdivVertices;
+    bool compactVertices;                         //!< true if some triangle or quad mesh stores half or quantized vertices
     MutexSys buildMutex;
     SpinLock geometriesMutex;
     bool is_build;
@@ -55,15 +55,24 @@ namespace isa
       return world2local0;
     }
 
-    __forceinline AffineSpace3fa getWorld2Local(float t) const 
+    __forceinline AffineSpace3fa getLocal2World(float t) const 
     {
       float ftime;
       const size_t itime = getTimeSegment(t, fnumTimeSegments, ftime);
-      return rcp(lerp(local2world[itime+0],local2world[itime+1],ftime));
+      return lerp(local2world[itime+0],local2world[itime+1],ftime);
+    }
+
+    __forceinline AffineSpace3fa getWorld2Local(float t) const {
+      return rcp(getLocal2World(t));
     }
 
     template<int K>
-      __forceinline AffineSpaceT<LinearSpace3<Vec3<vfloat<K>>>> getWorld2Local(const vbool<K>& valid, const vfloat<K>& t) const
+      __forceinline AffineSpaceT<LinearSpace3<Vec3<vfloat<K>>>> getWorld2Local(const vbool<K>& valid, const vfloat<K>& t) const {
+      return rcp(getLocal2World<K>(valid,t));
+    }
+
+    template<int K>
+      __forceinline AffineSpaceT<LinearSpace3<Vec3<vfloat<K>>>> getLocal2World(const vbool<K>& valid, const vfloat<K>& t) const
     {
       typedef AffineSpaceT<LinearSpace3<Vec3<vfloat<K>>>> AffineSpace3vfK;
       
@@ -74,7 +83,7 @@ namespace isa
       const int itime = itime_k[index];
       const vfloat<K> t0 = vfloat<K>(1.0f)-ftime, t1 = ftime;
       if (likely(all(valid,itime_k == vint<K>(itime)))) {
-        return rcp(t0*AffineSpace3vfK(local2world[itime+0])+t1*AffineSpace3vfK(local2world[itime+1]));
+        return t0*AffineSpace3vfK(local2world[itime+0])+t1*AffineSpace3vfK(local2world[itime+1]);
       } 
       else {
         AffineSpace3vfK space0,space1;
@@ -82,9 +91,15 @@ namespace isa
             space0 = select(valid,AffineSpace3vfK(local2world[itime+0]),space0);
             space1 = select(valid,AffineSpace3vfK(local2world[itime+1]),space1);
           });
-        return rcp(t0*space0+t1*space1);
+        return t0*space0+t1*space1;
       }
     }
+
+    /*! transforms a ray origin or query point into local space, see xfmInstanceOrigin */
+    template<typename Space, typename Vector>
+      __forceinline Vector xfmOrigin(const Space& world2local, const Vector& origin, const Vector& org) const {
+      return xfmInstanceOrigin(world2local,origin,org);
+    }
     
   public:
     Scene* object;                 //!< pointer to instanced acceleration structure
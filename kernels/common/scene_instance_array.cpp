@@ -14,6 +14,7 @@ namespace embree
     object = nullptr;
     objects = nullptr;
     numObjects = 0;
+    lodBlendWidth = 0.0f;
     gsubtype = GTY_SUBTYPE_INSTANCE_LINEAR;
     l2w_buf.resize(numTimeSteps);
     device->memoryMonitor(sizeof(*this), false);
@@ -68,6 +69,19 @@ namespace embree
     Geometry::update();
   }
 
+  void InstanceArray::setInstanceLODs(const float* distances, size_t numDistances, float blendWidth)
+  {
+    for (size_t i=1; i<numDistances; i++)
+      if (distances[i] < distances[i-1])
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "level of detail distances must be ascending");
+    if (!(blendWidth >= 0.0f))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid level of detail blend width");
+
+    lodDistances.assign(distances,distances+numDistances);
+    lodBlendWidth = blendWidth;
+    Geometry::update();
+  }
+
   void InstanceArray::addElementsToCount (GeometryCounts & counts) const 
   {
     if (1 == numTimeSteps) {
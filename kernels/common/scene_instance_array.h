@@ -54,6 +54,7 @@ namespace embree
     virtual void setNumTimeSteps (unsigned int numTimeSteps) override;
     virtual void setInstancedScene(const Ref<Scene>& scene) override;
     virtual void setInstancedScenes(const RTCScene* scenes, size_t numScenes) override;
+    virtual void setInstanceLODs(const float* distances, size_t numDistances, float blendWidth) override;
     virtual AffineSpace3fa getTransform(size_t, float time) override;
     virtual void setMask (unsigned mask) override;
     virtual void build() {}
@@ -68,16 +69,29 @@ namespace embree
         return BBox3fa();
 
       if (unlikely(gsubtype == GTY_SUBTYPE_INSTANCE_QUATERNION))
-        return xfmBounds(quaternionDecompositionToAffineSpace(l2w(i, 0)),getObject(i)->bounds.bounds());
-      return xfmBounds(l2w(i, 0),getObject(i)->bounds.bounds());
+        return xfmBounds(quaternionDecompositionToAffineSpace(l2w(i, 0)),getObjectBounds(i));
+      return xfmBounds(l2w(i, 0),getObjectBounds(i));
     }
 
-    /*! gets the bounds of the instanced scene */
+    /*! gets the bounds of the instanced scene, with levels of detail the
+     *  union of the bounds of every level the instance can select */
+    __forceinline BBox3fa getObjectBounds(size_t i) const
+    {
+      BBox3fa b = getObject(i)->bounds.bounds();
+      for (unsigned int lod=1; lod<=lodDistances.size(); lod++)
+        if (Accel* obj = getObject(i,lod)) b.extend(obj->bounds.bounds());
+      return b;
+    }
+
+    /*! gets the bounds of the instanced scene at some time step, including all levels of detail */
     __forceinline BBox3fa getObjectBounds(size_t i, size_t itime) const {
       if (!valid(i))
         return BBox3fa();
 
-      return getObject(i)->getBounds(timeStep(itime));
+      BBox3fa b = getObject(i)->getBounds(timeStep(itime));
+      for (unsigned int lod=1; lod<=lodDistances.size(); lod++)
+        if (Accel* obj = getObject(i,lod)) b.extend(obj->getBounds(timeStep(itime)));
+      return b;
     }
 
      /*! calculates the bounds of instance */
@@ -174,17 +188,76 @@ namespace embree
     }
 
     template<int K>
-    __forceinline AffineSpace3vf<K> getWorld2Local(size_t i, const vbool<K>& valid, const vfloat<K>& t) const
+    __forceinline AffineSpace3vf<K> getLocal2World(size_t i, const vbool<K>& valid, const vfloat<K>& t) const
     {
       if (unlikely(gsubtype == GTY_SUBTYPE_INSTANCE_QUATERNION))
-        return getWorld2LocalSlerp<K>(i, valid, t);
-      return getWorld2LocalLerp<K>(i, valid, t);
+        return getLocal2WorldSlerp<K>(i, valid, t);
+      return getLocal2WorldLerp<K>(i, valid, t);
+    }
+
+    template<int K>
+    __forceinline AffineSpace3vf<K> getWorld2Local(size_t i, const vbool<K>& valid, const vfloat<K>& t) const {
+      return rcp(getLocal2World<K>(i, valid, t));
+    }
+
+    /*! transforms a ray origin or query point into local space, see xfmInstanceOrigin */
+    __forceinline Vec3fa xfmOrigin(const AffineSpace3fa& world2local, const Vec3fa& origin, const Vec3fa& org) const {
+      return xfmInstanceOrigin(world2local,origin,org);
+    }
+
+    template<int K>
+    __forceinline Vec3vf<K> xfmOrigin(const AffineSpace3vf<K>& world2local, const Vec3vf<K>& origin, const Vec3vf<K>& org) const {
+      return xfmInstanceOrigin(world2local,origin,org);
     }
 
     __forceinline float projectedPrimitiveArea(const size_t i) const {
       return area(bounds(i));
     }
 
+    /*! returns true if the instances select their instanced scene per ray by level of detail */
+    __forceinline bool hasLODs() const {
+      return !lodDistances.empty();
+    }
+
+    /*! returns the level of detail of the i'th instance for some ray origin, ray time, and per ray random value in [0,1) */
+    __forceinline unsigned int getLOD(size_t i, const Vec3fa& org, float t, float u) const
+    {
+      const float d = length(org-Vec3fa(getLocal2World(i,t).p));
+      const float jitter = lodBlendWidth*(u-0.5f);
+      unsigned int lod = 0;
+      while (lod < lodDistances.size() && lodDistances[lod]+jitter <= d) lod++;
+      return lod;
+    }
+
+    template<int K>
+    __forceinline vint<K> getLOD(size_t i, const vbool<K>& valid, const Vec3vf<K>& org, const vfloat<K>& t, const vfloat<K>& u) const
+    {
+      /* the origin of a moving instance is interpolated for the time of each ray */
+      Vec3vf<K> p(Vec3fa(getLocal2World(i).p));
+      if (numTimeSegments() > 0) {
+        for (size_t k=0; k<K; k++) {
+          if (!valid[k]) continue;
+          const Vec3fa pk = Vec3fa(getLocal2World(i,t[k]).p);
+          p.x[k] = pk.x; p.y[k] = pk.y; p.z[k] = pk.z;
+        }
+      }
+      const vfloat<K> d = length(org-p);
+      const vfloat<K> jitter = lodBlendWidth*(u-0.5f);
+      vint<K> lod(zero);
+      for (size_t l=0; l<lodDistances.size(); l++)
+        lod = select(vfloat<K>(lodDistances[l])+jitter <= d, lod+1, lod);
+      return lod;
+    }
+
+    /*! returns the instanced scene of the i'th instance at some level of detail, the
+     *  levels of an instance follow its scene index in the list of instanced scenes */
+    __forceinline Accel* getObject(size_t i, unsigned int lod) const
+    {
+      if (likely(object || lod == 0)) return getObject(i);
+      if (object_ids[i] == (unsigned int)(-1)) return nullptr;
+      return objects[min(object_ids[i]+lod,numObjects-1)];
+    }
+
     inline Accel* getObject(size_t i) const {
       if (object) {
         return object;
@@ -202,7 +275,7 @@ namespace embree
     private:
 
     template<int K>
-    __forceinline AffineSpace3vf<K> getWorld2LocalSlerp(size_t i, const vbool<K>& valid, const vfloat<K>& t) const
+    __forceinline AffineSpace3vf<K> getLocal2WorldSlerp(size_t i, const vbool<K>& valid, const vfloat<K>& t) const
     {
       vfloat<K> ftime;
       const vint<K> itime_k = timeSegment<K>(t, ftime);
@@ -210,9 +283,9 @@ namespace embree
       const size_t index = bsf(movemask(valid));
       const int itime = itime_k[index];
       if (likely(all(valid, itime_k == vint<K>(itime)))) {
-        return rcp(slerp(AffineSpace3vff<K>(l2w(i, itime+0)),
-                         AffineSpace3vff<K>(l2w(i, itime+1)),
-                         ftime));
+        return slerp(AffineSpace3vff<K>(l2w(i, itime+0)),
+                     AffineSpace3vff<K>(l2w(i, itime+1)),
+                     ftime);
       }
       else {
         AffineSpace3vff<K> space0,space1;
@@ -223,12 +296,12 @@ namespace embree
           space0 = select(valid2, AffineSpace3vff<K>(l2w(i, itime+0)), space0);
           space1 = select(valid2, AffineSpace3vff<K>(l2w(i, itime+1)), space1);
         }
-        return rcp(slerp(space0, space1, ftime));
+        return slerp(space0, space1, ftime);
       }
     }
 
     template<int K>
-    __forceinline AffineSpace3vf<K> getWorld2LocalLerp(size_t i, const vbool<K>& valid, const vfloat<K>& t) const
+    __forceinline AffineSpace3vf<K> getLocal2WorldLerp(size_t i, const vbool<K>& valid, const vfloat<K>& t) const
     {
       vfloat<K> ftime;
       const vint<K> itime_k = timeSegment<K>(t, ftime);
@@ -236,9 +309,9 @@ namespace embree
       const size_t index = bsf(movemask(valid));
       const int itime = itime_k[index];
       if (likely(all(valid, itime_k == vint<K>(itime)))) {
-        return rcp(lerp(AffineSpace3vf<K>((AffineSpace3fa)l2w(i, itime+0)),
-                        AffineSpace3vf<K>((AffineSpace3fa)l2w(i, itime+1)),
-                        ftime));
+        return lerp(AffineSpace3vf<K>((AffineSpace3fa)l2w(i, itime+0)),
+                    AffineSpace3vf<K>((AffineSpace3fa)l2w(i, itime+1)),
+                    ftime);
       } else {
         AffineSpace3vf<K> space0,space1;
         vbool<K> valid1 = valid;
@@ -248,7 +321,7 @@ namespace embree
           space0 = select(valid2, AffineSpace3vf<K>((AffineSpace3fa)l2w(i, itime+0)), space0);
           space1 = select(valid2, AffineSpace3vf<K>((AffineSpace3fa)l2w(i, itime+1)), space1);
         }
-        return rcp(lerp(space0, space1, ftime));
+        return lerp(space0, space1, ftime);
       }
     }
 
@@ -308,6 +381,8 @@ namespace embree
     uint32_t numObjects;
     Device::vector<RawBufferView> l2w_buf = device; //!< transformation from local space to world space for each timestep (either normal matrix or quaternion decomposition)
     BufferView<uint32_t> object_ids; //!< array of scene ids per instance array primitive
+    std::vector<float> lodDistances; //!< distances at which instances switch to the next level of detail
+    float lodBlendWidth;             //!< width of the distance range in which levels get selected stochastically
   };
 
   namespace isa
@@ -257,6 +257,7 @@ namespace isa
     holes.setModified(true);
     for (auto& buffer : vertices) buffer.setModified(true); 
     levels.setModified(true);
+    dirtyLevels.setAll();
     edge_creases.setModified(true);
     edge_crease_weights.setModified(true);
     vertex_creases.setModified(true);
@@ -298,8 +299,10 @@ namespace isa
     else if (type == RTC_HOLE_BUFFER)
       holes.setModified(true);
 
-    else if (type == RTC_LEVEL_BUFFER)
+    else if (type == RTC_LEVEL_BUFFER) {
       levels.setModified(true);
+      dirtyLevels.setAll();
+    }
 
     else
       throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type");
@@ -307,6 +310,53 @@ namespace isa
     Geometry::update();
   }
 
+  void SubdivMesh::updateBufferRange (RTCBufferType type, unsigned int slot, const range<size_t>& items)
+  {
+    /* modified levels only require an update of the levels of the affected half edges */
+    if (type == RTC_BUFFER_TYPE_LEVEL && levels)
+    {
+      if (items.end() > levels.size())
+        throw_RTCError(RTC_INVALID_ARGUMENT,"level range out of bounds");
+
+      if (!levels.isModified()) dirtyLevels.clear();
+      dirtyLevels.add(items);
+      levels.setModified(true);
+
+      const DirtyRanges ranges = dirtyVertices;
+      Geometry::update();
+      dirtyVertices = ranges;
+      return;
+    }
+
+    /* modified vertices never change the half edge structure, only the cached patches get invalidated */
+    if (type == RTC_BUFFER_TYPE_VERTEX && slot < numTimeSteps)
+    {
+      if (items.end() > numVertices())
+        throw_RTCError(RTC_INVALID_ARGUMENT,"vertex range out of bounds");
+
+      parent->commitCounterSubdiv++;
+      vertices[slot].setModified(true);
+
+      const DirtyRanges ranges = dirtyVertices;
+      Geometry::update();
+      dirtyVertices = ranges;
+      dirtyVertices.add(items);
+      return;
+    }
+
+    update();
+  }
+
+  void SubdivMesh::updateBufferByteRange (RTCBufferType type, unsigned int slot, const range<size_t>& bytes)
+  {
+    if (type == RTC_BUFFER_TYPE_LEVEL && levels)
+      updateBufferRange(type,slot,itemRange(bytes,levels.getStride()));
+    else if (type == RTC_BUFFER_TYPE_VERTEX && slot < numTimeSteps)
+      updateBufferRange(type,slot,itemRange(bytes,vertices[slot].getStride()));
+    else
+      update();
+  }
+
   void SubdivMesh::setDisplacementFunction (RTCDisplacementFunc func, RTCBounds* bounds) 
   {
     if (parent->isStatic() && parent->isBuild())
@@ -565,6 +615,20 @@ namespace isa
     const bool updateVertexCreases = mesh->topology[0].vertexIndices.isModified() || mesh->vertex_creases.isModified() || mesh->vertex_crease_weights.isModified(); 
     const bool updateLevels = mesh->levels.isModified();
 
+    /* when only some levels changed we just touch the affected half edges */
+    if (updateLevels && !updateEdgeCreases && !updateVertexCreases && !mesh->dirtyLevels.isAll())
+    {
+      for (const auto& dirty : mesh->dirtyLevels.ranges)
+      {
+        parallel_for( dirty.begin(), dirty.end(), size_t(4096), [&](const range<size_t>& r) 
+        {
+          for (size_t i=r.begin(); i!=r.end(); i++)
+            halfEdges[i].edge_level = mesh->getEdgeLevel(i);
+        });
+      }
+      return;
+    }
+
     /* parallel loop over all half edges */
     parallel_for( size_t(0), mesh->numHalfEdges, size_t(4096), [&](const range<size_t>& r) 
     {
@@ -729,6 +793,7 @@ namespace isa
     holes.setModified(false);
     for (auto& buffer : vertices) buffer.setModified(false); 
     levels.setModified(false);
+    dirtyLevels.clear();
     edge_creases.setModified(false);
     edge_crease_weights.setModified(false);
     vertex_creases.setModified(false);
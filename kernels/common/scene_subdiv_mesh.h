@@ -77,6 +77,8 @@ namespace isa
     void unmap(RTCBufferType type);
     void update ();
     void updateBuffer (RTCBufferType type);
+    void updateBufferRange (RTCBufferType type, unsigned int slot, const range<size_t>& items);
+    void updateBufferByteRange (RTCBufferType type, unsigned int slot, const range<size_t>& bytes);
     void setTessellationRate(float N);
     void immutable ();
     bool verify ();
@@ -284,6 +286,7 @@ namespace isa
     /*! subdivision level for each half edge of the vertexIndices buffer */
     APIBuffer<float> levels;
     float tessellationRate;  // constant rate that is used when levels is not set
+    DirtyRanges dirtyLevels; // half edges whose level changed since the last commit
 
     /*! buffer that marks specific faces as holes */
     APIBuffer<unsigned> holes;
@@ -22,7 +22,8 @@ namespace embree
 #if defined(EMBREE_LOWEST_ISA)
 
   TriangleMesh::TriangleMesh (Scene* scene, RTCGeometryFlags flags, size_t numTriangles, size_t numVertices, size_t numTimeSteps)
-    : Geometry(scene,TRIANGLE_MESH,numTriangles,numTimeSteps,flags)
+    : Geometry(scene,TRIANGLE_MESH,numTriangles,numTimeSteps,flags), compressMotion(false), motionBaseModified(false),
+      vertexFormat(VERTEX_FORMAT_FLOAT3), quantLower(zero), quantScale(one), hasQuantBounds(false)
   {
     triangles.init(scene->device,numTriangles,sizeof(Triangle));
     vertices.resize(numTimeSteps);
@@ -73,8 +74,9 @@ namespace embree
        throw_RTCError(RTC_INVALID_OPERATION,"vertex buffer can be at most 16GB large");
 
       vertices[t].set(ptr,offset,stride,size);
-      vertices[t].checkPadding16();
+      if (!hasCompactVertices()) vertices[t].checkPadding16();
       vertices0 = vertices[0];
+      motionBaseModified |= t == 0 && hasCompressedMotion();
     } 
     else if (type >= RTC_USER_VERTEX_BUFFER0 && type < RTC_USER_VERTEX_BUFFER0+RTC_MAX_USER_VERTEX_BUFFERS)
     {
@@ -122,18 +124,94 @@ namespace embree
     else if (type >= RTC_VERTEX_BUFFER0 && type < RTCBufferType(RTC_VERTEX_BUFFER0 + numTimeSteps)) {
       vertices[type - RTC_VERTEX_BUFFER0].unmap(scene->numMappedBuffers);
       vertices0 = vertices[0];
+      motionBaseModified |= type == RTC_VERTEX_BUFFER0 && hasCompressedMotion();
     }
     else {
       throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type"); 
     }
   }
 
+  void TriangleMesh::updateBufferRange(RTCBufferType type, unsigned int slot, const range<size_t>& items)
+  {
+    /* only modified vertices can get refitted selectively */
+    if (type != RTC_BUFFER_TYPE_VERTEX || slot >= numTimeSteps) {
+      Geometry::update();
+      return;
+    }
+
+    if (items.end() > numVertices())
+      throw_RTCError(RTC_INVALID_ARGUMENT,"vertex range out of bounds");
+
+    /* the compressed motion stores deltas to the first time step */
+    motionBaseModified |= slot == 0 && hasCompressedMotion();
+
+    const DirtyRanges ranges = dirtyVertices;
+    Geometry::update();
+    dirtyVertices = ranges;
+    dirtyVertices.add(items);
+  }
+
+  void TriangleMesh::updateBufferByteRange(RTCBufferType type, unsigned int slot, const range<size_t>& bytes)
+  {
+    if (type != RTC_BUFFER_TYPE_VERTEX || slot >= numTimeSteps || !vertices[slot]) {
+      Geometry::update();
+      return;
+    }
+    updateBufferRange(type,slot,itemRange(bytes,vertices[slot].getStride()));
+  }
+
   void TriangleMesh::preCommit () 
   {
     /* verify that stride of all time steps are identical */
     for (size_t t=0; t<numTimeSteps; t++)
+    {
+      if (t && hasCompressedMotion() && !vertices[t]) continue;
       if (vertices[t].getStride() != vertices[0].getStride())
         throw_RTCError(RTC_INVALID_OPERATION,"stride of vertex buffers have to be identical for each time step");
+    }
+
+    /* quantized vertices are only meaningful relative to some bounds */
+    if (vertexFormat == VERTEX_FORMAT_USHORT3 && !hasQuantBounds)
+      throw_RTCError(RTC_INVALID_OPERATION,"quantization bounds have to be set for 16 bit quantized vertices");
+
+    if (compressMotion && hasCompactVertices())
+      throw_RTCError(RTC_INVALID_OPERATION,"motion compression is not supported for half precision or quantized vertices");
+
+    /* compress motion of all time steps but the first, this happens again whenever a vertex buffer got set again */
+    if (compressMotion && numTimeSteps > 1)
+    {
+      bool update = !hasCompressedMotion() || motionBaseModified;
+      for (size_t t=1; t<numTimeSteps; t++)
+        update |= (bool) vertices[t];
+
+      if (update)
+      {
+        for (size_t t=1; t<numTimeSteps; t++)
+          if (!vertices[t]) throw_RTCError(RTC_INVALID_OPERATION,"vertex buffers of all time steps have to be set to compress the motion");
+
+        motion.compress(vertices);
+        motionBaseModified = false;
+
+        /* the uncompressed vertex buffers are not required anymore */
+        for (size_t t=1; t<numTimeSteps; t++) {
+          vertices[t].free();
+          vertices[t] = APIBuffer<Vec3fa>(scene->device,numVertices(),sizeof(Vec3fa));
+        }
+      }
+    }
+
+    /* the alpha texture filter accesses the indices and texture coordinates directly */
+    if (builtinFilters.alphaTexels)
+    {
+      const unsigned slot = builtinFilters.texcoordSlot;
+      if (slot >= userbuffers.size() || !userbuffers[slot])
+        throw_RTCError(RTC_INVALID_OPERATION,"user vertex buffer with texture coordinates for alpha texture not set");
+      builtinFilters.indices = triangles.getPtr();
+      builtinFilters.indexStride = triangles.getStride();
+      builtinFilters.texcoords = userbuffers[slot].getPtr();
+      builtinFilters.texcoordStride = userbuffers[slot].getStride();
+      builtinFilters.numPrimVertices = 3;
+    }
   }
 
   void TriangleMesh::postCommit () 
@@ -144,7 +222,7 @@ namespace embree
 
   void TriangleMesh::immutable () 
   {
-    const bool freeTriangles = !scene->needTriangleIndices;
+    const bool freeTriangles = !scene->needTriangleIndices && !builtinFilters.alphaTexels;
     const bool freeVertices  = !scene->needTriangleVertices;
     if (freeTriangles) triangles.free(); 
     if (freeVertices )
@@ -152,6 +230,113 @@ namespace embree
         buffer.free();
   }
 
+  void TriangleMesh::setTimeSteps (const float* times, size_t numTimes)
+  {
+    if (scene->isStatic() && scene->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    /* passing no times restores uniformly spaced time steps */
+    if (times == nullptr) {
+      timeSteps.clear();
+      Geometry::update();
+      return;
+    }
+
+    if (numTimes != numTimeSteps)
+      throw_RTCError(RTC_INVALID_ARGUMENT,"number of times has to match the number of time steps");
+    if (times[0] != 0.0f || times[numTimes-1] != 1.0f)
+      throw_RTCError(RTC_INVALID_ARGUMENT,"first and last time step have to be at time 0 and 1");
+    for (size_t t=1; t<numTimes; t++)
+      if (!(times[t-1] < times[t]))
+        throw_RTCError(RTC_INVALID_ARGUMENT,"times of time steps have to be strictly increasing");
+
+    timeSteps.resize(numTimes);
+    for (size_t t=0; t<numTimes; t++)
+      timeSteps[t] = times[t];
+
+    Geometry::update();
+  }
+
+  void TriangleMesh::setPrimitiveMaskBuffer (const unsigned* masks, size_t stride)
+  {
+    if (scene->isStatic() && scene->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    builtinFilters.primMask = (const char*) masks;
+    builtinFilters.primMaskStride = stride;
+    Geometry::update();
+  }
+
+  void TriangleMesh::setPrimitiveOpacityBuffer (const float* opacity, size_t stride, float cutoff)
+  {
+    if (scene->isStatic() && scene->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    builtinFilters.opacity = (const char*) opacity;
+    builtinFilters.opacityStride = stride;
+    builtinFilters.opacityCutoff = cutoff;
+    Geometry::update();
+  }
+
+  void TriangleMesh::setAlphaTexture (const unsigned char* texels, unsigned width, unsigned height, unsigned texcoordSlot, float cutoff)
+  {
+    if (scene->isStatic() && scene->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    if (texels && (width == 0 || height == 0))
+      throw_RTCError(RTC_INVALID_ARGUMENT,"invalid alpha texture size");
+
+    builtinFilters.alphaTexels = texels;
+    builtinFilters.alphaWidth = texels ? width : 0;
+    builtinFilters.alphaHeight = texels ? height : 0;
+    builtinFilters.alphaCutoff = cutoff;
+    builtinFilters.texcoordSlot = texcoordSlot;
+    Geometry::update();
+  }
+
+  void TriangleMesh::setVertexFormat (RTCFormat format, unsigned int slot)
+  {
+    if (scene->isStatic() && scene->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    VertexFormat newFormat;
+    if (!getVertexFormat(format,newFormat))
+      throw_RTCError(RTC_INVALID_ARGUMENT,"invalid vertex buffer format");
+
+    /* the vertices of all time steps are decoded the same way */
+    for (size_t t=0; t<numTimeSteps; t++)
+      if (t != slot && vertices[t] && newFormat != vertexFormat)
+        throw_RTCError(RTC_INVALID_OPERATION,"vertex buffers of all time steps have to use the same format");
+
+    vertexFormat = newFormat;
+  }
+
+  void TriangleMesh::setQuantizationBounds (const BBox3fa& bounds)
+  {
+    if (scene->isStatic() && scene->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    if (!isvalid(bounds.lower) || !isvalid(bounds.upper) || bounds.empty())
+      throw_RTCError(RTC_INVALID_ARGUMENT,"invalid quantization bounds");
+
+    quantLower = bounds.lower;
+    quantScale = bounds.size()*(1.0f/65535.0f);
+    hasQuantBounds = true;
+    Geometry::update();
+  }
+
+  void TriangleMesh::setMotionCompression (bool enable)
+  {
+    if (scene->isStatic() && scene->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    if (!enable && hasCompressedMotion())
+      throw_RTCError(RTC_INVALID_OPERATION,"vertex motion is already compressed");
+
+    compressMotion = enable;
+    Geometry::update();
+  }
+
   bool TriangleMesh::verify () 
   {
     /*! verify size of vertex arrays */
@@ -173,9 +358,9 @@ namespace embree
     }
 
     /*! verify vertices */
-    for (const auto& buffer : vertices)
-      for (size_t i=0; i<buffer.size(); i++)
-	if (!isvalid(buffer[i])) 
+    for (size_t t=0; t<numTimeSteps; t++)
+      for (size_t i=0; i<numVertices(); i++)
+	if (!isvalid(vertex(i,t))) 
 	  return false;
 
     return true;
@@ -198,6 +383,8 @@ namespace embree
       src    = userbuffers[buffer&0xFFFF].getPtr();
       stride = userbuffers[buffer&0xFFFF].getStride();
     } else {
+      if (unlikely(hasCompactVertices()))
+        throw_RTCError(RTC_INVALID_OPERATION,"interpolation of half precision or quantized vertices is not supported");
       src    = vertices[buffer&0xFFFF].getPtr();
       stride = vertices[buffer&0xFFFF].getStride();
     }
@@ -18,6 +18,8 @@
 
 #include "geometry.h"
 #include "buffer.h"
+#include "compressed_motion.h"
+#include "vertex_format.h"
 
 namespace embree
 {
@@ -51,10 +53,19 @@ namespace embree
     void setBuffer(RTCBufferType type, void* ptr, size_t offset, size_t stride, size_t size);
     void* map(RTCBufferType type);
     void unmap(RTCBufferType type);
+    void updateBufferRange(RTCBufferType type, unsigned int slot, const range<size_t>& items);
+    void updateBufferByteRange(RTCBufferType type, unsigned int slot, const range<size_t>& bytes);
     void preCommit();
     void postCommit();
     void immutable ();
     bool verify ();
+    void setTimeSteps (const float* times, size_t numTimes);
+    void setMotionCompression (bool enable);
+    void setPrimitiveMaskBuffer (const unsigned* masks, size_t stride);
+    void setPrimitiveOpacityBuffer (const float* opacity, size_t stride, float cutoff);
+    void setAlphaTexture (const unsigned char* texels, unsigned width, unsigned height, unsigned texcoordSlot, float cutoff);
+    void setVertexFormat (RTCFormat format, unsigned int slot);
+    void setQuantizationBounds (const BBox3fa& bounds);
     void interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
     // FIXME: implement interpolateN
 
@@ -77,6 +88,7 @@ namespace embree
 
     /*! returns i'th vertex of the first time step  */
     __forceinline const Vec3fa vertex(size_t i) const {
+      if (unlikely(hasCompactVertices())) return Vec3fa(loadVertex(vertices0.getPtr(i)));
       return vertices0[i];
     }
 
@@ -86,15 +98,53 @@ namespace embree
     }
 
     /*! returns i'th vertex of itime'th timestep */
-    __forceinline const Vec3fa vertex(size_t i, size_t itime) const {
+    __forceinline const Vec3fa vertex(size_t i, size_t itime) const 
+    {
+      if (unlikely(itime && hasCompressedMotion())) return motion.decode(vertices0[i],i,itime);
+      if (unlikely(hasCompactVertices())) return Vec3fa(loadVertex(vertices[itime].getPtr(i)));
       return vertices[itime][i];
     }
 
-    /*! returns i'th vertex of itime'th timestep */
+    /*! returns i'th vertex of itime'th timestep, not available for compressed time steps */
     __forceinline const char* vertexPtr(size_t i, size_t itime) const {
+      assert(itime == 0 || !hasCompressedMotion());
       return vertices[itime].getPtr(i);
     }
 
+    /*! returns i'th vertex linearly interpolated at the specified time */
+    __forceinline const Vec3fa interpolatedVertex(size_t i, float time) const
+    {
+      float ftime; const size_t itime = timeSegment(time, ftime);
+      return lerp(vertex(i,itime+0),vertex(i,itime+1),ftime);
+    }
+
+    /*! returns true if the vertex motion is stored compressed */
+    __forceinline bool hasCompressedMotion() const {
+      return !motion.empty();
+    }
+
+    /*! returns true if the vertices are stored as half precision or quantized values */
+    __forceinline bool hasCompactVertices() const {
+      return vertexFormat != VERTEX_FORMAT_FLOAT3;
+    }
+
+    /*! decodes a vertex stored in the format of the vertex buffers */
+    __forceinline vfloat4 loadVertex(const char* ptr) const {
+      return embree::loadVertex(ptr,vertexFormat,vfloat4(quantLower),vfloat4(quantScale));
+    }
+
+    /*! returns true if the vertices of all time steps can get accessed through vertexPtr */
+    __forceinline bool hasUncompressedUniformMotion() const {
+      return hasUniformTimeSteps() && !hasCompressedMotion() && !hasCompactVertices();
+    }
+
+    /*! tests if a vertex of the i'th triangle got modified since the last commit, the modified ranges have to be normalized */
+    __forceinline bool primitiveModified(size_t i) const
+    {
+      const Triangle& tri = triangle(i);
+      return dirtyVertices.contains(tri.v[0]) || dirtyVertices.contains(tri.v[1]) || dirtyVertices.contains(tri.v[2]);
+    }
+
     /*! calculates the bounds of the i'th triangle */
     __forceinline BBox3fa bounds(size_t i) const 
     {
@@ -118,12 +168,36 @@ namespace embree
     /*! calculates the interpolated bounds of the i'th triangle at the specified time */
     __forceinline BBox3fa bounds(size_t i, float time) const
     {
-      float ftime; size_t itime = getTimeSegment(time, fnumTimeSegments, ftime);
+      float ftime; size_t itime = timeSegment(time, ftime);
       const BBox3fa b0 = bounds(i, itime+0);
       const BBox3fa b1 = bounds(i, itime+1);
       return lerp(b0, b1, ftime);
     }
 
+    /*! calculates the bounds of the i'th triangle in the specified space */
+    __forceinline BBox3fa bounds(const LinearSpace3fa& space, size_t i, size_t itime = 0) const
+    {
+      const Triangle& tri = triangle(i);
+      const Vec3fa v0 = xfmVector(space,vertex(tri.v[0],itime));
+      const Vec3fa v1 = xfmVector(space,vertex(tri.v[1],itime));
+      const Vec3fa v2 = xfmVector(space,vertex(tri.v[2],itime));
+      return BBox3fa(min(v0,v1,v2),max(v0,v1,v2));
+    }
+
+    /*! returns the longest edge of the i'th triangle, used to orient oriented bounding boxes */
+    __forceinline Vec3fa direction(size_t i, size_t itime = 0) const
+    {
+      const Triangle& tri = triangle(i);
+      const Vec3fa v0 = vertex(tri.v[0],itime);
+      const Vec3fa v1 = vertex(tri.v[1],itime);
+      const Vec3fa v2 = vertex(tri.v[2],itime);
+      const Vec3fa e0 = v1-v0, e1 = v2-v1, e2 = v0-v2;
+      const float l0 = sqr_length(e0), l1 = sqr_length(e1), l2 = sqr_length(e2);
+      if (l0 >= l1 && l0 >= l2) return e0;
+      if (l1 >= l2) return e1;
+      return e2;
+    }
+
     /*! check if the i'th primitive is valid at the itime'th timestep */
     __forceinline bool valid(size_t i, size_t itime = 0) const {
       return valid(i, make_range(itime, itime));
@@ -197,13 +271,17 @@ namespace embree
     }
 
     /*! calculates the linear bounds of the i'th primitive for the specified time range */
-    __forceinline LBBox3fa linearBounds(size_t primID, const BBox1f& time_range) const {
-      return LBBox3fa([&] (size_t itime) { return bounds(primID, itime); }, time_range, fnumTimeSegments);
+    __forceinline LBBox3fa linearBounds(size_t primID, const BBox1f& time_range) const 
+    {
+      if (likely(hasUniformTimeSteps()))
+        return LBBox3fa([&] (size_t itime) { return bounds(primID, itime); }, time_range, fnumTimeSegments);
+      else
+        return LBBox3fa([&] (size_t itime) { return bounds(primID, itime); }, time_range, timeSteps.data(), int(numTimeSegments()));
     }
 
     /*! calculates the linear bounds of the i'th primitive for the specified time range */
     __forceinline bool linearBounds(size_t i, const BBox1f& time_range, LBBox3fa& bbox) const  {
-      if (!valid(i, getTimeSegmentRange(time_range, fnumTimeSegments))) return false;
+      if (!valid(i, timeSegmentRange(time_range))) return false;
       bbox = linearBounds(i, time_range);
       return true;
     }
@@ -219,7 +297,7 @@ namespace embree
       } 
       else
       {
-        if (!valid(i, getTimeSegmentRange(time_range, fnumTimeSegments))) return false;
+        if (!valid(i, timeSegmentRange(time_range))) return false;
         bbox = linearBounds(i, time_range);
         return true;
       }
@@ -234,6 +312,13 @@ namespace embree
     BufferRefT<Vec3fa> vertices0;                     //!< fast access to first vertex buffer
     vector<APIBuffer<Vec3fa>> vertices;               //!< vertex array for each timestep
     vector<APIBuffer<char>> userbuffers;         //!< user buffers
+    CompressedMotion motion;                          //!< compressed vertices of time steps 1 to N-1
+    bool compressMotion;                              //!< true if vertex motion gets compressed on commit
+    bool motionBaseModified;                          //!< true if the first time step got modified after compressing the motion
+    VertexFormat vertexFormat;                        //!< storage format of the vertex buffers
+    Vec3fa quantLower;                                //!< lower bounds of quantized vertices
+    Vec3fa quantScale;                                //!< dequantization scale of quantized vertices
+    bool hasQuantBounds;                              //!< true if the quantization bounds got set
   };
 
   namespace isa
@@ -37,6 +37,7 @@ namespace embree
 
     cout << "    #stack nodes  = " << float(data.normal.trav_stack_nodes )*1E-6f << "M" << embree_endl;
     cout << "    #stack pop    = " << float(data.normal.trav_stack_pop )*1E-6f << "M" << embree_endl;
+    cout << "    #switches     = " << float(data.normal.trav_switches )*1E-6f << "M, " << (data.normal.trav_switches ? float(cntrs.active.normal.trav_switches)/float(data.normal.trav_switches) : 0.0f) << " rays per switch" << embree_endl;
 
     size_t normal_box_hits = 0;
     size_t weighted_box_hits = 0;
@@ -66,6 +67,8 @@ namespace embree
 
       cout << "    #stack nodes = " << float(data.shadow.trav_stack_nodes )*1E-6f << "M" << embree_endl;
       cout << "    #stack pop   = " << float(data.shadow.trav_stack_pop )*1E-6f << "M" << embree_endl;
+      cout << "    #switches    = " << float(data.shadow.trav_switches )*1E-6f << "M, " << (data.shadow.trav_switches ? float(cntrs.active.shadow.trav_switches)/float(data.shadow.trav_switches) : 0.0f) << " rays per switch" << embree_endl;
+      cout << "    #cache hits  = " << float(data.shadow.trav_cache_hits )*1E-6f << "M" << embree_endl;
 
       size_t shadow_box_hits = 0;
       size_t weighted_shadow_box_hits = 0;
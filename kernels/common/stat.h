@@ -78,6 +78,8 @@ namespace embree
               trav_stack_pop.store(0);
               trav_stack_nodes.store(0); 
               trav_xfm_nodes.store(0); 
+              trav_switches.store(0);
+              trav_cache_hits.store(0);
             }
 
           public:
@@ -90,6 +92,8 @@ namespace embree
 	    std::atomic<size_t> trav_stack_pop;
 	    std::atomic<size_t> trav_stack_nodes; 
             std::atomic<size_t> trav_xfm_nodes; 
+            std::atomic<size_t> trav_switches;    //!< switches from packet to single ray traversal
+            std::atomic<size_t> trav_cache_hits;  //!< shadow rays blocked by the cached occluder leaf
             
 	  } normal, shadow, point_query;
 	} all, active, code; 
@@ -83,8 +83,12 @@ namespace embree
 
     max_spatial_split_replications = 1.2f;
     useSpatialPreSplits = false;
+    adaptive_spatial_splits = false;
 
     max_triangles_per_leaf = inf;
+    refit_rebuild_threshold = 1.5f;
+    morton_split_threshold = 16*1024*1024;
+    adaptive_hybrid_switch = false;
 
     tessellation_cache_size = 128*1024*1024;
 
@@ -417,6 +421,7 @@ namespace embree
             if (flag == Token::Id("dynamic") ) scene_flags |= RTC_SCENE_FLAG_DYNAMIC;
             else if (flag == Token::Id("compact")) scene_flags |= RTC_SCENE_FLAG_COMPACT;
             else if (flag == Token::Id("robust")) scene_flags |= RTC_SCENE_FLAG_ROBUST;
+            else if (flag == Token::Id("watertight")) scene_flags |= RTC_SCENE_FLAG_WATERTIGHT;
           } while (cin->trySymbol("|"));
         }
       }
@@ -427,9 +432,21 @@ namespace embree
       else if (tok == Token::Id("max_triangles_per_leaf") && cin->trySymbol("="))
         max_triangles_per_leaf = cin->get().Float();
 
+      else if (tok == Token::Id("refit_rebuild_threshold") && cin->trySymbol("="))
+        refit_rebuild_threshold = cin->get().Float();
+
+      else if (tok == Token::Id("morton_split_threshold") && cin->trySymbol("="))
+        morton_split_threshold = cin->get().Int();
+
+      else if (tok == Token::Id("adaptive_hybrid_switch") && cin->trySymbol("="))
+        adaptive_hybrid_switch = cin->get().Int() != 0 ? true : false;
+
       else if (tok == Token::Id("presplits") && cin->trySymbol("="))
         useSpatialPreSplits = cin->get().Int() != 0 ? true : false;
 
+      else if (tok == Token::Id("adaptive_spatial_splits") && cin->trySymbol("="))
+        adaptive_spatial_splits = cin->get().Int() != 0 ? true : false;
+
       else if (tok == Token::Id("tessellation_cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
       else if (tok == Token::Id("cache_size") && cin->trySymbol("="))
@@ -475,6 +492,10 @@ namespace embree
     std::cout << "  verbosity          = " << verbose << std::endl;
     std::cout << "  cache_size         = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
+    std::cout << "  adaptive_spatial_splits = " << adaptive_spatial_splits << std::endl;
+    std::cout << "  refit_rebuild_threshold = " << refit_rebuild_threshold << std::endl;
+    std::cout << "  morton_split_threshold = " << morton_split_threshold << std::endl;
+    std::cout << "  adaptive_hybrid_switch = " << adaptive_hybrid_switch << std::endl;
     
     std::cout << "triangles:" << std::endl;
     std::cout << "  accel              = " << tri_accel << std::endl;
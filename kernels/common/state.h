@@ -108,8 +108,12 @@ namespace embree
 
   public:
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
+    bool adaptive_spatial_splits;          //!< spend the spatial split budget only where splits reduce the SAH most
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
     size_t max_triangles_per_leaf;
+    float refit_rebuild_threshold;         //!< refitted BVHs get rebuilt once their SAH cost grew by this factor
+    size_t morton_split_threshold;         //!< SAH builds of at least that many primitives split the upper levels in Morton order
+    bool adaptive_hybrid_switch;           //!< adapt the switch from packet to single ray traversal to the ray coherence
 
   public:
     size_t instancing_open_min;            //!< instancing opens tree to minimally that number of subtrees
@@ -0,0 +1,68 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  /*! Storage format of the vertices of triangle and quad meshes */
+  enum VertexFormat
+  {
+    VERTEX_FORMAT_FLOAT3,   //!< 32 bit floats, the 4th component is padding
+    VERTEX_FORMAT_HALF3,    //!< 16 bit floats
+    VERTEX_FORMAT_USHORT3   //!< 16 bit unsigned integers quantized relative to per geometry bounds
+  };
+
+  /*! returns the vertex format of an API format, or false if the format is not supported for vertices */
+  __forceinline bool getVertexFormat(RTCFormat format, VertexFormat& vertexFormat)
+  {
+    switch (format) {
+    case RTC_FORMAT_FLOAT3 : vertexFormat = VERTEX_FORMAT_FLOAT3;  return true;
+    case RTC_FORMAT_HALF3  : vertexFormat = VERTEX_FORMAT_HALF3;   return true;
+    case RTC_FORMAT_USHORT3: vertexFormat = VERTEX_FORMAT_USHORT3; return true;
+    default                : return false;
+    }
+  }
+
+  /*! loads four 16 bit values zero extended to 32 bit */
+  __forceinline vint4 loadUShort4(const char* ptr) {
+    return vint4(_mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)ptr),_mm_setzero_si128()));
+  }
+
+  /*! loads four 16 bit values sign extended to 32 bit */
+  __forceinline vint4 loadShort4(const int16_t* ptr) {
+    const __m128i x = _mm_loadl_epi64((const __m128i*)ptr);
+    return vint4(_mm_srai_epi32(_mm_unpacklo_epi16(x,x),16));
+  }
+
+  /*! converts four half precision floats to single precision */
+  __forceinline vfloat4 decodeHalf4(const char* ptr)
+  {
+#if defined(__F16C__) || defined(__AVX2__)
+    return vfloat4(_mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)ptr)));
+#else
+    /* shift exponent and mantissa into place and rebias exponent
+     * with a multiplication, this also handles denormals */
+    const vint4 h = loadUShort4(ptr);
+    const vint4 sign = (h & vint4(0x8000)) << 16;
+    const vfloat4 f = asFloat((h & vint4(0x7FFF)) << 13) * asFloat(vint4(0x77800000));
+    const vfloat4 r = select(f >= vfloat4(65536.0f), asFloat(asInt(f) | vint4(0x7F800000)), f);
+    return asFloat(asInt(r) | sign);
+#endif
+  }
+
+  /*! dequantizes four 16 bit unsigned integers relative to some bounds */
+  __forceinline vfloat4 decodeUShort4(const char* ptr, const vfloat4& lower, const vfloat4& scale) {
+    return madd(vfloat4(loadUShort4(ptr)),scale,lower);
+  }
+
+  /*! loads a vertex stored in the specified format */
+  __forceinline vfloat4 loadVertex(const char* ptr, VertexFormat format, const vfloat4& lower, const vfloat4& scale)
+  {
+    if (likely(format == VERTEX_FORMAT_FLOAT3)) return vfloat4::loadu((const float*)ptr);
+    if (format == VERTEX_FORMAT_HALF3) return decodeHalf4(ptr);
+    return decodeUShort4(ptr,lower,scale);
+  }
+}
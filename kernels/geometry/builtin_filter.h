@@ -0,0 +1,82 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "../common/geometry.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! interpolates the texture coordinate of the hit, triangles use
+     *  barycentric and quads bilinear interpolation */
+    template<typename T>
+      __forceinline Vec2<T> builtinFilterTexcoord(const BuiltinFilters& f, unsigned primID, const T& u, const T& v)
+    {
+      const Vec2f t0 = f.getTexcoord(f.getVertexIndex(primID,0));
+      const Vec2f t1 = f.getTexcoord(f.getVertexIndex(primID,1));
+      const Vec2f t2 = f.getTexcoord(f.getVertexIndex(primID,2));
+      if (f.numPrimVertices == 3) {
+        const T w = T(one)-u-v;
+        return Vec2<T>(w*t0.x + u*t1.x + v*t2.x, w*t0.y + u*t1.y + v*t2.y);
+      }
+      const Vec2f t3 = f.getTexcoord(f.getVertexIndex(primID,3));
+      const Vec2<T> t01 = Vec2<T>(T(t0.x),T(t0.y)) + u*Vec2<T>(T(t1.x-t0.x),T(t1.y-t0.y));
+      const Vec2<T> t32 = Vec2<T>(T(t3.x),T(t3.y)) + u*Vec2<T>(T(t2.x-t3.x),T(t2.y-t3.y));
+      return t01 + v*(t32-t01);
+    }
+
+    /*! nearest texel lookup with repeat wrap mode */
+    __forceinline int builtinFilterTexelIndex(const BuiltinFilters& f, float s, float t)
+    {
+      const int x = min(int((s-floorf(s))*float(f.alphaWidth )), int(f.alphaWidth )-1);
+      const int y = min(int((t-floorf(t))*float(f.alphaHeight)), int(f.alphaHeight)-1);
+      return y*int(f.alphaWidth)+x;
+    }
+
+    /*! evaluates the built-in filters for a single hit, returns false if the hit gets ignored */
+    __forceinline bool runBuiltinFilter1(const Geometry* geometry, unsigned rayMask, unsigned primID, float u, float v)
+    {
+      const BuiltinFilters& f = geometry->builtinFilters;
+      if (f.primMask && (f.getPrimMask(primID) & rayMask) == 0)
+        return false;
+      if (f.opacity && f.getOpacity(primID) < f.opacityCutoff)
+        return false;
+      if (f.alphaTexels)
+      {
+        const Vec2f st = builtinFilterTexcoord(f,primID,u,v);
+        const float alpha = float(f.alphaTexels[builtinFilterTexelIndex(f,st.x,st.y)])*(1.0f/255.0f);
+        if (alpha < f.alphaCutoff) return false;
+      }
+      return true;
+    }
+
+    /*! evaluates the built-in filters for K hits of the same primitive, returns the lanes that are not ignored */
+    template<int K>
+      __forceinline vbool<K> runBuiltinFilter(const vbool<K>& valid_i, const Geometry* geometry, const vint<K>& rayMask, unsigned primID, const vfloat<K>& u, const vfloat<K>& v)
+    {
+      const BuiltinFilters& f = geometry->builtinFilters;
+      vbool<K> valid = valid_i;
+      if (f.primMask)
+        valid &= (vint<K>(f.getPrimMask(primID)) & rayMask) != vint<K>(zero);
+      if (f.opacity && f.getOpacity(primID) < f.opacityCutoff)
+        return false;
+      if (f.alphaTexels && any(valid))
+      {
+        /* texture coordinates are interpolated for all lanes, only the texel fetch is scalar */
+        const Vec2<vfloat<K>> st = builtinFilterTexcoord(f,primID,u,v);
+        const vfloat<K> s = (st.x-floor(st.x))*vfloat<K>(float(f.alphaWidth));
+        const vfloat<K> t = (st.y-floor(st.y))*vfloat<K>(float(f.alphaHeight));
+        const vint<K> x = min(vint<K>(s),vint<K>(f.alphaWidth-1));
+        const vint<K> y = min(vint<K>(t),vint<K>(f.alphaHeight-1));
+        const vint<K> index = y*vint<K>(f.alphaWidth)+x;
+        vint<K> texel(zero);
+        for (size_t m=movemask(valid), i=__bsf(m); m!=0; m=__btc(m,i), i=__bsf(m))
+          texel[i] = f.alphaTexels[index[i]];
+        valid &= vfloat<K>(texel)*vfloat<K>(1.0f/255.0f) >= vfloat<K>(f.alphaCutoff);
+      }
+      return valid;
+    }
+  }
+}
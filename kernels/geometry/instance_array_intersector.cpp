@@ -11,10 +11,63 @@ namespace embree
 {
   namespace isa
   {
+    /*! returns the bits of a float */
+    __forceinline unsigned int floatBits(float f) {
+      unsigned int i; memcpy(&i,&f,sizeof(i)); return i;
+    }
+
+    /*! finalizes a hash value */
+    __forceinline unsigned int lodHashMix(unsigned int h) {
+      h ^= h >> 15; h *= 0x2C1B3C6Du; h ^= h >> 12; return h;
+    }
+
+    template<int K>
+    __forceinline vint<K> lodHashMix(vint<K> h) {
+      h = h ^ srl(h,15); h = h*vint<K>(0x2C1B3C6D); h = h ^ srl(h,12); return h;
+    }
+
+    /*! per ray random value in [0,1) for stochastic level of detail
+     *  selection, hashed from the ray origin, direction, and ID, and the
+     *  instance, such that parallel rays and neighboring instances select
+     *  their levels independently */
+    template<typename Ray>
+    __forceinline float lodRandom(const Ray& ray, unsigned int primID)
+    {
+      unsigned int h = floatBits(ray.org.x)*0x9E3779B1u ^ floatBits(ray.org.y)*0x85EBCA77u ^ floatBits(ray.org.z)*0xC2B2AE3Du;
+      h = lodHashMix(h) ^ floatBits(ray.dir.x)*0x27D4EB2Fu ^ floatBits(ray.dir.y)*0x165667B1u ^ floatBits(ray.dir.z)*0xD3A2646Cu;
+      h = lodHashMix(h) ^ ray.id*0xFD7046C5u ^ primID*0xB55A4F09u;
+      return float(lodHashMix(h) >> 8)*(1.0f/16777216.0f);
+    }
+
+    template<int K>
+    __forceinline vfloat<K> lodRandom(const RayK<K>& ray, unsigned int primID)
+    {
+      vint<K> h = asInt(ray.org.x)*vint<K>(int(0x9E3779B1)) ^ asInt(ray.org.y)*vint<K>(int(0x85EBCA77)) ^ asInt(ray.org.z)*vint<K>(int(0xC2B2AE3D));
+      h = lodHashMix<K>(h) ^ asInt(ray.dir.x)*vint<K>(int(0x27D4EB2F)) ^ asInt(ray.dir.y)*vint<K>(int(0x165667B1)) ^ asInt(ray.dir.z)*vint<K>(int(0xD3A2646C));
+      h = lodHashMix<K>(h) ^ ((const vint<K>&)ray.id)*vint<K>(int(0xFD7046C5)) ^ vint<K>(int(primID*0xB55A4F09u));
+      return vfloat<K>(srl(lodHashMix<K>(h),8))*(1.0f/16777216.0f);
+    }
+
+    /*! selects the level of detail of an instance for each ray of a packet */
+    template<int K>
+    __forceinline vint<K> getLOD(const InstanceArray* instance, size_t primID, const vbool<K>& valid, const RayK<K>& ray)
+    {
+      if (likely(!instance->hasLODs())) return vint<K>(zero);
+      return instance->getLOD<K>(primID,valid,ray.org,ray.time(),lodRandom<K>(ray,(unsigned int)primID));
+    }
+
+    /*! selects the instanced scene of an instance for a single ray */
+    template<typename Ray>
+    __forceinline Accel* getObject(const InstanceArray* instance, size_t primID, const Ray& ray)
+    {
+      if (likely(!instance->hasLODs())) return instance->getObject(primID);
+      return instance->getObject(primID,instance->getLOD(primID,Vec3fa(ray.org.x,ray.org.y,ray.org.z),ray.time(),lodRandom(ray,(unsigned int)primID)));
+    }
+
     void InstanceArrayIntersector1::intersect(const Precalculations& pre, RayHit& ray, RayQueryContext* context, const Primitive& prim)
     {
       InstanceArray* instance = context->scene->get<InstanceArray>(prim.instID_);
-      Accel* object = instance->getObject(prim.primID_);
+      Accel* object = getObject(instance,prim.primID_,ray);
       if (!object) return;
 
       /* perform ray mask test */
@@ -26,13 +79,19 @@ namespace embree
       RTCRayQueryContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
       {
-        const AffineSpace3fa world2local = instance->getWorld2Local(prim.primID_);
+        const AffineSpace3fa local2world = instance->getLocal2World(prim.primID_);
+        const AffineSpace3fa world2local = rcp(local2world);
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(instance->xfmOrigin(world2local, Vec3fa(local2world.p), Vec3fa(ray_org)), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
+        const float ray_tfar = ray.tfar;
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        newcontext.multiHits = context->multiHits;
+        newcontext.rayCone = context->rayCone;
         object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
+        if (unlikely(context->rayCone != nullptr) && ray.tfar < ray_tfar)
+          context->rayCone->leaveInstance(ray.tfar,local2world);
         ray.org = ray_org;
         ray.dir = ray_dir;
         instance_id_stack::pop(user_context);
@@ -42,7 +101,7 @@ namespace embree
     bool InstanceArrayIntersector1::occluded(const Precalculations& pre, Ray& ray, RayQueryContext* context, const Primitive& prim)
     {
       const InstanceArray* instance = context->scene->get<InstanceArray>(prim.instID_);
-      Accel* object = instance->getObject(prim.primID_);
+      Accel* object = getObject(instance,prim.primID_,ray);
       if (!object) return false;
       
       /* perform ray mask test */
@@ -55,11 +114,11 @@ namespace embree
       bool occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
       {
-        const AffineSpace3fa world2local = instance->getWorld2Local(prim.primID_);
-        Accel* object = instance->getObject(prim.primID_);
+        const AffineSpace3fa local2world = instance->getLocal2World(prim.primID_);
+        const AffineSpace3fa world2local = rcp(local2world);
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(instance->xfmOrigin(world2local, Vec3fa(local2world.p), Vec3fa(ray_org)), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
         object->intersectors.occluded((RTCRay&)ray, &newcontext);
@@ -88,7 +147,7 @@ namespace embree
       {
         PointQuery query_inst;
         query_inst.time = query->time;
-        query_inst.p = xfmPoint(world2local, query->p); 
+        query_inst.p = instance->xfmOrigin(world2local, Vec3fa(local2world.p), Vec3fa(query->p));
         query_inst.radius = query->radius * similarityScale;
 
         PointQueryContext context_inst(
@@ -110,7 +169,7 @@ namespace embree
     void InstanceArrayIntersector1MB::intersect(const Precalculations& pre, RayHit& ray, RayQueryContext* context, const Primitive& prim)
     {
       const InstanceArray* instance = context->scene->get<InstanceArray>(prim.instID_);
-      Accel* object = instance->getObject(prim.primID_);
+      Accel* object = getObject(instance,prim.primID_,ray);
       if (!object) return;
 
       /* perform ray mask test */
@@ -122,13 +181,19 @@ namespace embree
       RTCRayQueryContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
       {
-        const AffineSpace3fa world2local = instance->getWorld2Local(prim.primID_, ray.time());
+        const AffineSpace3fa local2world = instance->getLocal2World(prim.primID_, ray.time());
+        const AffineSpace3fa world2local = rcp(local2world);
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(instance->xfmOrigin(world2local, Vec3fa(local2world.p), Vec3fa(ray_org)), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
+        const float ray_tfar = ray.tfar;
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
+        newcontext.multiHits = context->multiHits;
+        newcontext.rayCone = context->rayCone;
         object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
+        if (unlikely(context->rayCone != nullptr) && ray.tfar < ray_tfar)
+          context->rayCone->leaveInstance(ray.tfar,local2world);
         ray.org = ray_org;
         ray.dir = ray_dir;
         instance_id_stack::pop(user_context);
@@ -138,7 +203,7 @@ namespace embree
     bool InstanceArrayIntersector1MB::occluded(const Precalculations& pre, Ray& ray, RayQueryContext* context, const Primitive& prim)
     {
       const InstanceArray* instance = context->scene->get<InstanceArray>(prim.instID_);
-      Accel* object = instance->getObject(prim.primID_);
+      Accel* object = getObject(instance,prim.primID_,ray);
       if (!object) return false;
 
       /* perform ray mask test */
@@ -151,10 +216,11 @@ namespace embree
       bool occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
       {
-        const AffineSpace3fa world2local = instance->getWorld2Local(prim.primID_, ray.time());
+        const AffineSpace3fa local2world = instance->getLocal2World(prim.primID_, ray.time());
+        const AffineSpace3fa world2local = rcp(local2world);
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(instance->xfmOrigin(world2local, Vec3fa(local2world.p), Vec3fa(ray_org)), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
         RayQueryContext newcontext((Scene*)object, user_context, context->args);
         object->intersectors.occluded((RTCRay&)ray, &newcontext);
@@ -182,7 +248,7 @@ namespace embree
       {
         PointQuery query_inst;
         query_inst.time = query->time;
-        query_inst.p = xfmPoint(world2local, query->p); 
+        query_inst.p = instance->xfmOrigin(world2local, Vec3fa(local2world.p), Vec3fa(query->p));
         query_inst.radius = query->radius * similarityScale;
 
         PointQueryContext context_inst(
@@ -215,16 +281,22 @@ namespace embree
       if (none(valid)) return;
 #endif
         
+      const vint<K> lod = getLOD(instance,prim.primID_,valid,ray);
       RTCRayQueryContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
       {
-        const AffineSpace3vf<K> world2local = instance->getWorld2Local(prim.primID_);
+        const AffineSpace3fa local2world = instance->getLocal2World(prim.primID_);
+        const AffineSpace3vf<K> world2local = rcp(local2world);
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = instance->xfmOrigin<K>(world2local, Vec3vf<K>(Vec3fa(local2world.p)), ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
-        RayQueryContext newcontext((Scene*)object, user_context, context->args);
-        object->intersectors.intersect(valid, ray, &newcontext);
+        foreach_unique(valid,lod,[&] (const vbool<K>& valid, int l) {
+            Accel* lodObject = instance->getObject(prim.primID_,l);
+            RayQueryContext newcontext((Scene*)lodObject, user_context, context->args);
+            newcontext.multiHits = context->multiHits;
+            lodObject->intersectors.intersect(valid, ray, &newcontext);
+          });
         ray.org = ray_org;
         ray.dir = ray_dir;
         instance_id_stack::pop(user_context);
@@ -245,17 +317,22 @@ namespace embree
       if (none(valid)) return false;
 #endif
         
+      const vint<K> lod = getLOD(instance,prim.primID_,valid,ray);
       RTCRayQueryContext* user_context = context->user;
       vbool<K> occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
       {
-        const AffineSpace3vf<K> world2local = instance->getWorld2Local(prim.primID_);
+        const AffineSpace3fa local2world = instance->getLocal2World(prim.primID_);
+        const AffineSpace3vf<K> world2local = rcp(local2world);
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = instance->xfmOrigin<K>(world2local, Vec3vf<K>(Vec3fa(local2world.p)), ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
-        RayQueryContext newcontext((Scene*)object, user_context, context->args);
-        object->intersectors.occluded(valid, ray, &newcontext);
+        foreach_unique(valid,lod,[&] (const vbool<K>& valid, int l) {
+            Accel* lodObject = instance->getObject(prim.primID_,l);
+            RayQueryContext newcontext((Scene*)lodObject, user_context, context->args);
+            lodObject->intersectors.occluded(valid, ray, &newcontext);
+          });
         ray.org = ray_org;
         ray.dir = ray_dir;
         occluded = ray.tfar < 0.0f;
@@ -278,16 +355,22 @@ namespace embree
       if (none(valid)) return;
 #endif
         
+      const vint<K> lod = getLOD(instance,prim.primID_,valid,ray);
       RTCRayQueryContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
       {
-        AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(prim.primID_, valid, ray.time());
+        const AffineSpace3vf<K> local2world = instance->getLocal2World<K>(prim.primID_, valid, ray.time());
+        const AffineSpace3vf<K> world2local = rcp(local2world);
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = instance->xfmOrigin<K>(world2local, local2world.p, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
-        RayQueryContext newcontext((Scene*)object, user_context, context->args);
-        object->intersectors.intersect(valid, ray, &newcontext);
+        foreach_unique(valid,lod,[&] (const vbool<K>& valid, int l) {
+            Accel* lodObject = instance->getObject(prim.primID_,l);
+            RayQueryContext newcontext((Scene*)lodObject, user_context, context->args);
+            newcontext.multiHits = context->multiHits;
+            lodObject->intersectors.intersect(valid, ray, &newcontext);
+          });
         ray.org = ray_org;
         ray.dir = ray_dir;
         instance_id_stack::pop(user_context);
@@ -308,17 +391,22 @@ namespace embree
       if (none(valid)) return false;
 #endif
         
+      const vint<K> lod = getLOD(instance,prim.primID_,valid,ray);
       RTCRayQueryContext* user_context = context->user;
       vbool<K> occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
       {
-        AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(prim.primID_, valid, ray.time());
+        const AffineSpace3vf<K> local2world = instance->getLocal2World<K>(prim.primID_, valid, ray.time());
+        const AffineSpace3vf<K> world2local = rcp(local2world);
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = instance->xfmOrigin<K>(world2local, local2world.p, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
-        RayQueryContext newcontext((Scene*)object, user_context, context->args);
-        object->intersectors.occluded(valid, ray, &newcontext);
+        foreach_unique(valid,lod,[&] (const vbool<K>& valid, int l) {
+            Accel* lodObject = instance->getObject(prim.primID_,l);
+            RayQueryContext newcontext((Scene*)lodObject, user_context, context->args);
+            lodObject->intersectors.occluded(valid, ray, &newcontext);
+          });
         ray.org = ray_org;
         ray.dir = ray_dir;
         occluded = ray.tfar < 0.0f;
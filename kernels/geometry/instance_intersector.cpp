@@ -27,10 +27,15 @@ namespace embree
         const AffineSpace3fa world2local = instance->getWorld2Local();
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(instance->xfmOrigin(world2local, Vec3fa(instance->local2world[0].p), Vec3fa(ray_org)), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
+        const float ray_tfar = ray.tfar;
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
+        newcontext.multiHits = context->multiHits;
+        newcontext.rayCone = context->rayCone;
         instance->object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
+        if (unlikely(context->rayCone != nullptr) && ray.tfar < ray_tfar)
+          context->rayCone->leaveInstance(ray.tfar,instance->local2world[0]);
         ray.org = ray_org;
         ray.dir = ray_dir;
         instance_id_stack::pop(user_context);
@@ -54,7 +59,7 @@ namespace embree
         const AffineSpace3fa world2local = instance->getWorld2Local();
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(instance->xfmOrigin(world2local, Vec3fa(instance->local2world[0].p), Vec3fa(ray_org)), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
         instance->object->intersectors.occluded((RTCRay&)ray, &newcontext);
@@ -81,7 +86,7 @@ namespace embree
       {
         PointQuery query_inst;
         query_inst.time = query->time;
-        query_inst.p = xfmPoint(world2local, query->p); 
+        query_inst.p = instance->xfmOrigin(world2local, Vec3fa(local2world.p), Vec3fa(query->p));
         query_inst.radius = query->radius * similarityScale;
 
         PointQueryContext context_inst(
@@ -113,13 +118,19 @@ namespace embree
       RTCRayQueryContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_, 0)))
       {
-        const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
+        const AffineSpace3fa local2world = instance->getLocal2World(ray.time());
+        const AffineSpace3fa world2local = rcp(local2world);
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(instance->xfmOrigin(world2local, Vec3fa(local2world.p), Vec3fa(ray_org)), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
+        const float ray_tfar = ray.tfar;
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
+        newcontext.multiHits = context->multiHits;
+        newcontext.rayCone = context->rayCone;
         instance->object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
+        if (unlikely(context->rayCone != nullptr) && ray.tfar < ray_tfar)
+          context->rayCone->leaveInstance(ray.tfar,local2world);
         ray.org = ray_org;
         ray.dir = ray_dir;
         instance_id_stack::pop(user_context);
@@ -140,10 +151,11 @@ namespace embree
       bool occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_, 0)))
       {
-        const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
+        const AffineSpace3fa local2world = instance->getLocal2World(ray.time());
+        const AffineSpace3fa world2local = rcp(local2world);
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
-        ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
+        ray.org = Vec3ff(instance->xfmOrigin(world2local, Vec3fa(local2world.p), Vec3fa(ray_org)), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
         instance->object->intersectors.occluded((RTCRay&)ray, &newcontext);
@@ -169,7 +181,7 @@ namespace embree
       {
         PointQuery query_inst;
         query_inst.time = query->time;
-        query_inst.p = xfmPoint(world2local, query->p); 
+        query_inst.p = instance->xfmOrigin(world2local, Vec3fa(local2world.p), Vec3fa(query->p));
         query_inst.radius = query->radius * similarityScale;
         
         PointQueryContext context_inst(
@@ -206,9 +218,10 @@ namespace embree
         AffineSpace3vf<K> world2local = instance->getWorld2Local();
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = instance->xfmOrigin(world2local, Vec3vf<K>(instance->local2world[0].p), ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
+        newcontext.multiHits = context->multiHits;
         instance->object->intersectors.intersect(valid, ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
@@ -235,7 +248,7 @@ namespace embree
         AffineSpace3vf<K> world2local = instance->getWorld2Local();
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = instance->xfmOrigin(world2local, Vec3vf<K>(instance->local2world[0].p), ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
         instance->object->intersectors.occluded(valid, ray, &newcontext);
@@ -262,12 +275,14 @@ namespace embree
       RTCRayQueryContext* user_context = context->user;
       if (likely(instance_id_stack::push(user_context, prim.instID_, 0)))
       {
-        AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid, ray.time());
+        const AffineSpace3vf<K> local2world = instance->getLocal2World<K>(valid, ray.time());
+        const AffineSpace3vf<K> world2local = rcp(local2world);
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = instance->xfmOrigin(world2local, local2world.p, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
+        newcontext.multiHits = context->multiHits;
         instance->object->intersectors.intersect(valid, ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
@@ -291,10 +306,11 @@ namespace embree
       vbool<K> occluded = false;
       if (likely(instance_id_stack::push(user_context, prim.instID_, 0)))
       {
-        AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid, ray.time());
+        const AffineSpace3vf<K> local2world = instance->getLocal2World<K>(valid, ray.time());
+        const AffineSpace3vf<K> world2local = rcp(local2world);
         const Vec3vf<K> ray_org = ray.org;
         const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
+        ray.org = instance->xfmOrigin(world2local, local2world.p, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
         RayQueryContext newcontext((Scene*)instance->object, user_context, context->args);
         instance->object->intersectors.occluded(valid, ray, &newcontext);
@@ -19,6 +19,7 @@
 #include "../common/ray.h"
 #include "../common/context.h"
 #include "filter.h"
+#include "builtin_filter.h"
 
 namespace embree
 {
@@ -29,6 +30,27 @@ namespace embree
         __forceinline void operator() (vfloat<M>& u, vfloat<M>& v) const {}
       };
 
+    /*! records a hit in the multi-hit buffer of a ray and shrinks the
+     *  ray to the farthest collected hit once the buffer is full */
+    template<bool filter>
+      __forceinline bool recordMultiHit(MultiHit& hits, float& tfar, IntersectContext* context, unsigned rayMask,
+                                        float t, float u, float v, const Vec3fa& Ng, unsigned geomID, unsigned primID)
+    {
+      Geometry* geometry MAYBE_UNUSED = context->scene->get(geomID);
+#if defined(EMBREE_RAY_MASK)
+      if ((geometry->mask & rayMask) == 0) return false;
+#endif
+#if defined(EMBREE_INTERSECTION_FILTER)
+      if (filter && unlikely(geometry->hasBuiltinFilters()) && !runBuiltinFilter1(geometry,rayMask,primID,u,v)) return false;
+#endif
+      const unsigned hitGeomID = context->geomID_to_instID ? context->geomID_to_instID[0] : geomID;
+      /* hits inside instances are reported with the instance on top of the instance stack */
+      const unsigned hitInstID = context->geomID_to_instID ? context->instID : context->user->instID[0];
+      if (!hits.insert(t,u,v,Ng,hitGeomID,primID,hitInstID)) return false;
+      if (hits.full()) tfar = hits.farthest();
+      return true;
+    }
+
     template<bool filter>
       struct Intersect1Epilog1
       {
@@ -54,9 +76,15 @@ namespace embree
 #endif
           hit.finalize();
           int instID = context->geomID_to_instID ? context->geomID_to_instID[0] : geomID;
+
+          /* collect hit in multi-hit mode */
+          if (unlikely(context->multiHits != nullptr))
+            return recordMultiHit<filter>(context->multiHits[0],ray.tfar,context,ray.mask,hit.t,hit.u,hit.v,hit.Ng,geomID,primID);
           
           /* intersection filter test */
 #if defined(EMBREE_INTERSECTION_FILTER)
+          if (unlikely(filter && geometry->hasBuiltinFilters() && !runBuiltinFilter1(geometry,ray.mask,primID,hit.u,hit.v)))
+            return false;
           if (unlikely(filter && geometry->hasIntersectionFilter1())) 
             return runIntersectionFilter1(geometry,ray,context,hit.u,hit.v,hit.t,hit.Ng,instID,primID);
 #endif
@@ -68,6 +96,9 @@ namespace embree
           ray.Ng = hit.Ng;
           ray.geomID = instID;
           ray.primID = primID;
+          /* curves have no triangle area */
+          if (unlikely(context->rayCone != nullptr))
+            context->rayCone->recordNoArea(hit.t,hit.Ng);
           return true;
         }
       };
@@ -100,6 +131,8 @@ namespace embree
           
           /* intersection filter test */
 #if defined(EMBREE_INTERSECTION_FILTER)
+          if (unlikely(filter && geometry->hasBuiltinFilters() && !runBuiltinFilter1(geometry,ray.mask,primID,hit.u,hit.v)))
+            return false;
           if (unlikely(filter && geometry->hasOcclusionFilter1())) 
             return runOcclusionFilter1(geometry,ray,context,hit.u,hit.v,hit.t,hit.Ng,instID,primID);
 #endif
@@ -133,9 +166,15 @@ namespace embree
             return false;
 #endif
           hit.finalize();
+
+          /* collect hit in multi-hit mode */
+          if (unlikely(context->multiHits != nullptr))
+            return recordMultiHit<filter>(context->multiHits[k],ray.tfar[k],context,ray.mask[k],hit.t,hit.u,hit.v,hit.Ng,geomID,primID);
           
           /* intersection filter test */
 #if defined(EMBREE_INTERSECTION_FILTER)
+          if (filter && unlikely(geometry->hasBuiltinFilters()) && !runBuiltinFilter1(geometry,ray.mask[k],primID,hit.u,hit.v))
+            return false;
           if (filter && unlikely(geometry->hasIntersectionFilter<vfloat<K>>())) 
             return runIntersectionFilter(geometry,ray,k,context,hit.u,hit.v,hit.t,hit.Ng,geomID,primID);
 #endif
@@ -181,6 +220,11 @@ namespace embree
 
           /* intersection filter test */
 #if defined(EMBREE_INTERSECTION_FILTER)
+          if (filter && unlikely(geometry->hasBuiltinFilters())) {
+            hit.finalize();
+            if (!runBuiltinFilter1(geometry,ray.mask[k],primID,hit.u,hit.v))
+              return false;
+          }
           if (filter && unlikely(geometry->hasOcclusionFilter<vfloat<K>>())) {
             hit.finalize();
             return runOcclusionFilter(geometry,ray,k,context,hit.u,hit.v,hit.t,hit.Ng,geomID,primID);
@@ -214,6 +258,18 @@ namespace embree
           size_t i = select_min(valid,hit.vt);
           int geomID = Leaf::decodeID(geomIDs[i]);
           int instID = context->geomID_to_instID ? context->geomID_to_instID[0] : geomID;
+
+          /* collect all hits of the leaf in multi-hit mode */
+          if (unlikely(context->multiHits != nullptr))
+          {
+            bool foundhit = false;
+            for (size_t m=movemask(valid), j=__bsf(m); m!=0; m=__btc(m,j), j=__bsf(m)) {
+              const Vec2f uv = hit.uv(j);
+              foundhit |= recordMultiHit<filter>(context->multiHits[0],ray.tfar,context,ray.mask,hit.t(j),uv.x,uv.y,hit.Ng(j),Leaf::decodeID(geomIDs[j]),primIDs[j]);
+            }
+            return foundhit;
+          }
+
           /* intersection filter test */
 #if defined(EMBREE_INTERSECTION_FILTER) || defined(EMBREE_RAY_MASK)
           bool foundhit = false;
@@ -239,6 +295,14 @@ namespace embree
 #if defined(EMBREE_INTERSECTION_FILTER) 
             /* call intersection filter function */
             if (filter) {
+              /* goto next hit if built-in filters reject the hit */
+              if (unlikely(geometry->hasBuiltinFilters())) {
+                const Vec2f uv = hit.uv(i);
+                if (!runBuiltinFilter1(geometry,ray.mask,primIDs[i],uv.x,uv.y)) {
+                  clear(valid,i);
+                  continue;
+                }
+              }
               if (unlikely(geometry->hasIntersectionFilter1())) {
                 const Vec2f uv = hit.uv(i);
                 foundhit |= runIntersectionFilter1(geometry,ray,context,uv.x,uv.y,hit.t(i),hit.Ng(i),instID,primIDs[i]);
@@ -262,6 +326,8 @@ namespace embree
           ray.Ng.z = hit.vNg.z[i];
           ray.geomID = instID;
           ray.primID = primIDs[i];
+          if (unlikely(context->rayCone != nullptr))
+            context->rayCone->record(hit.vt[i],hit.Ng(i),context->scene->get(geomID));
           return true;
 
         }
@@ -294,6 +360,17 @@ namespace embree
           int geomID = Leaf::decodeID(geomIDs[i]);
           int instID = context->geomID_to_instID ? context->geomID_to_instID[0] : geomID;
 
+          /* collect all hits of the leaf in multi-hit mode */
+          if (unlikely(context->multiHits != nullptr))
+          {
+            bool foundhit = false;
+            for (size_t m=movemask(valid), j=__bsf(m); m!=0; m=__btc(m,j), j=__bsf(m)) {
+              const Vec2f uv = hit.uv(j);
+              foundhit |= recordMultiHit<filter>(context->multiHits[0],ray.tfar,context,ray.mask,hit.t(j),uv.x,uv.y,hit.Ng(j),Leaf::decodeID(geomIDs[j]),primIDs[j]);
+            }
+            return foundhit;
+          }
+
           /* intersection filter test */
 #if defined(EMBREE_INTERSECTION_FILTER) || defined(EMBREE_RAY_MASK)
           bool foundhit = false;
@@ -319,6 +396,14 @@ namespace embree
 #if defined(EMBREE_INTERSECTION_FILTER) 
             /* call intersection filter function */
             if (filter) {
+              /* goto next hit if built-in filters reject the hit */
+              if (unlikely(geometry->hasBuiltinFilters())) {
+                const Vec2f uv = hit.uv(i);
+                if (!runBuiltinFilter1(geometry,ray.mask,primIDs[i],uv.x,uv.y)) {
+                  clear(valid,i);
+                  continue;
+                }
+              }
               if (unlikely(geometry->hasIntersectionFilter1())) {
                 const Vec2f uv = hit.uv(i);
                 foundhit |= runIntersectionFilter1(geometry,ray,context,uv.x,uv.y,hit.t(i),hit.Ng(i),instID,primIDs[i]);
@@ -334,6 +419,8 @@ namespace embree
 
           vbool<Mx> finalMask(((unsigned int)1 << i));
           ray.update(finalMask,hit.vt,hit.vu,hit.vv,hit.vNg.x,hit.vNg.y,hit.vNg.z,instID,primIDs);
+          if (unlikely(context->rayCone != nullptr))
+            context->rayCone->record(hit.vt[i],hit.Ng(i),context->scene->get(geomID));
           return true;
 
         }
@@ -389,6 +476,14 @@ namespace embree
 #if defined(EMBREE_INTERSECTION_FILTER)
             /* if we have no filter then the test passed */
             if (filter) {
+              /* goto next hit if built-in filters reject the hit */
+              if (unlikely(geometry->hasBuiltinFilters())) {
+                const Vec2f uv = hit.uv(i);
+                if (!runBuiltinFilter1(geometry,ray.mask,primIDs[i],uv.x,uv.y)) {
+                  m=__btc(m,i);
+                  continue;
+                }
+              }
               if (unlikely(geometry->hasOcclusionFilter1())) 
               {
                 //const Vec3fa Ngi = Vec3fa(Ng.x[i],Ng.y[i],Ng.z[i]);
@@ -437,8 +532,32 @@ namespace embree
           
           size_t i = select_min(valid,hit.vt);
           
+          /* collect all hits of the leaf in multi-hit mode */
+          if (unlikely(context->multiHits != nullptr))
+          {
+            bool foundhit = false;
+            for (size_t m=movemask(valid), j=__bsf(m); m!=0; m=__btc(m,j), j=__bsf(m)) {
+              const Vec2f uv = hit.uv(j);
+              foundhit |= recordMultiHit<filter>(context->multiHits[0],ray.tfar,context,ray.mask,hit.t(j),uv.x,uv.y,hit.Ng(j),geomID,primID);
+            }
+            return foundhit;
+          }
+
           /* intersection filter test */
 #if defined(EMBREE_INTERSECTION_FILTER)
+          /* skip all hits rejected by the built-in filters */
+          if (filter && unlikely(geometry->hasBuiltinFilters()))
+          {
+            while (true)
+            {
+              const Vec2f uv = hit.uv(i);
+              if (runBuiltinFilter1(geometry,ray.mask,primID,uv.x,uv.y)) break;
+              clear(valid,i);
+              if (unlikely(none(valid))) return false;
+              i = select_min(valid,hit.vt);
+            }
+          }
+
           if (unlikely(geometry->hasIntersectionFilter1())) 
           {
             bool foundhit = false;
@@ -446,7 +565,8 @@ namespace embree
             {
               /* call intersection filter function */
               Vec2f uv = hit.uv(i);
-              foundhit |= runIntersectionFilter1(geometry,ray,context,uv.x,uv.y,hit.t(i),hit.Ng(i),geomID,primID);
+              if (!geometry->hasBuiltinFilters() || runBuiltinFilter1(geometry,ray.mask,primID,uv.x,uv.y))
+                foundhit |= runIntersectionFilter1(geometry,ray,context,uv.x,uv.y,hit.t(i),hit.Ng(i),geomID,primID);
               clear(valid,i);
               valid &= hit.vt <= ray.tfar; // intersection filters may modify tfar value
               if (unlikely(none(valid))) break;
@@ -467,6 +587,8 @@ namespace embree
           ray.Ng.z = Ng.z;
           ray.geomID = geomID;
           ray.primID = primID;
+          if (unlikely(context->rayCone != nullptr))
+            context->rayCone->record(hit.vt[i],Ng,context->scene->get(geomID));
           return true;
         }
       };
@@ -497,12 +619,25 @@ namespace embree
           
           /* intersection filter test */
 #if defined(EMBREE_INTERSECTION_FILTER)
+          /* at least one hit has to pass the built-in filters */
+          if (filter && unlikely(geometry->hasBuiltinFilters() && !geometry->hasOcclusionFilter1()))
+          {
+            hit.finalize();
+            for (size_t m=movemask(valid), i=__bsf(m); m!=0; m=__btc(m,i), i=__bsf(m))
+            {
+              const Vec2f uv = hit.uv(i);
+              if (runBuiltinFilter1(geometry,ray.mask,primID,uv.x,uv.y)) return true;
+            }
+            return false;
+          }
+
           if (unlikely(geometry->hasOcclusionFilter1())) 
           {
             hit.finalize();
             for (size_t m=movemask(valid), i=__bsf(m); m!=0; m=__btc(m,i), i=__bsf(m)) 
             {  
               const Vec2f uv = hit.uv(i);
+              if (geometry->hasBuiltinFilters() && !runBuiltinFilter1(geometry,ray.mask,primID,uv.x,uv.y)) continue;
               if (runOcclusionFilter1(geometry,ray,context,uv.x,uv.y,hit.t(i),hit.Ng(i),geomID,primID)) return true;
             }
             return false;
@@ -549,9 +684,29 @@ namespace embree
           if (unlikely(none(valid))) return false;
 #endif
           
+          /* collect hits in multi-hit mode */
+          if (unlikely(context->multiHits != nullptr))
+          {
+#if defined(EMBREE_INTERSECTION_FILTER)
+            if (filter && unlikely(geometry->hasBuiltinFilters()))
+              valid = runBuiltinFilter(valid,geometry,ray.mask,primID,u,v);
+#endif
+            for (size_t m=movemask(valid), k=__bsf(m); m!=0; m=__btc(m,k), k=__bsf(m))
+            {
+              const Vec3fa Ngk(Ng.x[k],Ng.y[k],Ng.z[k]);
+              if (!recordMultiHit<false>(context->multiHits[k],ray.tfar[k],context,ray.mask[k],t[k],u[k],v[k],Ngk,geomID,primID))
+                clear(valid,k);
+            }
+            return valid;
+          }
+
           /* occlusion filter test */
 #if defined(EMBREE_INTERSECTION_FILTER)
           if (filter) {
+            if (unlikely(geometry->hasBuiltinFilters())) {
+              valid = runBuiltinFilter(valid,geometry,ray.mask,primID,u,v);
+              if (unlikely(none(valid))) return false;
+            }
             if (unlikely(geometry->hasIntersectionFilter<vfloat<K>>())) {
               return runIntersectionFilter(valid,geometry,ray,context,u,v,t,Ng,geomID,primID);
             }
@@ -607,12 +762,15 @@ namespace embree
           /* intersection filter test */
 #if defined(EMBREE_INTERSECTION_FILTER)
           if (filter) {
-            if (unlikely(geometry->hasOcclusionFilter<vfloat<K>>()))
+            if (unlikely(geometry->hasBuiltinFilters() || geometry->hasOcclusionFilter<vfloat<K>>()))
             {
               vfloat<K> u, v, t; 
               Vec3vf<K> Ng;
               std::tie(u,v,t,Ng) = hit();
-              valid = runOcclusionFilter(valid,geometry,ray,context,u,v,t,Ng,geomID,primID);
+              if (geometry->hasBuiltinFilters())
+                valid = runBuiltinFilter(valid,geometry,ray.mask,primID,u,v);
+              if (geometry->hasOcclusionFilter<vfloat<K>>() && any(valid))
+                valid = runOcclusionFilter(valid,geometry,ray,context,u,v,t,Ng,geomID,primID);
             }
           }
 #endif
@@ -654,9 +812,29 @@ namespace embree
           if (unlikely(none(valid))) return false;
 #endif
           
+          /* collect hits in multi-hit mode */
+          if (unlikely(context->multiHits != nullptr))
+          {
+#if defined(EMBREE_INTERSECTION_FILTER)
+            if (filter && unlikely(geometry->hasBuiltinFilters()))
+              valid = runBuiltinFilter(valid,geometry,ray.mask,primID,u,v);
+#endif
+            for (size_t m=movemask(valid), k=__bsf(m); m!=0; m=__btc(m,k), k=__bsf(m))
+            {
+              const Vec3fa Ngk(Ng.x[k],Ng.y[k],Ng.z[k]);
+              if (!recordMultiHit<false>(context->multiHits[k],ray.tfar[k],context,ray.mask[k],t[k],u[k],v[k],Ngk,geomID,primID))
+                clear(valid,k);
+            }
+            return valid;
+          }
+
           /* intersection filter test */
 #if defined(EMBREE_INTERSECTION_FILTER)
           if (filter) {
+            if (unlikely(geometry->hasBuiltinFilters())) {
+              valid = runBuiltinFilter(valid,geometry,ray.mask,primID,u,v);
+              if (unlikely(none(valid))) return false;
+            }
             if (unlikely(geometry->hasIntersectionFilter<vfloat<K>>())) {
               return runIntersectionFilter(valid,geometry,ray,context,u,v,t,Ng,geomID,primID);
             }
@@ -707,12 +885,15 @@ namespace embree
           /* occlusion filter test */
 #if defined(EMBREE_INTERSECTION_FILTER)
           if (filter) {
-            if (unlikely(geometry->hasOcclusionFilter<vfloat<K>>()))
+            if (unlikely(geometry->hasBuiltinFilters() || geometry->hasOcclusionFilter<vfloat<K>>()))
             {
               vfloat<K> u, v, t; 
               Vec3vf<K> Ng;
               std::tie(u,v,t,Ng) = hit();
-              valid = runOcclusionFilter(valid,geometry,ray,context,u,v,t,Ng,geomID,primID);
+              if (geometry->hasBuiltinFilters())
+                valid = runBuiltinFilter(valid,geometry,ray.mask,primID,u,v);
+              if (geometry->hasOcclusionFilter<vfloat<K>>() && any(valid))
+                valid = runOcclusionFilter(valid,geometry,ray,context,u,v,t,Ng,geomID,primID);
             }
           }
 #endif
@@ -751,6 +932,17 @@ namespace embree
           assert(i<M);
           int geomID = Leaf::decodeID(geomIDs[i]);
           
+          /* collect all hits of the leaf in multi-hit mode */
+          if (unlikely(context->multiHits != nullptr))
+          {
+            bool foundhit = false;
+            for (size_t m=movemask(valid), j=__bsf(m); m!=0; m=__btc(m,j), j=__bsf(m)) {
+              const Vec2f uv = hit.uv(j);
+              foundhit |= recordMultiHit<filter>(context->multiHits[k],ray.tfar[k],context,ray.mask[k],hit.t(j),uv.x,uv.y,hit.Ng(j),Leaf::decodeID(geomIDs[j]),primIDs[j]);
+            }
+            return foundhit;
+          }
+
           /* intersection filter test */
 #if defined(EMBREE_INTERSECTION_FILTER) || defined(EMBREE_RAY_MASK)
           bool foundhit = false;
@@ -776,6 +968,14 @@ namespace embree
 #if defined(EMBREE_INTERSECTION_FILTER) 
             /* call intersection filter function */
             if (filter) {
+              /* goto next hit if built-in filters reject the hit */
+              if (unlikely(geometry->hasBuiltinFilters())) {
+                const Vec2f uv = hit.uv(i);
+                if (!runBuiltinFilter1(geometry,ray.mask[k],primIDs[i],uv.x,uv.y)) {
+                  clear(valid,i);
+                  continue;
+                }
+              }
               if (unlikely(geometry->hasIntersectionFilter<vfloat<K>>())) {
                 assert(i<M);
                 const Vec2f uv = hit.uv(i);
@@ -857,6 +1057,14 @@ namespace embree
 #if defined(EMBREE_INTERSECTION_FILTER)
             /* execute occlusion filer */
             if (filter) {
+              /* goto next hit if built-in filters reject the hit */
+              if (unlikely(geometry->hasBuiltinFilters())) {
+                const Vec2f uv = hit.uv(i);
+                if (!runBuiltinFilter1(geometry,ray.mask[k],primIDs[i],uv.x,uv.y)) {
+                  m=__btc(m,i);
+                  continue;
+                }
+              }
               if (unlikely(geometry->hasOcclusionFilter<vfloat<K>>())) 
               {
                 const Vec2f uv = hit.uv(i);
@@ -905,8 +1113,32 @@ namespace embree
           hit.finalize();
           size_t i = select_min(valid,hit.vt);
           
+          /* collect all hits of the leaf in multi-hit mode */
+          if (unlikely(context->multiHits != nullptr))
+          {
+            bool foundhit = false;
+            for (size_t m=movemask(valid), j=__bsf(m); m!=0; m=__btc(m,j), j=__bsf(m)) {
+              const Vec2f uv = hit.uv(j);
+              foundhit |= recordMultiHit<filter>(context->multiHits[k],ray.tfar[k],context,ray.mask[k],hit.t(j),uv.x,uv.y,hit.Ng(j),geomID,primID);
+            }
+            return foundhit;
+          }
+
           /* intersection filter test */
 #if defined(EMBREE_INTERSECTION_FILTER)
+          /* skip all hits rejected by the built-in filters */
+          if (filter && unlikely(geometry->hasBuiltinFilters()))
+          {
+            while (true)
+            {
+              const Vec2f uv = hit.uv(i);
+              if (runBuiltinFilter1(geometry,ray.mask[k],primID,uv.x,uv.y)) break;
+              clear(valid,i);
+              if (unlikely(none(valid))) return false;
+              i = select_min(valid,hit.vt);
+            }
+          }
+
           if (filter) {
             if (unlikely(geometry->hasIntersectionFilter<vfloat<K>>())) 
             {
@@ -914,7 +1146,8 @@ namespace embree
               while (true) 
               {
                 const Vec2f uv = hit.uv(i);
-                foundhit = foundhit | runIntersectionFilter(geometry,ray,k,context,uv.x,uv.y,hit.t(i),hit.Ng(i),geomID,primID);
+                if (!geometry->hasBuiltinFilters() || runBuiltinFilter1(geometry,ray.mask[k],primID,uv.x,uv.y))
+                  foundhit = foundhit | runIntersectionFilter(geometry,ray,k,context,uv.x,uv.y,hit.t(i),hit.Ng(i),geomID,primID);
                 clear(valid,i);
                 valid &= hit.vt <= ray.tfar[k]; // intersection filters may modify tfar value
                 if (unlikely(none(valid))) break;
@@ -973,6 +1206,18 @@ namespace embree
 
           /* intersection filter test */
 #if defined(EMBREE_INTERSECTION_FILTER)
+          /* at least one hit has to pass the built-in filters */
+          if (filter && unlikely(geometry->hasBuiltinFilters() && !geometry->hasOcclusionFilter<vfloat<K>>()))
+          {
+            hit.finalize();
+            for (size_t m=movemask(valid_i), i=__bsf(m); m!=0; m=__btc(m,i), i=__bsf(m))
+            {
+              const Vec2f uv = hit.uv(i);
+              if (runBuiltinFilter1(geometry,ray.mask[k],primID,uv.x,uv.y)) return true;
+            }
+            return false;
+          }
+
           if (filter) {
             if (unlikely(geometry->hasOcclusionFilter<vfloat<K>>())) 
             {
@@ -980,6 +1225,7 @@ namespace embree
               for (size_t m=movemask(valid_i), i=__bsf(m); m!=0; m=__btc(m,i), i=__bsf(m))
               {  
                 const Vec2f uv = hit.uv(i);
+                if (geometry->hasBuiltinFilters() && !runBuiltinFilter1(geometry,ray.mask[k],primID,uv.x,uv.y)) continue;
                 if (runOcclusionFilter(geometry,ray,k,context,uv.x,uv.y,hit.t(i),hit.Ng(i),geomID,primID)) return true;
               }
               return false;
@@ -22,8 +22,10 @@
 #include "trianglev.h"
 #include "trianglev_mb.h"
 #include "trianglei.h"
+#include "trianglec.h"
 #include "quadv.h"
 #include "quadi.h"
+#include "quadc.h"
 #include "subdivpatch1cached.h"
 #include "object.h"
 
@@ -123,6 +125,22 @@ namespace embree
     return ((Triangle4i*)This)->last();
   }
   
+  /********************** Triangle4c **************************/
+
+  template<>
+  Triangle4c::Type::Type ()
+    : PrimitiveType("triangle4c",sizeof(Triangle4c),4,4,false) {}
+
+  template<>
+  size_t Triangle4c::Type::size(const char* This) const {
+    return ((Triangle4c*)This)->size();
+  }
+
+  template<>
+  bool Triangle4c::Type::last(const char* This) const {
+    return ((Triangle4c*)This)->last();
+  }
+  
   /********************** Triangle4vMB **************************/
 
   template<>
@@ -171,6 +189,22 @@ namespace embree
     return ((Quad4i*)This)->last();
   }
 
+  /********************** Quad4c **************************/
+
+  template<>
+  Quad4c::Type::Type ()
+    : PrimitiveType("quad4c",sizeof(Quad4c),4,4,false) {}
+
+  template<>
+  size_t Quad4c::Type::size(const char* This) const {
+    return ((Quad4c*)This)->size();
+  }
+
+  template<>
+  bool Quad4c::Type::last(const char* This) const {
+    return ((Quad4c*)This)->last();
+  }
+
   /********************** SubdivPatch1 **************************/
 
   SubdivPatch1Cached::Type::Type ()
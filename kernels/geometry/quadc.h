@@ -0,0 +1,287 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "primitive.h"
+#include "quadi.h"
+#include "../common/scene.h"
+#include "../common/vertex_format.h"
+
+namespace embree
+{
+  /* Stores M quads from an indexed face set in compressed form. The
+   * premultiplied offset of the first vertex is stored per lane, the
+   * other three vertices are stored as 16 bit deltas to the first
+   * one. Lanes whose deltas do not fit into 16 bits are marked as
+   * escaped and gather their vertex offsets from the index buffer. */
+  template <int M>
+  struct QuadMc
+  {
+    /* Virtual interface to query information about the quad type */
+    struct Type : public PrimitiveType
+    {
+      Type();
+      size_t size(const char* This) const;
+      bool last(const char* This) const;
+    };
+    static Type type;
+    static const Leaf::Type leaf_type = Leaf::TY_QUAD;
+
+    /* marks a delta that does not fit into 16 bits */
+    static const int ESCAPE = -32768;
+
+  public:
+
+    /* primitive supports multiple time segments */
+    static const bool singleTimeSegment = false;
+
+    /* Returns maximal number of stored quads */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N primitives */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+    /* Encodes the delta between two premultiplied vertex offsets */
+    static __forceinline int16_t encodeDelta(int o0, int o1)
+    {
+      const int d = o1-o0;
+      if (d <= ESCAPE || d > 32767) return (int16_t) ESCAPE;
+      return (int16_t) d;
+    }
+
+    /* Sign extends the 16 bit deltas */
+    static __forceinline vint<M> decodeDeltas(const int16_t* d);
+
+  public:
+
+    /* Default constructor */
+    __forceinline QuadMc() {  }
+
+    /* Construction from vertices and IDs */
+    __forceinline QuadMc(const vint<M>& v0,
+                         const vint<M>& v1,
+                         const vint<M>& v2,
+                         const vint<M>& v3,
+                         const vint<M>& geomIDs,
+                         const vint<M>& primIDs,
+                         const Leaf::Type ty,
+                         const bool last)
+      : geomIDs(Leaf::vencode(ty,geomIDs,last)), primIDs(primIDs), v0(v0)
+    {
+      for (size_t i=0; i<M; i++) {
+        d1[i] = encodeDelta(v0[i],v1[i]);
+        d2[i] = encodeDelta(v0[i],v2[i]);
+        d3[i] = encodeDelta(v0[i],v3[i]);
+      }
+    }
+
+    /* Returns a mask that tells which quads are valid */
+    __forceinline vbool<M> valid() const { return primIDs != vint<M>(-1); }
+
+    /* Returns if the specified quad is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return primIDs[i] != -1; }
+
+    /* Returns the number of stored quads */
+    __forceinline size_t size() const { return __bsf(~movemask(valid())); }
+
+    /*! checks if this is the last primitive */
+    __forceinline unsigned last() const { return Leaf::decodeLast(geomIDs[0]); }
+
+    /* Returns the geometry IDs */
+    __forceinline const vint<M>& geomID() const { return geomIDs; }
+    __forceinline unsigned geomID(const size_t i) const { assert(i<M); return Leaf::decodeID(geomIDs[i]); }
+
+    /* Returns the primitive IDs */
+    __forceinline const vint<M>& primID() const { return primIDs; }
+    __forceinline unsigned primID(const size_t i) const { assert(i<M); return primIDs[i]; }
+
+    /* Decodes the premultiplied offsets of the 2nd, 3rd and 4th vertex of all quads */
+    __forceinline void offsets(vint<M>& o1, vint<M>& o2, vint<M>& o3, const Scene* const scene) const
+    {
+      const vint<M> e1 = decodeDeltas(d1);
+      const vint<M> e2 = decodeDeltas(d2);
+      const vint<M> e3 = decodeDeltas(d3);
+      o1 = v0 + e1;
+      o2 = v0 + e2;
+      o3 = v0 + e3;
+
+      const vbool<M> escaped = ((e1 == vint<M>(ESCAPE)) | (e2 == vint<M>(ESCAPE)) | (e3 == vint<M>(ESCAPE))) & valid();
+      if (likely(none(escaped))) return;
+      for (size_t m=movemask(escaped), i=__bsf(m); m!=0; m=__btc(m,i), i=__bsf(m))
+      {
+        const QuadMesh* mesh = scene->get<QuadMesh>(geomID(i));
+        const QuadMesh::Quad& q = mesh->quad(primID(i));
+        const unsigned int_stride = mesh->vertices0.getStride()/4;
+        o1[i] = q.v[1] * int_stride;
+        o2[i] = q.v[2] * int_stride;
+        o3[i] = q.v[3] * int_stride;
+      }
+    }
+
+    /* Returns the premultiplied offset of the vid'th vertex of the i'th quad */
+    __forceinline int offset(const size_t vid, const size_t i, const Scene* const scene) const
+    {
+      if (vid == 0) return v0[i];
+      const int d = vid == 1 ? d1[i] : vid == 2 ? d2[i] : d3[i];
+      if (likely(d != ESCAPE)) return v0[i] + d;
+      const QuadMesh* mesh = scene->get<QuadMesh>(geomID(i));
+      return mesh->quad(primID(i)).v[vid] * int(mesh->vertices0.getStride()/4);
+    }
+
+    /* loads a single vertex */
+    template<int vid>
+    __forceinline Vec3f getVertex(const size_t index, const Scene* const scene) const
+    {
+      const int* vertices = scene->vertices[geomID(index)];
+      const vfloat4 v = QuadMi<M>::loadGatherVertex(scene,geomID(index),vertices,offset(vid,index,scene));
+      return Vec3f(v[0],v[1],v[2]);
+    }
+
+    /* Gather the quads */
+    __forceinline void gather(Vec3vf<M>& p0, Vec3vf<M>& p1, Vec3vf<M>& p2, Vec3vf<M>& p3, const Scene* const scene) const;
+
+    /* Non-temporal store */
+    __forceinline static void store_nt(QuadMc* dst, const QuadMc& src)
+    {
+      vint<M>::store_nt(&dst->geomIDs,src.geomIDs);
+      vint<M>::store_nt(&dst->primIDs,src.primIDs);
+      vint<M>::store_nt(&dst->v0,src.v0);
+      for (size_t i=0; i<M; i++) {
+        dst->d1[i] = src.d1[i];
+        dst->d2[i] = src.d2[i];
+        dst->d3[i] = src.d3[i];
+      }
+    }
+
+    /* Fill quad from quad list */
+    template<typename PrimRefT>
+    __forceinline void fill(const PrimRefT* prims, size_t& begin, size_t end, Scene* scene, bool last)
+    {
+      vint<M> geomID = -1, primID = -1;
+      vint<M> v0 = zero, v1 = zero, v2 = zero, v3 = zero;
+      const PrimRefT* prim = &prims[begin];
+
+      for (size_t i=0; i<M; i++)
+      {
+        const QuadMesh* mesh = scene->get<QuadMesh>(prim->geomID());
+        const QuadMesh::Quad& q = mesh->quad(prim->primID());
+        if (begin<end) {
+          geomID[i] = prim->geomID();
+          primID[i] = prim->primID();
+          unsigned int_stride = mesh->vertices0.getStride()/4;
+          v0[i] = q.v[0] * int_stride;
+          v1[i] = q.v[1] * int_stride;
+          v2[i] = q.v[2] * int_stride;
+          v3[i] = q.v[3] * int_stride;
+          begin++;
+        } else {
+          assert(i);
+          if (likely(i > 0)) {
+            geomID[i] = geomID[0]; // always valid geomIDs
+            primID[i] = -1;        // indicates invalid data
+            v0[i] = v0[0];
+            v1[i] = v0[0];
+            v2[i] = v0[0];
+            v3[i] = v0[0];
+          }
+        }
+        if (begin<end) prim = &prims[begin];
+      }
+
+      new (this) QuadMc(v0,v1,v2,v3,geomID,primID,Leaf::TY_QUAD,last);
+    }
+
+    template<typename BVH>
+    __forceinline static typename BVH::NodeRef createLeaf(const FastAllocator::CachedAllocator& alloc, PrimRef* prims, const range<size_t>& range, BVH* bvh)
+    {
+      size_t cur = range.begin();
+      size_t items = blocks(range.size());
+      QuadMc* accel = (QuadMc*) alloc.malloc1(items*sizeof(QuadMc),BVH::byteAlignment);
+      for (size_t i=0; i<items; i++) {
+        accel[i].fill(prims,cur,range.end(),bvh->scene,i==(items-1));
+      }
+      return BVH::encodeLeaf((char*)accel,Leaf::TY_QUAD);
+    }
+
+    /* Updates the primitive */
+    __forceinline BBox3fa update(QuadMesh* mesh)
+    {
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<M; i++)
+      {
+        if (!valid(i)) break;
+        const unsigned primId = primID(i);
+        const QuadMesh::Quad& q = mesh->quad(primId);
+        const Vec3fa p0 = mesh->vertex(q.v[0]);
+        const Vec3fa p1 = mesh->vertex(q.v[1]);
+        const Vec3fa p2 = mesh->vertex(q.v[2]);
+        const Vec3fa p3 = mesh->vertex(q.v[3]);
+        bounds.extend(merge(BBox3fa(p0),BBox3fa(p1),BBox3fa(p2),BBox3fa(p3)));
+      }
+      return bounds;
+    }
+
+  public:
+    vint<M> geomIDs;    // geometry ID of mesh
+    vint<M> primIDs;    // primitive ID of primitive inside mesh
+    vint<M> v0;         // 4 byte offset of 1st vertex
+    int16_t d1[M];      // delta of the 4 byte offset of the 2nd vertex to the 1st one
+    int16_t d2[M];      // delta of the 4 byte offset of the 3rd vertex to the 1st one
+    int16_t d3[M];      // delta of the 4 byte offset of the 4th vertex to the 1st one
+  };
+
+  template<int M>
+  __forceinline vint<M> QuadMc<M>::decodeDeltas(const int16_t* d)
+  {
+    vint<M> r;
+    for (size_t i=0; i<M; i++) r[i] = d[i];
+    return r;
+  }
+
+  template<>
+  __forceinline vint4 QuadMc<4>::decodeDeltas(const int16_t* d) {
+    return loadShort4(d);
+  }
+
+  template<>
+  __forceinline void QuadMc<4>::gather(Vec3vf4& p0,
+                                       Vec3vf4& p1,
+                                       Vec3vf4& p2,
+                                       Vec3vf4& p3,
+                                       const Scene *const scene) const
+  {
+    prefetchL1(((char*)this)+0*64);
+    prefetchL1(((char*)this)+1*64);
+    vint4 o1, o2, o3; offsets(o1,o2,o3,scene);
+    const int* vertices0 = scene->vertices[Leaf::decodeID(geomIDs[0])];
+    const int* vertices1 = scene->vertices[geomIDs[1]];
+    const int* vertices2 = scene->vertices[geomIDs[2]];
+    const int* vertices3 = scene->vertices[geomIDs[3]];
+    const vfloat4 a0 = Quad4i::loadGatherVertex(scene,Leaf::decodeID(geomIDs[0]),vertices0,v0[0]);
+    const vfloat4 a1 = Quad4i::loadGatherVertex(scene,geomIDs[1],vertices1,v0[1]);
+    const vfloat4 a2 = Quad4i::loadGatherVertex(scene,geomIDs[2],vertices2,v0[2]);
+    const vfloat4 a3 = Quad4i::loadGatherVertex(scene,geomIDs[3],vertices3,v0[3]);
+    const vfloat4 b0 = Quad4i::loadGatherVertex(scene,Leaf::decodeID(geomIDs[0]),vertices0,o1[0]);
+    const vfloat4 b1 = Quad4i::loadGatherVertex(scene,geomIDs[1],vertices1,o1[1]);
+    const vfloat4 b2 = Quad4i::loadGatherVertex(scene,geomIDs[2],vertices2,o1[2]);
+    const vfloat4 b3 = Quad4i::loadGatherVertex(scene,geomIDs[3],vertices3,o1[3]);
+    const vfloat4 c0 = Quad4i::loadGatherVertex(scene,Leaf::decodeID(geomIDs[0]),vertices0,o2[0]);
+    const vfloat4 c1 = Quad4i::loadGatherVertex(scene,geomIDs[1],vertices1,o2[1]);
+    const vfloat4 c2 = Quad4i::loadGatherVertex(scene,geomIDs[2],vertices2,o2[2]);
+    const vfloat4 c3 = Quad4i::loadGatherVertex(scene,geomIDs[3],vertices3,o2[3]);
+    const vfloat4 d0 = Quad4i::loadGatherVertex(scene,Leaf::decodeID(geomIDs[0]),vertices0,o3[0]);
+    const vfloat4 d1 = Quad4i::loadGatherVertex(scene,geomIDs[1],vertices1,o3[1]);
+    const vfloat4 d2 = Quad4i::loadGatherVertex(scene,geomIDs[2],vertices2,o3[2]);
+    const vfloat4 d3 = Quad4i::loadGatherVertex(scene,geomIDs[3],vertices3,o3[3]);
+    transpose(a0,a1,a2,a3,p0.x,p0.y,p0.z);
+    transpose(b0,b1,b2,b3,p1.x,p1.y,p1.z);
+    transpose(c0,c1,c2,c3,p2.x,p2.y,p2.z);
+    transpose(d0,d1,d2,d3,p3.x,p3.y,p3.z);
+  }
+
+  template<int M>
+  typename QuadMc<M>::Type QuadMc<M>::type;
+
+  typedef QuadMc<4> Quad4c;
+}
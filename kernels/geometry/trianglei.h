@@ -92,10 +92,17 @@ namespace embree
     __forceinline Vec3<T> getVertex(const vint<M>& v, const size_t index, const Scene *const scene, const size_t itime, const T& ftime) const
     {
       const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(index));
-      const int* vertices0 = (const int*) mesh->vertexPtr(0,itime+0);
-      const int* vertices1 = (const int*) mesh->vertexPtr(0,itime+1);
-      const Vec3fa v0 = Vec3fa::loadu(vertices0+v[index]);
-      const Vec3fa v1 = Vec3fa::loadu(vertices1+v[index]);
+      Vec3fa v0, v1;
+      if (likely(!mesh->hasCompressedMotion() && !mesh->hasCompactVertices())) {
+        const int* vertices0 = (const int*) mesh->vertexPtr(0,itime+0);
+        const int* vertices1 = (const int*) mesh->vertexPtr(0,itime+1);
+        v0 = Vec3fa::loadu(vertices0+v[index]);
+        v1 = Vec3fa::loadu(vertices1+v[index]);
+      } else {
+        const size_t vid = v[index]/(mesh->vertices0.getStride()/4);
+        v0 = mesh->vertex(vid,itime+0);
+        v1 = mesh->vertex(vid,itime+1);
+      }
       const Vec3<T> p0(v0.x,v0.y,v0.z);
       const Vec3<T> p1(v1.x,v1.y,v1.z);
       return lerp(p0,p1,ftime);
@@ -109,10 +116,17 @@ namespace embree
 
       for (size_t mask=movemask(valid), i=__bsf(mask); mask; mask=__btc(mask,i), i=__bsf(mask))
       {
-        const int* vertices0 = (const int*) mesh->vertexPtr(0,itime[i]+0);
-        const int* vertices1 = (const int*) mesh->vertexPtr(0,itime[i]+1);
-        const Vec3fa v0 = Vec3fa::loadu(vertices0+v[index]);
-        const Vec3fa v1 = Vec3fa::loadu(vertices1+v[index]);
+        Vec3fa v0, v1;
+        if (likely(!mesh->hasCompressedMotion() && !mesh->hasCompactVertices())) {
+          const int* vertices0 = (const int*) mesh->vertexPtr(0,itime[i]+0);
+          const int* vertices1 = (const int*) mesh->vertexPtr(0,itime[i]+1);
+          v0 = Vec3fa::loadu(vertices0+v[index]);
+          v1 = Vec3fa::loadu(vertices1+v[index]);
+        } else {
+          const size_t vid = v[index]/(mesh->vertices0.getStride()/4);
+          v0 = mesh->vertex(vid,itime[i]+0);
+          v1 = mesh->vertex(vid,itime[i]+1);
+        }
         p0.x[i] = v0.x; p0.y[i] = v0.y; p0.z[i] = v0.z;
         p1.x[i] = v1.x; p1.y[i] = v1.y; p1.z[i] = v1.z;
       }
@@ -134,7 +148,7 @@ namespace embree
       const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(index));
 
       vfloat<K> ftime;
-      const vint<K> itime = getTimeSegment(time, vfloat<K>(mesh->fnumTimeSegments), ftime);
+      const vint<K> itime = mesh->timeSegment(time, ftime);
 
       const size_t first = __bsf(movemask(valid));
       if (likely(all(valid,itime[first] == itime)))
@@ -164,16 +178,38 @@ namespace embree
                               const Scene *const scene,
                               const float time) const;
 
+    /* loads a vertex for the static gathers, vertices are only decoded if some mesh of the scene stores them compactly */
+    static __forceinline vfloat4 loadGatherVertex(const Scene* scene, unsigned geomID, const int* vertices, int offset)
+    {
+      if (likely(!scene->compactVertices)) return vfloat4::loadu(vertices+offset);
+      return scene->get<TriangleMesh>(geomID)->loadVertex((const char*)(vertices+offset));
+    }
+
+    /* loads a vertex for the motion blur gathers, compact and compressed vertices get decoded */
+    static __forceinline vfloat4 loadGatherVertex(const TriangleMesh* mesh, const int* vertices, int offset, int itime)
+    {
+      if (likely(!mesh->hasCompressedMotion() && !mesh->hasCompactVertices())) return vfloat4::loadu(vertices+offset);
+      return (vfloat4) mesh->vertex(offset/(mesh->vertices0.getStride()/4),itime);
+    }
+
+    /* loads the vertex at some premultiplied offset of the itime'th time step */
+    static __forceinline Vec3fa loadVertex(const TriangleMesh* mesh, int offset, size_t itime)
+    {
+      const int* vertices = (const int*) mesh->vertexPtr(0,itime);
+      if (unlikely(mesh->hasCompactVertices())) return Vec3fa(mesh->loadVertex((const char*)(vertices+offset)));
+      return Vec3fa::loadu(vertices+offset);
+    }
+
      /* returns area of quads */
     __forceinline float area(const Scene* scene, const size_t itime=0)
     {
       float A = 0.0f;
       for (size_t i=0; i<M && valid(i); i++)
       {
-        const int* vertices = (const int*) scene->get<TriangleMesh>(geomID(i))->vertexPtr(0,itime);
-        const Vec3fa p0 = Vec3fa::loadu(vertices+v0[i]);
-        const Vec3fa p1 = Vec3fa::loadu(vertices+v1[i]);
-        const Vec3fa p2 = Vec3fa::loadu(vertices+v2[i]);
+        const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(i));
+        const Vec3fa p0 = loadVertex(mesh,v0[i],itime);
+        const Vec3fa p1 = loadVertex(mesh,v1[i],itime);
+        const Vec3fa p2 = loadVertex(mesh,v2[i],itime);
         A += 0.5f*length(cross(p1-p0,p2-p0));
       }
       return A;
@@ -185,10 +221,10 @@ namespace embree
       BBox3fa bounds = empty;
       for (size_t i=0; i<M && valid(i); i++)
       {
-        const int* vertices = (const int*) scene->get<TriangleMesh>(geomID(i))->vertexPtr(0,itime);
-        bounds.extend(Vec3fa::loadu(vertices+v0[i]));
-        bounds.extend(Vec3fa::loadu(vertices+v1[i]));
-        bounds.extend(Vec3fa::loadu(vertices+v2[i]));
+        const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(i));
+        bounds.extend(loadVertex(mesh,v0[i],itime));
+        bounds.extend(loadVertex(mesh,v1[i],itime));
+        bounds.extend(loadVertex(mesh,v2[i],itime));
       }
       return bounds;
     }
@@ -372,18 +408,18 @@ namespace embree
     const int* vertices1 = scene->vertices[geomIDs[1]];
     const int* vertices2 = scene->vertices[geomIDs[2]];
     const int* vertices3 = scene->vertices[geomIDs[3]];
-    const vfloat4 a0 = vfloat4::loadu(vertices0 + v0[0]);
-    const vfloat4 a1 = vfloat4::loadu(vertices1 + v0[1]);
-    const vfloat4 a2 = vfloat4::loadu(vertices2 + v0[2]);
-    const vfloat4 a3 = vfloat4::loadu(vertices3 + v0[3]);
-    const vfloat4 b0 = vfloat4::loadu(vertices0 + v1[0]);
-    const vfloat4 b1 = vfloat4::loadu(vertices1 + v1[1]);
-    const vfloat4 b2 = vfloat4::loadu(vertices2 + v1[2]);
-    const vfloat4 b3 = vfloat4::loadu(vertices3 + v1[3]);
-    const vfloat4 c0 = vfloat4::loadu(vertices0 + v2[0]);
-    const vfloat4 c1 = vfloat4::loadu(vertices1 + v2[1]);
-    const vfloat4 c2 = vfloat4::loadu(vertices2 + v2[2]);
-    const vfloat4 c3 = vfloat4::loadu(vertices3 + v2[3]);
+    const vfloat4 a0 = loadGatherVertex(scene,Leaf::decodeID(geomIDs[0]),vertices0,v0[0]);
+    const vfloat4 a1 = loadGatherVertex(scene,geomIDs[1],vertices1,v0[1]);
+    const vfloat4 a2 = loadGatherVertex(scene,geomIDs[2],vertices2,v0[2]);
+    const vfloat4 a3 = loadGatherVertex(scene,geomIDs[3],vertices3,v0[3]);
+    const vfloat4 b0 = loadGatherVertex(scene,Leaf::decodeID(geomIDs[0]),vertices0,v1[0]);
+    const vfloat4 b1 = loadGatherVertex(scene,geomIDs[1],vertices1,v1[1]);
+    const vfloat4 b2 = loadGatherVertex(scene,geomIDs[2],vertices2,v1[2]);
+    const vfloat4 b3 = loadGatherVertex(scene,geomIDs[3],vertices3,v1[3]);
+    const vfloat4 c0 = loadGatherVertex(scene,Leaf::decodeID(geomIDs[0]),vertices0,v2[0]);
+    const vfloat4 c1 = loadGatherVertex(scene,geomIDs[1],vertices1,v2[1]);
+    const vfloat4 c2 = loadGatherVertex(scene,geomIDs[2],vertices2,v2[2]);
+    const vfloat4 c3 = loadGatherVertex(scene,geomIDs[3],vertices3,v2[3]);
     transpose(a0,a1,a2,a3,p0.x,p0.y,p0.z);
     transpose(b0,b1,b2,b3,p1.x,p1.y,p1.z);
     transpose(c0,c1,c2,c3,p2.x,p2.y,p2.z);
@@ -403,18 +439,18 @@ namespace embree
     const int* vertices1 = (const int*) mesh1->vertexPtr(0,itime[1]);
     const int* vertices2 = (const int*) mesh2->vertexPtr(0,itime[2]);
     const int* vertices3 = (const int*) mesh3->vertexPtr(0,itime[3]);
-    const vfloat4 a0 = vfloat4::loadu(vertices0 + v0[0]);
-    const vfloat4 a1 = vfloat4::loadu(vertices1 + v0[1]);
-    const vfloat4 a2 = vfloat4::loadu(vertices2 + v0[2]);
-    const vfloat4 a3 = vfloat4::loadu(vertices3 + v0[3]);
-    const vfloat4 b0 = vfloat4::loadu(vertices0 + v1[0]);
-    const vfloat4 b1 = vfloat4::loadu(vertices1 + v1[1]);
-    const vfloat4 b2 = vfloat4::loadu(vertices2 + v1[2]);
-    const vfloat4 b3 = vfloat4::loadu(vertices3 + v1[3]);
-    const vfloat4 c0 = vfloat4::loadu(vertices0 + v2[0]);
-    const vfloat4 c1 = vfloat4::loadu(vertices1 + v2[1]);
-    const vfloat4 c2 = vfloat4::loadu(vertices2 + v2[2]);
-    const vfloat4 c3 = vfloat4::loadu(vertices3 + v2[3]);
+    const vfloat4 a0 = loadGatherVertex(mesh0,vertices0,v0[0],itime[0]);
+    const vfloat4 a1 = loadGatherVertex(mesh1,vertices1,v0[1],itime[1]);
+    const vfloat4 a2 = loadGatherVertex(mesh2,vertices2,v0[2],itime[2]);
+    const vfloat4 a3 = loadGatherVertex(mesh3,vertices3,v0[3],itime[3]);
+    const vfloat4 b0 = loadGatherVertex(mesh0,vertices0,v1[0],itime[0]);
+    const vfloat4 b1 = loadGatherVertex(mesh1,vertices1,v1[1],itime[1]);
+    const vfloat4 b2 = loadGatherVertex(mesh2,vertices2,v1[2],itime[2]);
+    const vfloat4 b3 = loadGatherVertex(mesh3,vertices3,v1[3],itime[3]);
+    const vfloat4 c0 = loadGatherVertex(mesh0,vertices0,v2[0],itime[0]);
+    const vfloat4 c1 = loadGatherVertex(mesh1,vertices1,v2[1],itime[1]);
+    const vfloat4 c2 = loadGatherVertex(mesh2,vertices2,v2[2],itime[2]);
+    const vfloat4 c3 = loadGatherVertex(mesh3,vertices3,v2[3],itime[3]);
     transpose(a0,a1,a2,a3,p0.x,p0.y,p0.z);
     transpose(b0,b1,b2,b3,p1.x,p1.y,p1.z);
     transpose(c0,c1,c2,c3,p2.x,p2.y,p2.z);
@@ -432,6 +468,24 @@ namespace embree
     const TriangleMesh* mesh2 = scene->get<TriangleMesh>(geomIDs[2]);
     const TriangleMesh* mesh3 = scene->get<TriangleMesh>(geomIDs[3]);
 
+    /* non-uniform time steps and compressed motion are gathered per triangle */
+    if (unlikely(!(mesh0->hasUncompressedUniformMotion() && mesh1->hasUncompressedUniformMotion() &&
+                   mesh2->hasUncompressedUniformMotion() && mesh3->hasUncompressedUniformMotion())))
+    {
+      const TriangleMesh* meshes[4] = { mesh0, mesh1, mesh2, mesh3 };
+      for (size_t i=0; i<4; i++)
+      {
+        const unsigned int_stride = meshes[i]->vertices0.getStride()/4;
+        const Vec3fa a = meshes[i]->interpolatedVertex(v0[i]/int_stride,time);
+        const Vec3fa b = meshes[i]->interpolatedVertex(v1[i]/int_stride,time);
+        const Vec3fa c = meshes[i]->interpolatedVertex(v2[i]/int_stride,time);
+        p0.x[i] = a.x; p0.y[i] = a.y; p0.z[i] = a.z;
+        p1.x[i] = b.x; p1.y[i] = b.y; p1.z[i] = b.z;
+        p2.x[i] = c.x; p2.y[i] = c.y; p2.z[i] = c.z;
+      }
+      return;
+    }
+
     const vfloat4 numTimeSegments(mesh0->fnumTimeSegments, mesh1->fnumTimeSegments, mesh2->fnumTimeSegments, mesh3->fnumTimeSegments);
     vfloat4 ftime;
     const vint4 itime = getTimeSegment(vfloat4(time), numTimeSegments, ftime);
@@ -77,18 +77,18 @@ namespace isa
     __forceinline vint<M> primID() const { return primIDs; }
     __forceinline int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
 
-    __forceinline Vec3fa& getVertex(const vint<M> &v, const size_t index, const Scene *const scene) const
+    __forceinline Vec3fa getVertex(const vint<M> &v, const size_t index, const Scene *const scene) const
     {
       const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(index));
-      return *(Vec3fa*)mesh->vertexPtr(v[index]);
+      return mesh->vertex(v[index]);
     }
 
     template<typename T>
       __forceinline Vec3<T> getVertex(const vint<M> &v, const size_t index, const Scene *const scene, const size_t itime, const T& ftime) const
     {
       const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(index));
-      const Vec3fa v0 = *(Vec3fa*)mesh->vertexPtr(v[index],itime+0);
-      const Vec3fa v1 = *(Vec3fa*)mesh->vertexPtr(v[index],itime+1);
+      const Vec3fa v0 = mesh->vertex(v[index],itime+0);
+      const Vec3fa v1 = mesh->vertex(v[index],itime+1);
       const Vec3<T> p0(v0.x,v0.y,v0.z);
       const Vec3<T> p1(v1.x,v1.y,v1.z);
       return lerp(p0,p1,ftime);
@@ -107,7 +107,7 @@ namespace isa
       const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(index));
 
       vfloat<K> ftime;
-      const vint<K> itime = getTimeSegment(time, vfloat<K>(mesh->fnumTimeSegments), ftime);
+      const vint<K> itime = mesh->timeSegment(time, ftime);
 
       const size_t first = __bsf(movemask(valid)); // assume itime is uniform
       p0 = getVertex(v0, index, scene, itime[first], ftime);
@@ -264,6 +264,23 @@ namespace isa
     const TriangleMesh* mesh2 = scene->get<TriangleMesh>(geomIDs[2]);
     const TriangleMesh* mesh3 = scene->get<TriangleMesh>(geomIDs[3]);
 
+    /* non-uniform time steps and compressed motion are gathered per triangle */
+    if (unlikely(!(mesh0->hasUncompressedUniformMotion() && mesh1->hasUncompressedUniformMotion() &&
+                   mesh2->hasUncompressedUniformMotion() && mesh3->hasUncompressedUniformMotion())))
+    {
+      const TriangleMesh* meshes[4] = { mesh0, mesh1, mesh2, mesh3 };
+      for (size_t i=0; i<4; i++)
+      {
+        const Vec3fa a = meshes[i]->interpolatedVertex(v0[i],time);
+        const Vec3fa b = meshes[i]->interpolatedVertex(v1[i],time);
+        const Vec3fa c = meshes[i]->interpolatedVertex(v2[i],time);
+        p0.x[i] = a.x; p0.y[i] = a.y; p0.z[i] = a.z;
+        p1.x[i] = b.x; p1.y[i] = b.y; p1.z[i] = b.z;
+        p2.x[i] = c.x; p2.y[i] = c.y; p2.z[i] = c.z;
+      }
+      return;
+    }
+
     const vfloat4 numTimeSegments(mesh0->fnumTimeSegments, mesh1->fnumTimeSegments, mesh2->fnumTimeSegments, mesh3->fnumTimeSegments);
     vfloat4 ftime;
     const vint4 itime = getTimeSegment(vfloat4(time), numTimeSegments, ftime);
@@ -1207,6 +1207,375 @@ namespace embree
     }
   };
 
+  struct MortonSplitBuildTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    MortonSplitBuildTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      /* a low threshold splits the upper levels of the ~80K triangle sphere in Morton order */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",morton_split_threshold=4096").c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+
+      const Vec3fa center = zero;
+      const float radius = 1.0f;
+      VerifyScene scene0(device0,sflags), scene1(device1,sflags);
+      scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(center,radius,200));
+      scene1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(center,radius,200));
+      rtcCommitScene (scene0);
+      AssertNoError(device0);
+      rtcCommitScene (scene1);
+      AssertNoError(device1);
+
+      /* both BVHs have to report the same closest hits */
+      for (size_t i=0; i<1024; i++)
+      {
+        const Vec3fa org = 2.0f*Vec3fa(2.0f*random_float()-1.0f,2.0f*random_float()-1.0f,2.0f*random_float()-1.0f);
+        const Vec3fa dir = Vec3fa(random_float()-0.5f,random_float()-0.5f,random_float()-0.5f)-org;
+        RTCRayHit ray0 = makeRay(org,dir);
+        RTCRayHit ray1 = makeRay(org,dir);
+        rtcIntersect1(scene0,&ray0);
+        rtcIntersect1(scene1,&ray1);
+        if (ray0.hit.geomID != ray1.hit.geomID) return VerifyApplication::FAILED;
+        if (ray0.hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        if (ray0.hit.primID != ray1.hit.primID) return VerifyApplication::FAILED;
+        if (ray0.ray.tfar != ray1.ray.tfar) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct BVHStreamTest : public VerifyApplication::Test
+  {
+    RTCBuildQuality quality;
+
+    BVHStreamTest (std::string name, int isa, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), quality(quality) {}
+
+    static const unsigned int MAX_CHILDREN = 8;
+
+    struct Node {
+      Node (bool leaf) : leaf(leaf) {}
+      bool leaf;
+    };
+
+    struct InnerNode : public Node
+    {
+      InnerNode () : Node(false), childCount(0) {}
+      unsigned int childCount;
+      Node* children[MAX_CHILDREN];
+      RTCBounds bounds[MAX_CHILDREN];
+    };
+
+    struct LeafNode : public Node
+    {
+      LeafNode () : Node(true), primCount(0) {}
+      size_t primCount;
+      unsigned int primIDs[RTC_BUILD_MAX_PRIMITIVES_PER_LEAF];
+    };
+
+    static void* createNode (RTCThreadLocalAllocator alloc, unsigned int childCount, void* userPtr)
+    {
+      if (childCount > MAX_CHILDREN) return nullptr;
+      void* ptr = rtcThreadLocalAlloc(alloc,sizeof(InnerNode),16);
+      return (void*) new (ptr) InnerNode;
+    }
+
+    static void setNodeChildren (void* nodePtr, void** children, unsigned int childCount, void* userPtr)
+    {
+      InnerNode* node = (InnerNode*) nodePtr;
+      node->childCount = childCount;
+      for (unsigned int i=0; i<childCount; i++)
+        node->children[i] = (Node*) children[i];
+    }
+
+    static void setNodeBounds (void* nodePtr, const RTCBounds** bounds, unsigned int childCount, void* userPtr)
+    {
+      InnerNode* node = (InnerNode*) nodePtr;
+      for (unsigned int i=0; i<childCount; i++)
+        node->bounds[i] = *bounds[i];
+    }
+
+    static void* createLeaf (RTCThreadLocalAllocator alloc, const RTCBuildPrimitive* prims, size_t numPrims, void* userPtr)
+    {
+      if (numPrims > RTC_BUILD_MAX_PRIMITIVES_PER_LEAF) return nullptr;
+      void* ptr = rtcThreadLocalAlloc(alloc,sizeof(LeafNode),16);
+      LeafNode* leaf = new (ptr) LeafNode;
+      leaf->primCount = numPrims;
+      for (size_t i=0; i<numPrims; i++)
+        leaf->primIDs[i] = prims[i].primID;
+      return (void*) leaf;
+    }
+
+    static bool inside (const RTCBounds& bounds, const RTCBuildPrimitive& prim)
+    {
+      return bounds.lower_x <= prim.lower_x && bounds.lower_y <= prim.lower_y && bounds.lower_z <= prim.lower_z &&
+             prim.upper_x <= bounds.upper_x && prim.upper_y <= bounds.upper_y && prim.upper_z <= bounds.upper_z;
+    }
+
+    /* counts how often each primitive is referenced and checks that it lies inside the bounds of all its ancestors */
+    static bool check (const Node* node, const RTCBounds& bounds, const std::vector<RTCBuildPrimitive>& prims, std::vector<unsigned int>& counts)
+    {
+      if (node == nullptr) return false;
+      if (node->leaf)
+      {
+        const LeafNode* leaf = (const LeafNode*) node;
+        for (size_t i=0; i<leaf->primCount; i++) {
+          const unsigned int primID = leaf->primIDs[i];
+          if (primID >= prims.size() || !inside(bounds,prims[primID])) return false;
+          counts[primID]++;
+        }
+        return true;
+      }
+      const InnerNode* inner = (const InnerNode*) node;
+      for (unsigned int i=0; i<inner->childCount; i++)
+      {
+        const RTCBounds& cbounds = inner->bounds[i];
+        if (cbounds.lower_x < bounds.lower_x || cbounds.lower_y < bounds.lower_y || cbounds.lower_z < bounds.lower_z ||
+            cbounds.upper_x > bounds.upper_x || cbounds.upper_y > bounds.upper_y || cbounds.upper_z > bounds.upper_z)
+          return false;
+        if (!check(inner->children[i],cbounds,prims,counts)) return false;
+      }
+      return true;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* random boxes that get added in chunks of different size */
+      const size_t numChunks = 5;
+      const size_t chunkSize = 1000;
+      std::vector<RTCBuildPrimitive> prims;
+      for (size_t i=0; i<numChunks*chunkSize; i++)
+      {
+        const Vec3fa p = 100.0f*Vec3fa(random_float(),random_float(),random_float());
+        const Vec3fa d = Vec3fa(random_float(),random_float(),random_float());
+        RTCBuildPrimitive prim;
+        prim.lower_x = p.x;     prim.lower_y = p.y;     prim.lower_z = p.z;     prim.geomID = 0;
+        prim.upper_x = p.x+d.x; prim.upper_y = p.y+d.y; prim.upper_z = p.z+d.z; prim.primID = (unsigned int) i;
+        prims.push_back(prim);
+      }
+
+      RTCBVH bvh = rtcNewBVH(device);
+      RTCBuildArguments args = rtcDefaultBuildArguments();
+      args.buildQuality = quality;
+      args.bvh = bvh;
+      args.createNode = createNode;
+      args.setNodeChildren = setNodeChildren;
+      args.setNodeBounds = setNodeBounds;
+      args.createLeaf = createLeaf;
+
+      RTCBVHStream stream = rtcBeginBVHStream(&args);
+      AssertNoError(device);
+      for (size_t i=0, begin=0; i<numChunks; i++) {
+        const size_t end = i+1 == numChunks ? prims.size() : begin+chunkSize/2+size_t(random_int())%(chunkSize/2);
+        rtcAddBVHStreamPrimitives(stream,prims.data()+begin,end-begin);
+        begin = end;
+      }
+      const Node* root = (const Node*) rtcFinishBVHStream(stream);
+      AssertNoError(device);
+
+      /* adding to an invalid stream has to fail gracefully */
+      rtcAddBVHStreamPrimitives(nullptr,prims.data(),prims.size());
+      AssertError(nullptr,RTC_ERROR_INVALID_ARGUMENT);
+
+      RTCBounds bounds;
+      bounds.lower_x = bounds.lower_y = bounds.lower_z = -inf;
+      bounds.upper_x = bounds.upper_y = bounds.upper_z = +inf;
+      std::vector<unsigned int> counts(prims.size(),0);
+      bool passed = check(root,bounds,prims,counts);
+      for (size_t i=0; i<counts.size(); i++)
+        passed &= counts[i] == 1;
+
+      rtcReleaseBVH(bvh);
+      AssertNoError(device);
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct FlatBVHTest : public VerifyApplication::Test
+  {
+    RTCBuildQuality quality;
+    RTCFlatBVHNodeLayout layout;
+    unsigned int branchingFactor;
+
+    FlatBVHTest (std::string name, int isa, RTCBuildQuality quality, RTCFlatBVHNodeLayout layout, unsigned int branchingFactor)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), quality(quality), layout(layout), branchingFactor(branchingFactor) {}
+
+    /* decodes the bounds, offset and primitive count of child slot i of a node */
+    static RTCBounds getChild (const RTCFlatBVH& flat, const char* node, size_t i, unsigned int& offset, unsigned int& count)
+    {
+      const size_t N = flat.branchingFactor;
+      RTCBounds bounds;
+      if (flat.nodeLayout == RTC_FLAT_BVH_NODE_LAYOUT_AOS)
+      {
+        const RTCFlatBVHChild& child = ((const RTCFlatBVHChild*)node)[i];
+        bounds.lower_x = child.lower_x; bounds.lower_y = child.lower_y; bounds.lower_z = child.lower_z;
+        bounds.upper_x = child.upper_x; bounds.upper_y = child.upper_y; bounds.upper_z = child.upper_z;
+        offset = child.offset;
+        count = child.primitiveCount;
+      }
+      else if (flat.nodeLayout == RTC_FLAT_BVH_NODE_LAYOUT_SOA)
+      {
+        const float* f = (const float*) node;
+        bounds.lower_x = f[0*N+i]; bounds.upper_x = f[1*N+i];
+        bounds.lower_y = f[2*N+i]; bounds.upper_y = f[3*N+i];
+        bounds.lower_z = f[4*N+i]; bounds.upper_z = f[5*N+i];
+        const unsigned int* u = (const unsigned int*)(f+6*N);
+        offset = u[0*N+i];
+        count = u[1*N+i];
+      }
+      else
+      {
+        const float* start = (const float*) node;
+        const unsigned char* q = (const unsigned char*)(start+6);
+        bounds.lower_x = start[0] + float(q[0*N+i])*start[3]; bounds.upper_x = start[0] + float(q[1*N+i])*start[3];
+        bounds.lower_y = start[1] + float(q[2*N+i])*start[4]; bounds.upper_y = start[1] + float(q[3*N+i])*start[4];
+        bounds.lower_z = start[2] + float(q[4*N+i])*start[5]; bounds.upper_z = start[2] + float(q[5*N+i])*start[5];
+        const unsigned int* u = (const unsigned int*)(node+6*sizeof(float)+6*N);
+        offset = u[0*N+i];
+        count = u[1*N+i];
+      }
+      return bounds;
+    }
+
+    static bool inside (const RTCBounds& bounds, const RTCBounds& b)
+    {
+      return bounds.lower_x <= b.lower_x && bounds.lower_y <= b.lower_y && bounds.lower_z <= b.lower_z &&
+             b.upper_x <= bounds.upper_x && b.upper_y <= bounds.upper_y && b.upper_z <= bounds.upper_z;
+    }
+
+    static void extend (RTCBounds& bounds, const RTCBounds& b)
+    {
+      bounds.lower_x = min(bounds.lower_x,b.lower_x); bounds.lower_y = min(bounds.lower_y,b.lower_y); bounds.lower_z = min(bounds.lower_z,b.lower_z);
+      bounds.upper_x = max(bounds.upper_x,b.upper_x); bounds.upper_y = max(bounds.upper_y,b.upper_y); bounds.upper_z = max(bounds.upper_z,b.upper_z);
+    }
+
+    static RTCBounds primBounds (const RTCBuildPrimitive& prim)
+    {
+      RTCBounds bounds;
+      bounds.lower_x = prim.lower_x; bounds.lower_y = prim.lower_y; bounds.lower_z = prim.lower_z;
+      bounds.upper_x = prim.upper_x; bounds.upper_y = prim.upper_y; bounds.upper_z = prim.upper_z;
+      return bounds;
+    }
+
+    /* checks that the decoded bounds of all child slots contain the exact bounds of the primitives below them, 
+       and counts how often each node and primitive is referenced */
+    static bool check (const RTCFlatBVH& flat, size_t nodeID, const std::vector<RTCBuildPrimitive>& prims,
+                       std::vector<unsigned int>& nodeCounts, std::vector<unsigned int>& primCounts, RTCBounds& exact)
+    {
+      if (nodeID >= flat.nodeCount) return false;
+      nodeCounts[nodeID]++;
+      const char* node = (const char*)flat.nodes + nodeID*flat.nodeByteStride;
+      bool empty = false;
+      for (size_t i=0; i<flat.branchingFactor; i++)
+      {
+        unsigned int offset, count;
+        const RTCBounds bounds = getChild(flat,node,i,offset,count);
+
+        /* empty slots are stored last */
+        if (offset == RTC_FLAT_BVH_EMPTY_CHILD) {
+          if (count != 0) return false;
+          empty = true;
+          continue;
+        }
+        if (empty) return false;
+
+        RTCBounds cexact;
+        cexact.lower_x = cexact.lower_y = cexact.lower_z = +inf;
+        cexact.upper_x = cexact.upper_y = cexact.upper_z = -inf;
+        if (count == 0) {
+          if (!check(flat,offset,prims,nodeCounts,primCounts,cexact)) return false;
+        }
+        else
+        {
+          if (size_t(offset)+count > flat.primitiveCount) return false;
+          for (size_t j=offset; j<offset+count; j++) {
+            const unsigned int primID = flat.primitiveIDs[j];
+            if (primID >= prims.size()) return false;
+            primCounts[primID]++;
+            extend(cexact,primBounds(prims[primID]));
+          }
+        }
+        if (!inside(bounds,cexact)) return false;
+        extend(exact,cexact);
+      }
+      return true;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* random boxes far from the origin, such that the quantization has to deal with a large offset */
+      const size_t numPrims = 5000;
+      std::vector<RTCBuildPrimitive> prims;
+      for (size_t i=0; i<numPrims; i++)
+      {
+        const Vec3fa p = Vec3fa(1000.0f) + 100.0f*Vec3fa(random_float(),random_float(),random_float());
+        const Vec3fa d = Vec3fa(random_float(),random_float(),random_float());
+        RTCBuildPrimitive prim;
+        prim.lower_x = p.x;     prim.lower_y = p.y;     prim.lower_z = p.z;     prim.geomID = 0;
+        prim.upper_x = p.x+d.x; prim.upper_y = p.y+d.y; prim.upper_z = p.z+d.z; prim.primID = (unsigned int) i;
+        prims.push_back(prim);
+      }
+
+      /* the builder reorders the primitive array */
+      std::vector<RTCBuildPrimitive> buildPrims = prims;
+      RTCBVH bvh = rtcNewBVH(device);
+      RTCBuildArguments args = rtcDefaultBuildArguments();
+      args.buildQuality = quality;
+      args.maxBranchingFactor = branchingFactor;
+      args.bvh = bvh;
+      args.primitives = buildPrims.data();
+      args.primitiveCount = buildPrims.size();
+      args.primitiveArrayCapacity = buildPrims.size();
+
+      RTCFlatBVH flat;
+      rtcBuildFlatBVH(&args,layout,&flat);
+      AssertNoError(device);
+
+      bool passed = flat.branchingFactor == branchingFactor && flat.nodeLayout == layout && flat.nodeCount > 0;
+      passed &= flat.primitiveCount == numPrims;
+      if (passed)
+      {
+        /* every node is reached once and the leaves store a permutation of the primIDs */
+        std::vector<unsigned int> nodeCounts(flat.nodeCount,0);
+        std::vector<unsigned int> primCounts(numPrims,0);
+        RTCBounds exact;
+        exact.lower_x = exact.lower_y = exact.lower_z = +inf;
+        exact.upper_x = exact.upper_y = exact.upper_z = -inf;
+        passed &= check(flat,0,prims,nodeCounts,primCounts,exact);
+        for (size_t i=0; i<nodeCounts.size(); i++) passed &= nodeCounts[i] == 1;
+        for (size_t i=0; i<primCounts.size(); i++) passed &= primCounts[i] == 1;
+        passed &= inside(flat.bounds,exact);
+      }
+
+      /* unsupported branching factors are rejected */
+      args.maxBranchingFactor = 3;
+      rtcBuildFlatBVH(&args,layout,&flat);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+
+      rtcReleaseBVH(bvh);
+      AssertNoError(device);
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
   struct OverlappingGeometryTest : public VerifyApplication::Test
   {
     SceneFlags sflags;
@@ -1343,7 +1712,7 @@ namespace embree
         case TRIANGLE_MESH: switch (sflags.sflags) {
           case RTC_SCENE_FLAG_NONE: return has_avx ?  70.0f*NN :  63.0f*NN; // triangle4
           case RTC_SCENE_FLAG_ROBUST : return has_avx ?  70.0f*NN :  63.0f*NN; // triangle4v
-          case RTC_SCENE_FLAG_COMPACT: return has_avx ?  35.0f*NN :  35.0f*NN; // triangle4i
+          case RTC_SCENE_FLAG_COMPACT: return has_avx ?  32.0f*NN :  32.0f*NN; // triangle4c
           default: return inf;
           }
           
@@ -1358,7 +1727,7 @@ namespace embree
         case QUAD_MESH: switch (sflags.sflags) {
           case RTC_SCENE_FLAG_NONE: return has_avx ? 85.0f*NN : 79.0f*NN; // quad4v
           case RTC_SCENE_FLAG_ROBUST : return has_avx ? 85.0f*NN : 79.0f*NN; // quad4v
-          case RTC_SCENE_FLAG_COMPACT: return has_avx ? 41.0f*NN : 41.0f*NN; // quad4i
+          case RTC_SCENE_FLAG_COMPACT: return has_avx ? 37.0f*NN : 37.0f*NN; // quad4c
           default: return inf;
           }
         case QUAD_MESH_MB: switch (sflags.sflags) {
@@ -1913,50 +2282,58 @@ namespace embree
     }
   };
 
-  struct GarbageGeometryTest : public VerifyApplication::Test
+  struct PrimRefCacheUpdateTest : public VerifyApplication::IntersectTest
   {
-    GarbageGeometryTest (std::string name, int isa)
-      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
-    
+    SceneFlags sflags;
+
+    PrimRefCacheUpdateTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
     {
-      std::string cfg = state->rtcore + "isa="+stringOfISA(isa);
+      /* the scene level SAH builder of dynamic scenes keeps the primrefs of unmodified geometries between builds */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",tri_accel=bvh4.triangle4";
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
 
-      for (size_t i=0; i<size_t(1000*state->intensity); i++)
-      {
-        RandomSampler_init(sampler,int(i*23565));
-        if (i%20 == 0) std::cout << "." << std::flush;
+      VerifyScene scene(device,sflags);
+      const size_t numPhi = 10;
+      const size_t numVertices = 2*numPhi*(numPhi+1);
+      Vec3fa pos[4] = { Vec3fa(-10,0,-10), Vec3fa(-10,0,+10), Vec3fa(+10,0,-10), Vec3fa(+10,0,+10) };
+      unsigned geomID[4];
+      RTCGeometry geom[4];
+      for (size_t i=0; i<4; i++) {
+        geomID[i] = scene.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,pos[i],1.0f,numPhi).first;
+        geom[i] = rtcGetGeometry(scene,geomID[i]);
+      }
+      rtcCommitScene(scene);
+      AssertNoError(device);
 
-        SceneFlags sflags = getSceneFlags(i); 
-        VerifyScene scene(device,sflags);
+      /* move one geometry per commit and check that rays find it at the new position only */
+      for (size_t j=0; j<8; j++)
+      {
+        const size_t moved = j%4;
+        const Vec3fa old_pos = pos[moved];
+        Vec3fa ds(0,0,4);
+        UpdateTest::move_mesh(geom[moved],numVertices,ds);
+        pos[moved] += ds;
+        rtcCommitScene(scene);
         AssertNoError(device);
-        
-        for (size_t j=0; j<20; j++) 
+
+        RTCRayHit rays[5];
+        for (size_t i=0; i<4; i++) rays[i] = makeRay(pos[i]+Vec3fa(0.1f,10,0.1f),Vec3fa(0,-1,0));
+        rays[4] = makeRay(old_pos+Vec3fa(0.1f,10,0.1f),Vec3fa(0,-1,0));
+        IntersectWithMode(imode,ivariant,scene,rays,5);
+
+        for (size_t i=0; i<5; i++)
         {
-          size_t numPrimitives = random_int()%256;
-          switch (random_int()%10) {
-          case 0: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageTriangleMesh(random_int(),numPrimitives,false)); break;
-          case 1: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageTriangleMesh(random_int(),numPrimitives,true )); break;
-          case 2: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageQuadMesh(random_int(),numPrimitives,false)); break;
-          case 3: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageQuadMesh(random_int(),numPrimitives,true )); break;
-          case 4: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageGridMesh(random_int(),numPrimitives,false)); break;
-          case 5: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageGridMesh(random_int(),numPrimitives,true )); break;
-          case 6: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageHair(random_int(),numPrimitives,false)); break;
-          case 7: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageHair(random_int(),numPrimitives,true )); break;
-          case 8: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageLineSegments(random_int(),numPrimitives,false)); break;
-          case 9: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageLineSegments(random_int(),numPrimitives,true )); break;
-          case 10: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbagePointSet(random_int(),numPrimitives,false)); break;
-          case 11: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbagePointSet(random_int(),numPrimitives,true )); break;
-            //case 12: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageSubdivMesh(random_int(),numPrimitives,false)); break; // FIXME: not working yet
-            //case 13: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageSubdivMesh(random_int(),numPrimitives,true )); break;
+          const bool hit = i < 4;
+          if (ivariant & VARIANT_INTERSECT) {
+            if (rays[i].hit.geomID != (hit ? geomID[i] : RTC_INVALID_GEOMETRY_ID)) return VerifyApplication::FAILED;
           }
-          AssertNoError(device);
+          else if ((rays[i].ray.tfar == float(neg_inf)) != hit)
+            return VerifyApplication::FAILED;
         }
-        
-        rtcCommitScene(scene);
-        AssertNoError(device);
       }
       AssertNoError(device);
 
@@ -1964,72 +2341,369 @@ namespace embree
     }
   };
 
-  /////////////////////////////////////////////////////////////////////////////////
-  /////////////////////////////////////////////////////////////////////////////////
-  /////////////////////////////////////////////////////////////////////////////////
-  /////////////////////////////////////////////////////////////////////////////////
+  struct PartialUpdateTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCGeometryType gtype;
+    RTCBuildQuality quality;
+    bool rebuild;
+    bool byteRange;
 
-  const size_t num_interpolation_vertices = 16;
-  const size_t num_interpolation_quad_faces = 9;
-  const size_t num_interpolation_triangle_faces = 18;
+    PartialUpdateTest (std::string name, int isa, SceneFlags sflags, RTCGeometryType gtype, RTCBuildQuality quality, bool rebuild, bool byteRange, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gtype(gtype), quality(quality), rebuild(rebuild), byteRange(byteRange) {}
 
-  __aligned(16) float interpolation_vertices[num_interpolation_vertices*3] = {
-    -1.0f, -1.0f, 0.0f,
-    0.0f, -1.0f, 0.0f, 
-    +1.0f, -1.0f, 0.0f,
-    +2.0f, -1.0f, 0.0f,
-    
-    -1.0f,  0.0f, 0.0f,
-    0.0f,  0.0f, 0.0f,
-    +1.0f,  0.0f, 0.0f,
-    +2.0f,  0.0f, 0.0f,
+    static const unsigned int R = 32; // number of grid cells per side
 
-    -1.0f, +1.0f, 0.0f,
-    0.0f, +1.0f, 0.0f,
-    +1.0f, +1.0f, 0.0f,
-    +2.0f, +1.0f, 0.0f,
+    /* creates a grid of R x R cells in the xy plane, the index buffer is shared with the reference scene */
+    static RTCGeometry createGrid(RTCDevice device, RTCGeometryType gtype, RTCBuildQuality quality, float* vertices, unsigned int* indices)
+    {
+      const unsigned int numVertices = (R+1)*(R+1);
+      RTCGeometry geom = rtcNewGeometry(device,gtype);
+      rtcSetGeometryBuildQuality(geom,quality);
+      rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,vertices,0,4*sizeof(float),numVertices);
+      if (gtype == RTC_GEOMETRY_TYPE_QUAD)
+        rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT4,indices,0,4*sizeof(unsigned int),R*R);
+      else
+        rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,indices,0,3*sizeof(unsigned int),2*R*R);
+      rtcCommitGeometry(geom);
+      return geom;
+    }
 
-    -1.0f, +2.0f, 0.0f,
-    0.0f, +2.0f, 0.0f,
-    +1.0f, +2.0f, 0.0f,
-    +2.0f, +2.0f, 0.0f,
-  };
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* with a low threshold the refitted BVH gets rebuilt with the SAH builder once the modified cells stretch */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      if (rebuild) cfg += ",refit_rebuild_threshold=1.01";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
 
-  __aligned(16) int interpolation_quad_indices[num_interpolation_quad_faces*4] = {
-    0, 1, 5, 4,
-    1, 2, 6, 5,
-    2, 3, 7, 6,
-    4, 5, 9, 8, 
-    5, 6, 10, 9,
-    6, 7, 11, 10,
-    8, 9, 13, 12,
-    9, 10, 14, 13,
-    10, 11, 15, 14
-  };
+      const unsigned int numVertices = (R+1)*(R+1);
+      std::vector<float> vertices(4*numVertices+4);
+      for (unsigned int y=0; y<=R; y++) {
+        for (unsigned int x=0; x<=R; x++) {
+          float* v = &vertices[4*(y*(R+1)+x)];
+          v[0] = float(x); v[1] = float(y); v[2] = 0.0f; v[3] = 0.0f;
+        }
+      }
+      std::vector<unsigned int> indices;
+      for (unsigned int y=0; y<R; y++) {
+        for (unsigned int x=0; x<R; x++) {
+          const unsigned int v00 = y*(R+1)+x, v01 = v00+1, v10 = v00+R+1, v11 = v10+1;
+          if (gtype == RTC_GEOMETRY_TYPE_QUAD) {
+            const unsigned int quad[4] = { v00, v01, v11, v10 };
+            indices.insert(indices.end(),quad,quad+4);
+          } else {
+            const unsigned int tris[6] = { v00, v01, v10, v01, v11, v10 };
+            indices.insert(indices.end(),tris,tris+6);
+          }
+        }
+      }
 
-  __aligned(16) int interpolation_triangle_indices[num_interpolation_triangle_faces*3] = {
-    0, 1, 5,  0, 5, 4,
-    1, 2, 6,  1, 6, 5,
-    2, 3, 7,  2, 7, 6,
-    4, 5, 9,  4, 9, 8, 
-    5, 6, 10,  5, 10, 9,
-    6, 7, 11,  6, 11, 10,
-    8, 9, 13,   8, 13, 12,
-    9, 10, 14,   9, 14, 13,
-    10, 11, 15,  10, 15, 14
-  };
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+      RTCGeometry geom = createGrid(device,gtype,quality,vertices.data(),indices.data());
+      rtcAttachGeometry(scene,geom);
+      rtcCommitScene(scene);
+      AssertNoError(device);
 
-  __aligned(16) int interpolation_quad_faces[num_interpolation_quad_faces] = {
-    4, 4, 4, 4, 4, 4, 4, 4, 4
-  };
+      const size_t numRays = 256;
+      unsigned int invalidVertex = numVertices;
+      for (size_t round=0; round<8; round++)
+      {
+        /* modify a range of less than a quarter of the vertices */
+        const unsigned int count = 1 + unsigned(random_int()) % (numVertices/8);
+        const unsigned int begin = unsigned(random_int()) % (numVertices-count);
+        for (unsigned int i=begin; i<begin+count; i++) {
+          float* v = &vertices[4*i];
+          if (rebuild) { v[0] += 8.0f*random_float()-4.0f; v[1] += 8.0f*random_float()-4.0f; }
+          v[2] = random_float();
+        }
 
-  __aligned(16) float interpolation_vertex_crease_weights[2] = {
-    inf, inf
-  };
+        /* byte ranges that only partially overlap the first and last vertex still mark them as modified */
+        if (byteRange)
+          rtcUpdateGeometryBufferByteRange(geom,RTC_BUFFER_TYPE_VERTEX,0,4*sizeof(float)*begin+sizeof(float),4*sizeof(float)*count-2*sizeof(float));
+        else
+          rtcUpdateGeometryBufferRange(geom,RTC_BUFFER_TYPE_VERTEX,0,begin,count);
 
-  __aligned(16) unsigned int interpolation_vertex_crease_indices[2] = {
-    12, 15
-  };
+        /* an invalid vertex makes the SAH builder fall back from updating its primrefs to creating them again */
+        const bool sah = quality != RTC_BUILD_QUALITY_REFIT;
+        if (sah && round == 4) {
+          invalidVertex = begin;
+          vertices[4*invalidVertex+0] = float(nan);
+        }
+        else if (sah && round == 5) {
+          vertices[4*invalidVertex+0] = float(invalidVertex%(R+1));
+          rtcUpdateGeometryBufferRange(geom,RTC_BUFFER_TYPE_VERTEX,0,invalidVertex,1);
+        }
+        rtcCommitGeometry(geom);
+        rtcCommitScene(scene);
+        AssertNoError(device);
+
+        /* reference scene built from scratch over the same vertices */
+        RTCSceneRef reference = rtcNewScene(device);
+        RTCGeometry refGeom = createGrid(device,gtype,RTC_BUILD_QUALITY_MEDIUM,vertices.data(),indices.data());
+        rtcAttachGeometry(reference,refGeom);
+        rtcReleaseGeometry(refGeom);
+        rtcCommitScene(reference);
+        AssertNoError(device);
+
+        RTCRayHit rays0[numRays], rays1[numRays];
+        for (size_t i=0; i<numRays; i++) {
+          const Vec3fa org(float(R)*random_float(),float(R)*random_float(),2.0f);
+          rays0[i] = rays1[i] = makeRay(org,Vec3fa(0.01f,0.02f,-1.0f));
+        }
+        IntersectWithMode(imode,ivariant,scene,rays0,numRays);
+        IntersectWithMode(imode,ivariant,reference,rays1,numRays);
+        AssertNoError(device);
+
+        for (size_t i=0; i<numRays; i++)
+        {
+          if (ivariant & VARIANT_INTERSECT) {
+            if (rays0[i].hit.geomID != rays1[i].hit.geomID) return VerifyApplication::FAILED;
+            if (rays0[i].hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+            if (rays0[i].hit.primID != rays1[i].hit.primID) return VerifyApplication::FAILED;
+            if (abs(rays0[i].ray.tfar-rays1[i].ray.tfar) > 1E-5f) return VerifyApplication::FAILED;
+          }
+          else if ((rays0[i].ray.tfar == float(neg_inf)) != (rays1[i].ray.tfar == float(neg_inf)))
+            return VerifyApplication::FAILED;
+        }
+      }
+      rtcReleaseGeometry(geom);
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct SubdivLevelUpdateTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+
+    SubdivLevelUpdateTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    static const unsigned int R = 8; // number of faces per side
+
+    static RTCGeometry createGrid(RTCDevice device, RTCBuildQuality quality, unsigned int* faces, unsigned int* indices, float* vertices, float* levels)
+    {
+      RTCGeometry geom = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_SUBDIVISION);
+      rtcSetGeometryBuildQuality(geom,quality);
+      rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_FACE,0,RTC_FORMAT_UINT,faces,0,sizeof(unsigned int),R*R);
+      rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT,indices,0,sizeof(unsigned int),4*R*R);
+      rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,vertices,0,4*sizeof(float),(R+1)*(R+1));
+      rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_LEVEL,0,RTC_FORMAT_FLOAT,levels,0,sizeof(float),4*R*R);
+      rtcCommitGeometry(geom);
+      return geom;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* bumpy grid of quad faces, one level per half edge */
+      const unsigned int numVertices = (R+1)*(R+1);
+      const unsigned int numEdges = 4*R*R;
+      std::vector<unsigned int> faces(R*R,4);
+      std::vector<unsigned int> indices;
+      for (unsigned int y=0; y<R; y++) {
+        for (unsigned int x=0; x<R; x++) {
+          const unsigned int v00 = y*(R+1)+x, v01 = v00+1, v10 = v00+R+1, v11 = v10+1;
+          const unsigned int face[4] = { v00, v01, v11, v10 };
+          indices.insert(indices.end(),face,face+4);
+        }
+      }
+      std::vector<float> vertices(4*numVertices+4);
+      for (unsigned int i=0; i<numVertices; i++) {
+        vertices[4*i+0] = float(i%(R+1)); vertices[4*i+1] = float(i/(R+1)); vertices[4*i+2] = random_float(); vertices[4*i+3] = 0.0f;
+      }
+      std::vector<float> levels(numEdges,2.0f);
+
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+      RTCGeometry geom = createGrid(device,RTC_BUILD_QUALITY_REFIT,faces.data(),indices.data(),vertices.data(),levels.data());
+      rtcAttachGeometry(scene,geom);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      const size_t numRays = 256;
+      for (size_t round=0; round<8; round++)
+      {
+        /* change the levels of a range of half edges, the byte range only partially overlaps the first and last level */
+        const unsigned int count = 1 + unsigned(random_int()) % (numEdges/4);
+        const unsigned int begin = unsigned(random_int()) % (numEdges-count);
+        for (unsigned int i=begin; i<begin+count; i++)
+          levels[i] = float(1 + unsigned(random_int()) % 8);
+        rtcUpdateGeometryBufferByteRange(geom,RTC_BUFFER_TYPE_LEVEL,0,sizeof(float)*begin+1,sizeof(float)*count-2);
+
+        /* every other round also moves some vertices */
+        if (round % 2)
+        {
+          const unsigned int vbegin = unsigned(random_int()) % (numVertices-R);
+          for (unsigned int i=vbegin; i<vbegin+R; i++)
+            vertices[4*i+2] = random_float();
+          rtcUpdateGeometryBufferByteRange(geom,RTC_BUFFER_TYPE_VERTEX,0,4*sizeof(float)*vbegin,4*sizeof(float)*R);
+        }
+        rtcCommitGeometry(geom);
+        rtcCommitScene(scene);
+        AssertNoError(device);
+
+        /* reference scene built from scratch over the same buffers */
+        RTCSceneRef reference = rtcNewScene(device);
+        RTCGeometry refGeom = createGrid(device,RTC_BUILD_QUALITY_MEDIUM,faces.data(),indices.data(),vertices.data(),levels.data());
+        rtcAttachGeometry(reference,refGeom);
+        rtcReleaseGeometry(refGeom);
+        rtcCommitScene(reference);
+        AssertNoError(device);
+
+        RTCRayHit rays0[numRays], rays1[numRays];
+        for (size_t i=0; i<numRays; i++) {
+          const Vec3fa org(float(R)*random_float(),float(R)*random_float(),2.0f);
+          rays0[i] = rays1[i] = makeRay(org,Vec3fa(0.01f,0.02f,-1.0f));
+        }
+        IntersectWithMode(imode,ivariant,scene,rays0,numRays);
+        IntersectWithMode(imode,ivariant,reference,rays1,numRays);
+        AssertNoError(device);
+
+        for (size_t i=0; i<numRays; i++)
+        {
+          if (ivariant & VARIANT_INTERSECT) {
+            if (rays0[i].hit.geomID != rays1[i].hit.geomID) return VerifyApplication::FAILED;
+            if (rays0[i].hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+            if (rays0[i].hit.primID != rays1[i].hit.primID) return VerifyApplication::FAILED;
+            if (abs(rays0[i].ray.tfar-rays1[i].ray.tfar) > 1E-4f) return VerifyApplication::FAILED;
+          }
+          else if ((rays0[i].ray.tfar == float(neg_inf)) != (rays1[i].ray.tfar == float(neg_inf)))
+            return VerifyApplication::FAILED;
+        }
+      }
+      rtcReleaseGeometry(geom);
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct GarbageGeometryTest : public VerifyApplication::Test
+  {
+    GarbageGeometryTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + "isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      for (size_t i=0; i<size_t(1000*state->intensity); i++)
+      {
+        RandomSampler_init(sampler,int(i*23565));
+        if (i%20 == 0) std::cout << "." << std::flush;
+
+        SceneFlags sflags = getSceneFlags(i); 
+        VerifyScene scene(device,sflags);
+        AssertNoError(device);
+        
+        for (size_t j=0; j<20; j++) 
+        {
+          size_t numPrimitives = random_int()%256;
+          switch (random_int()%10) {
+          case 0: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageTriangleMesh(random_int(),numPrimitives,false)); break;
+          case 1: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageTriangleMesh(random_int(),numPrimitives,true )); break;
+          case 2: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageQuadMesh(random_int(),numPrimitives,false)); break;
+          case 3: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageQuadMesh(random_int(),numPrimitives,true )); break;
+          case 4: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageGridMesh(random_int(),numPrimitives,false)); break;
+          case 5: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageGridMesh(random_int(),numPrimitives,true )); break;
+          case 6: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageHair(random_int(),numPrimitives,false)); break;
+          case 7: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageHair(random_int(),numPrimitives,true )); break;
+          case 8: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageLineSegments(random_int(),numPrimitives,false)); break;
+          case 9: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageLineSegments(random_int(),numPrimitives,true )); break;
+          case 10: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbagePointSet(random_int(),numPrimitives,false)); break;
+          case 11: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbagePointSet(random_int(),numPrimitives,true )); break;
+            //case 12: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageSubdivMesh(random_int(),numPrimitives,false)); break; // FIXME: not working yet
+            //case 13: scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createGarbageSubdivMesh(random_int(),numPrimitives,true )); break;
+          }
+          AssertNoError(device);
+        }
+        
+        rtcCommitScene(scene);
+        AssertNoError(device);
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  /////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////////////////////////////////////////////////////////
+
+  const size_t num_interpolation_vertices = 16;
+  const size_t num_interpolation_quad_faces = 9;
+  const size_t num_interpolation_triangle_faces = 18;
+
+  __aligned(16) float interpolation_vertices[num_interpolation_vertices*3] = {
+    -1.0f, -1.0f, 0.0f,
+    0.0f, -1.0f, 0.0f, 
+    +1.0f, -1.0f, 0.0f,
+    +2.0f, -1.0f, 0.0f,
+    
+    -1.0f,  0.0f, 0.0f,
+    0.0f,  0.0f, 0.0f,
+    +1.0f,  0.0f, 0.0f,
+    +2.0f,  0.0f, 0.0f,
+
+    -1.0f, +1.0f, 0.0f,
+    0.0f, +1.0f, 0.0f,
+    +1.0f, +1.0f, 0.0f,
+    +2.0f, +1.0f, 0.0f,
+
+    -1.0f, +2.0f, 0.0f,
+    0.0f, +2.0f, 0.0f,
+    +1.0f, +2.0f, 0.0f,
+    +2.0f, +2.0f, 0.0f,
+  };
+
+  __aligned(16) int interpolation_quad_indices[num_interpolation_quad_faces*4] = {
+    0, 1, 5, 4,
+    1, 2, 6, 5,
+    2, 3, 7, 6,
+    4, 5, 9, 8, 
+    5, 6, 10, 9,
+    6, 7, 11, 10,
+    8, 9, 13, 12,
+    9, 10, 14, 13,
+    10, 11, 15, 14
+  };
+
+  __aligned(16) int interpolation_triangle_indices[num_interpolation_triangle_faces*3] = {
+    0, 1, 5,  0, 5, 4,
+    1, 2, 6,  1, 6, 5,
+    2, 3, 7,  2, 7, 6,
+    4, 5, 9,  4, 9, 8, 
+    5, 6, 10,  5, 10, 9,
+    6, 7, 11,  6, 11, 10,
+    8, 9, 13,   8, 13, 12,
+    9, 10, 14,   9, 14, 13,
+    10, 11, 15,  10, 15, 14
+  };
+
+  __aligned(16) int interpolation_quad_faces[num_interpolation_quad_faces] = {
+    4, 4, 4, 4, 4, 4, 4, 4, 4
+  };
+
+  __aligned(16) float interpolation_vertex_crease_weights[2] = {
+    inf, inf
+  };
+
+  __aligned(16) unsigned int interpolation_vertex_crease_indices[2] = {
+    12, 15
+  };
 
   __aligned(16) float interpolation_edge_crease_weights[3] = {
     inf, inf, inf
@@ -2465,8 +3139,10 @@ namespace embree
     SceneFlags sflags; 
     RTCBuildQuality quality; 
 
-    TriangleHitTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
-      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+    std::string tri_accel;
+
+    TriangleHitTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant, std::string tri_accel = "")
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality), tri_accel(tri_accel) {}
 
     inline Vec3fa uniformSampleTriangle(const Vec3fa &a, const Vec3fa &b, const Vec3fa &c, float &u, float& v)
     {
@@ -2479,7 +3155,7 @@ namespace embree
 
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
     {
-      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa) + ((tri_accel != "") ? ",tri_accel="+tri_accel : "");
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
      
@@ -2552,12 +3228,14 @@ namespace embree
     SceneFlags sflags; 
     RTCBuildQuality quality; 
 
-    QuadHitTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
-      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+    std::string quad_accel;
+
+    QuadHitTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant, std::string quad_accel = "")
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality), quad_accel(quad_accel) {}
 
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
     {
-      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa) + ((quad_accel != "") ? ",quad_accel="+quad_accel : "");
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
      
@@ -2610,20 +3288,995 @@ namespace embree
         if (abs(rays[i].hit.v - v[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
         if (abs(rays[i].ray.tfar - 1.0f) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
 
-        const Vec3fa org(rays[i].ray.org_x,rays[i].ray.org_y,rays[i].ray.org_z);
-        const Vec3fa dir(rays[i].ray.dir_x,rays[i].ray.dir_y,rays[i].ray.dir_z);
-        const Vec3fa ht  = org + rays[i].ray.tfar*dir;
-        const Vec3fa huv = vertices[0] + rays[i].hit.u*(vertices[1]-vertices[0]) + rays[i].hit.v*(vertices[3]-vertices[0]);
-        if (reduce_max(abs(ht-huv)) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        const Vec3fa Ng = Vec3fa(rays[i].hit.Ng_x,rays[i].hit.Ng_y,rays[i].hit.Ng_z);
-        if (reduce_max(abs(Ng - Vec3fa(0.0f,0.0f,1.0f))) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-      }
+        const Vec3fa org(rays[i].ray.org_x,rays[i].ray.org_y,rays[i].ray.org_z);
+        const Vec3fa dir(rays[i].ray.dir_x,rays[i].ray.dir_y,rays[i].ray.dir_z);
+        const Vec3fa ht  = org + rays[i].ray.tfar*dir;
+        const Vec3fa huv = vertices[0] + rays[i].hit.u*(vertices[1]-vertices[0]) + rays[i].hit.v*(vertices[3]-vertices[0]);
+        if (reduce_max(abs(ht-huv)) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        const Vec3fa Ng = Vec3fa(rays[i].hit.Ng_x,rays[i].hit.Ng_y,rays[i].hit.Ng_z);
+        if (reduce_max(abs(Ng - Vec3fa(0.0f,0.0f,1.0f))) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+  
+  struct MultiHitTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+    bool instanced;
+
+    MultiHitTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, bool instanced)
+      : VerifyApplication::IntersectTest(name,isa,imode,VARIANT_INTERSECT,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality), instanced(instanced) {}
+
+    /* traces rays of the given packet size with rtcIntersectMulti, the last lane of packets is invalid */
+    void intersectMulti(RTCScene scene, RTCRayHit* rays, RTCMultiHit* hits, unsigned int N, unsigned int maxHitCount)
+    {
+      switch (imode)
+      {
+      case MODE_INTERSECT1:
+        for (size_t i=0; i<N; i++) rtcIntersectMulti1(scene,&rays[i],maxHitCount,&hits[i]);
+        break;
+      case MODE_INTERSECT4: {
+        __aligned(16) int valid[4] = { -1, -1, -1, 0 };
+        __aligned(16) RTCRayHit4 ray4;
+        for (size_t j=0; j<4; j++) setRay(ray4,j,rays[j]);
+        rtcIntersectMulti4(valid,scene,&ray4,maxHitCount,hits);
+        for (size_t j=0; j<4; j++) rays[j] = getRay(ray4,j);
+        break;
+      }
+      case MODE_INTERSECT8: {
+        __aligned(32) int valid[8] = { -1, -1, -1, -1, -1, -1, -1, 0 };
+        __aligned(32) RTCRayHit8 ray8;
+        for (size_t j=0; j<8; j++) setRay(ray8,j,rays[j]);
+        rtcIntersectMulti8(valid,scene,&ray8,maxHitCount,hits);
+        for (size_t j=0; j<8; j++) rays[j] = getRay(ray8,j);
+        break;
+      }
+      case MODE_INTERSECT16: {
+        __aligned(64) int valid[16];
+        for (size_t j=0; j<16; j++) valid[j] = j < 15 ? -1 : 0;
+        __aligned(64) RTCRayHit16 ray16;
+        for (size_t j=0; j<16; j++) setRay(ray16,j,rays[j]);
+        rtcIntersectMulti16(valid,scene,&ray16,maxHitCount,hits);
+        for (size_t j=0; j<16; j++) rays[j] = getRay(ray16,j);
+        break;
+      }
+      default:
+        break;
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* stack of 8 triangles at z=1 to z=8, inserted in reverse order */
+      const unsigned int numLayers = 8;
+      Vec3f vertices[3*numLayers+1];
+      Triangle triangles[numLayers];
+      for (unsigned int i=0; i<numLayers; i++)
+      {
+        const float z = float(numLayers-i);
+        vertices[3*i+0] = Vec3f(-1.0f,-1.0f,z);
+        vertices[3*i+1] = Vec3f(+4.0f,-1.0f,z);
+        vertices[3*i+2] = Vec3f(-1.0f,+4.0f,z);
+        triangles[i] = Triangle(3*i+0,3*i+1,3*i+2);
+      }
+      vertices[3*numLayers] = Vec3f(zero); // dummy vertex for 16 byte padding
+
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+
+      /* in the instanced case the stack gets moved by one unit along the rays */
+      RTCSceneRef object = instanced ? rtcNewScene(device) : nullptr;
+      RTCScene target = instanced ? (RTCScene) object : (RTCScene) scene;
+      const float offset = instanced ? 1.0f : 0.0f;
+
+      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryBuildQuality(geom,quality);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices , 0, sizeof(Vec3f), 3*numLayers);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX , 0, RTC_FORMAT_UINT3,  triangles, 0, sizeof(Triangle), numLayers);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(target,geom);
+      rtcReleaseGeometry(geom);
+
+      if (instanced)
+      {
+        rtcCommitScene(object);
+        const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(0.0f,0.0f,offset));
+        RTCGeometry inst = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(inst,object);
+        rtcSetGeometryTransform(inst,0,RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR,&xfm);
+        rtcCommitGeometry(inst);
+        rtcAttachGeometry(scene,inst);
+        rtcReleaseGeometry(inst);
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      const unsigned int N = imode == MODE_INTERSECT1 ? 1 : imode == MODE_INTERSECT4 ? 4 : imode == MODE_INTERSECT8 ? 8 : 16;
+      const unsigned int numValid = N == 1 ? 1 : N-1;
+      
+      bool passed = true;
+      for (unsigned int maxHitCount = 1; maxHitCount <= min(numLayers+1,unsigned(RTC_MAX_MULTI_HIT_COUNT)); maxHitCount++)
+      {
+        RTCRayHit rays[16];
+        RTCMultiHit hits[16];
+        for (size_t i=0; i<N; i++) {
+          rays[i] = makeRay(Vec3fa(0.1f*float(i%4),0.1f*float(i/4),0.0f),Vec3fa(0.0f,0.0f,1.0f));
+          hits[i].hitCount = unsigned(-1);
+        }
+        intersectMulti(scene,rays,hits,N,maxHitCount);
+        
+        for (size_t i=0; i<N; i++)
+        {
+          /* invalid rays are not modified */
+          if (i >= numValid) {
+            passed &= hits[i].hitCount == unsigned(-1);
+            passed &= rays[i].hit.geomID == RTC_INVALID_GEOMETRY_ID;
+            continue;
+          }
+
+          /* the nearest hits are returned sorted by distance */
+          const unsigned int numHits = min(maxHitCount,numLayers);
+          passed &= hits[i].hitCount == numHits;
+          for (unsigned int j=0; j<min(numHits,hits[i].hitCount); j++) {
+            const float t = float(j+1)+offset;
+            passed &= abs(hits[i].tfar[j] - t) < 16.0f*float(ulp)*t;
+            passed &= hits[i].hit[j].primID == numLayers-1-j;
+            passed &= hits[i].hit[j].geomID == 0;
+            passed &= hits[i].hit[j].instID[0] == (instanced ? 0 : RTC_INVALID_GEOMETRY_ID);
+          }
+
+          /* the ray stores the nearest hit */
+          passed &= rays[i].hit.primID == numLayers-1;
+          passed &= abs(rays[i].ray.tfar - (1.0f+offset)) < 16.0f*float(ulp)*(1.0f+offset);
+        }
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct RayConeTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCGeometryType gtype;
+    bool instanced;
+
+    RayConeTest (std::string name, int isa, SceneFlags sflags, RTCGeometryType gtype, bool instanced)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gtype(gtype), instanced(instanced) {}
+
+    static bool close(float a, float b, float eps) {
+      return abs(a-b) <= eps*max(1.0f,abs(b));
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+
+      /* the instance scales non-uniformly, the geometry normal of the hit has to be transformed with the inverse transpose */
+      RTCSceneRef object = instanced ? rtcNewScene(device) : nullptr;
+      RTCScene target = instanced ? (RTCScene) object : (RTCScene) scene;
+      const AffineSpace3fa xfm = instanced ? AffineSpace3fa::translate(Vec3fa(0.0f,0.0f,1.0f))*AffineSpace3fa::scale(Vec3fa(2.0f,0.5f,1.5f)) : AffineSpace3fa(one);
+
+      /* a tilted triangle or parallelogram, or a round line along the x axis */
+      const Vec3fa p0(-1.0f,-1.0f,4.0f), p1(3.0f,-1.0f,6.0f), p3(-1.0f,3.0f,4.0f);
+      const Vec3fa p2 = p1+p3-p0;
+      const float radius = 0.5f;
+      __aligned(16) float vertices[4*4];
+      unsigned int indices[4] = { 0, 1, 2, 3 };
+      RTCGeometry geom = rtcNewGeometry (device, gtype);
+      if (gtype == RTC_GEOMETRY_TYPE_ROUND_LINEAR_CURVE)
+      {
+        const float curve[8] = { -2.0f, 0.0f, 5.0f, radius, +2.0f, 0.0f, 5.0f, radius };
+        for (size_t i=0; i<8; i++) vertices[i] = curve[i];
+        rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT4, vertices, 0, 4*sizeof(float), 2);
+        rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX , 0, RTC_FORMAT_UINT, indices, 0, sizeof(unsigned int), 1);
+      }
+      else
+      {
+        const Vec3fa p[4] = { p0, p1, gtype == RTC_GEOMETRY_TYPE_QUAD ? p2 : p3, p3 };
+        for (size_t i=0; i<4; i++) {
+          vertices[4*i+0] = p[i].x; vertices[4*i+1] = p[i].y; vertices[4*i+2] = p[i].z; vertices[4*i+3] = 0.0f;
+        }
+        if (gtype == RTC_GEOMETRY_TYPE_QUAD) {
+          rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices, 0, 4*sizeof(float), 4);
+          rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX , 0, RTC_FORMAT_UINT4, indices, 0, 4*sizeof(unsigned int), 1);
+        } else {
+          rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices, 0, 4*sizeof(float), 3);
+          rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX , 0, RTC_FORMAT_UINT3, indices, 0, 3*sizeof(unsigned int), 1);
+        }
+      }
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(target,geom);
+      rtcReleaseGeometry(geom);
+
+      if (instanced)
+      {
+        rtcCommitScene(object);
+        RTCGeometry inst = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(inst,object);
+        rtcSetGeometryTransform(inst,0,RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR,&xfm);
+        rtcCommitGeometry(inst);
+        rtcAttachGeometry(scene,inst);
+        rtcReleaseGeometry(inst);
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* the ray direction is not normalized, the distance of the footprint is measured in world space units */
+      const bool isCurve = gtype == RTC_GEOMETRY_TYPE_ROUND_LINEAR_CURVE;
+      const Vec3fa org(isCurve ? 0.0f : 0.1f, isCurve ? 0.0f : 0.2f, 0.0f);
+      const Vec3fa dir(isCurve ? 0.0f : 0.2f, isCurve ? 0.0f : 0.1f, 2.0f);
+      RTCRayCone cone;
+      cone.width = 0.01f;
+      cone.spreadAngle = 0.002f;
+      
+      RTCRayHit ray = makeRay(org,dir);
+      RTCRayConeHit footprint;
+      rtcIntersectCone1(scene,&ray,&cone,&footprint);
+      AssertNoError(device);
+      if (ray.hit.geomID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+
+      /* expected footprint calculated from the world space vertices */
+      float distance, area, cosTheta;
+      if (isCurve) {
+        distance = 5.0f-radius;
+        area = 0.0f;
+        cosTheta = 1.0f;
+      } else {
+        const Vec3fa v0 = xfmPoint(xfm,p0), v1 = xfmPoint(xfm,p1), v2 = xfmPoint(xfm,p3);
+        const Vec3fa Ng = cross(v1-v0,v2-v0);
+        distance = dot(v0-org,Ng)/dot(dir,Ng)*length(dir);
+        area = 0.5f*length(Ng);
+        cosTheta = abs(dot(dir,Ng))/(length(dir)*length(Ng));
+      }
+      const float eps = isCurve ? 1E-3f : 1E-4f;
+      bool passed = true;
+      passed &= close(footprint.distance,distance,eps);
+      passed &= close(footprint.width,cone.width+distance*cone.spreadAngle,eps);
+      passed &= close(footprint.area,area,eps);
+      passed &= close(footprint.cosTheta,cosTheta,eps);
+
+      /* the footprint is not modified by a miss */
+      RTCRayHit miss = makeRay(org,-dir);
+      RTCRayConeHit unmodified;
+      unmodified.distance = unmodified.width = unmodified.area = unmodified.cosTheta = -1.0f;
+      rtcIntersectCone1(scene,&miss,&cone,&unmodified);
+      passed &= miss.hit.geomID == RTC_INVALID_GEOMETRY_ID;
+      passed &= unmodified.distance == -1.0f && unmodified.width == -1.0f && unmodified.area == -1.0f && unmodified.cosTheta == -1.0f;
+      AssertNoError(device);
+      
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct TileTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+    unsigned int width, height;
+
+    TileTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, unsigned int width, unsigned int height)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality), width(width), height(height) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+      scene.addGeometry(quality,SceneGraph::createTriangleSphere(Vec3fa(zero),1.0f,50));
+      scene.addGeometry(quality,SceneGraph::createQuadSphere(Vec3fa(1.5f,0.0f,1.0f),0.5f,20));
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* camera rays of the tile, every 7th ray is disabled */
+      const size_t numRays = size_t(width)*size_t(height);
+      std::vector<RTCRayHit> rays(numRays);
+      for (unsigned int y=0; y<height; y++) {
+        for (unsigned int x=0; x<width; x++) {
+          const Vec3fa dir = Vec3fa(2.5f*(float(x)+0.5f)/float(width)-1.25f,2.5f*(float(y)+0.5f)/float(height)-1.25f,1.0f);
+          const size_t i = size_t(y)*width+x;
+          rays[i] = i%7 == 3 ? makeRay(Vec3fa(0.0f,0.0f,-3.0f),dir,1.0f,0.0f) : makeRay(Vec3fa(0.0f,0.0f,-3.0f),dir);
+        }
+      }
+      std::vector<RTCRayHit> rays1 = rays;
+      std::vector<RTCRay> shadows(numRays), shadows1(numRays);
+      for (size_t i=0; i<numRays; i++) shadows[i] = shadows1[i] = rays[i].ray;
+
+      rtcIntersectTile(scene,rays.data(),width,height);
+      rtcOccludedTile(scene,shadows.data(),width,height);
+      for (size_t i=0; i<numRays; i++) {
+        rtcIntersect1(scene,&rays1[i]);
+        rtcOccluded1(scene,&shadows1[i]);
+      }
+      AssertNoError(device);
+
+      /* the tile has to find the same hits as single rays */
+      bool passed = true;
+      for (size_t i=0; i<numRays; i++)
+      {
+        passed &= rays[i].hit.geomID == rays1[i].hit.geomID;
+        if (rays1[i].hit.geomID != RTC_INVALID_GEOMETRY_ID)
+          passed &= abs(rays[i].ray.tfar - rays1[i].ray.tfar) <= 1E-4f*rays1[i].ray.tfar;
+        passed &= shadows[i].tfar == shadows1[i].tfar;
+      }
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct BVH16Test : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+
+    BVH16Test (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* the 16-wide BVH has to find the same hits as the default acceleration structure */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      std::string cfg16 = cfg + ",tri_accel=bvh16.triangle4";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      RTCDeviceRef device16 = rtcNewDevice(cfg16.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device16));
+
+      Ref<SceneGraph::Node> mesh = SceneGraph::createTriangleSphere(Vec3fa(zero),1.0f,100);
+      VerifyScene scene(device,sflags), scene16(device16,sflags);
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,mesh);
+      scene16.addGeometry(RTC_BUILD_QUALITY_MEDIUM,mesh);
+      rtcCommitScene (scene);
+      rtcCommitScene (scene16);
+      AssertNoError(device);
+      AssertNoError(device16);
+
+      /* rays from a box around the sphere towards random points near it, some of them miss */
+      const unsigned int numRays = 256;
+      RTCRayHit rays[numRays], rays16[numRays];
+      for (unsigned int i=0; i<numRays; i++) {
+        const Vec3fa org(4.0f*random_float()-2.0f,4.0f*random_float()-2.0f,-3.0f);
+        const Vec3fa dst(2.4f*random_float()-1.2f,2.4f*random_float()-1.2f,0.0f);
+        rays[i] = rays16[i] = makeRay(org,dst-org);
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,numRays);
+      IntersectWithMode(imode,ivariant,scene16,rays16,numRays);
+      AssertNoError(device);
+      AssertNoError(device16);
+
+      bool passed = true;
+      for (unsigned int i=0; i<numRays; i++)
+      {
+        if ((ivariant & VARIANT_INTERSECT) == VARIANT_INTERSECT) {
+          passed &= rays[i].hit.geomID == rays16[i].hit.geomID;
+          if (rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID)
+            passed &= abs(rays[i].ray.tfar - rays16[i].ray.tfar) <= 1E-4f*rays[i].ray.tfar;
+        }
+        else
+          passed &= (rays[i].ray.tfar == float(neg_inf)) == (rays16[i].ray.tfar == float(neg_inf));
+      }
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct CompactVertexTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCGeometryType gtype;
+    RTCFormat format;
+    unsigned int numTimeSteps;
+
+    CompactVertexTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant, RTCGeometryType gtype, RTCFormat format, unsigned int numTimeSteps)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gtype(gtype), format(format), numTimeSteps(numTimeSteps) {}
+
+    /* converts floats that are exactly representable as half precision floats */
+    static unsigned short floatToHalf(float f)
+    {
+      unsigned int b; memcpy(&b,&f,sizeof(b));
+      if ((b & 0x7FFFFFFF) == 0) return (unsigned short)(b >> 16);
+      return (unsigned short)(((b >> 16) & 0x8000) | ((((b >> 23) & 0xFF)-112) << 10) | ((b >> 13) & 0x3FF));
+    }
+
+    struct Vertex16 { unsigned short x,y,z,pad; };
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* a bumpy grid whose vertices are exactly representable in the compact format,
+       * the FLOAT3 reference stores the decoded vertices */
+      const unsigned int n = 16;
+      const RTCBounds qbounds = { -4.0f, -4.0f, 0.0f, 0.0f, 4.0f, 4.0f, 2.0f, 0.0f };
+      const Vec3f qlower(qbounds.lower_x,qbounds.lower_y,qbounds.lower_z);
+      const Vec3f qscale = Vec3f(qbounds.upper_x-qbounds.lower_x,qbounds.upper_y-qbounds.lower_y,qbounds.upper_z-qbounds.lower_z)*(1.0f/65535.0f);
+      std::vector<std::vector<Vec3f>> vertices(numTimeSteps);
+      std::vector<std::vector<Vertex16>> vertices16(numTimeSteps);
+      for (unsigned int t=0; t<numTimeSteps; t++)
+      {
+        for (unsigned int y=0; y<=n; y++) {
+          for (unsigned int x=0; x<=n; x++)
+          {
+            const Vec3f p(0.5f*float(x)-4.0f,0.5f*float(y)-4.0f,0.125f*float((7*x+3*y)%8)+0.5f*float(t));
+            Vertex16 v;
+            if (format == RTC_FORMAT_HALF3) {
+              v.x = floatToHalf(p.x); v.y = floatToHalf(p.y); v.z = floatToHalf(p.z);
+              vertices[t].push_back(p);
+            } else {
+              v.x = (unsigned short) floor((p.x-qlower.x)/qscale.x+0.5f);
+              v.y = (unsigned short) floor((p.y-qlower.y)/qscale.y+0.5f);
+              v.z = (unsigned short) floor((p.z-qlower.z)/qscale.z+0.5f);
+              vertices[t].push_back(qlower+Vec3f(float(v.x),float(v.y),float(v.z))*qscale);
+            }
+            v.pad = 0;
+            vertices16[t].push_back(v);
+          }
+        }
+        vertices[t].push_back(Vec3f(zero)); // dummy vertex for 16 byte padding
+      }
+
+      std::vector<unsigned int> indices;
+      for (unsigned int y=0; y<n; y++) {
+        for (unsigned int x=0; x<n; x++)
+        {
+          const unsigned int i00 = y*(n+1)+x, i01 = i00+1, i10 = i00+n+1, i11 = i10+1;
+          if (gtype == RTC_GEOMETRY_TYPE_QUAD) {
+            indices.push_back(i00); indices.push_back(i01); indices.push_back(i11); indices.push_back(i10);
+          } else {
+            indices.push_back(i00); indices.push_back(i01); indices.push_back(i11);
+            indices.push_back(i00); indices.push_back(i11); indices.push_back(i10);
+          }
+        }
+      }
+      const unsigned int numIndices = gtype == RTC_GEOMETRY_TYPE_QUAD ? 4 : 3;
+      const RTCFormat indexFormat = gtype == RTC_GEOMETRY_TYPE_QUAD ? RTC_FORMAT_UINT4 : RTC_FORMAT_UINT3;
+
+      VerifyScene scene(device,sflags), sceneC(device,sflags);
+      for (int compact=0; compact<2; compact++)
+      {
+        RTCGeometry geom = rtcNewGeometry(device,gtype);
+        rtcSetGeometryTimeStepCount(geom,numTimeSteps);
+        rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,indexFormat,indices.data(),0,numIndices*sizeof(unsigned int),indices.size()/numIndices);
+        for (unsigned int t=0; t<numTimeSteps; t++) {
+          if (compact) rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,t,format,vertices16[t].data(),0,sizeof(Vertex16),vertices16[t].size());
+          else         rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,t,RTC_FORMAT_FLOAT3,vertices[t].data(),0,sizeof(Vec3f),vertices16[t].size());
+        }
+        if (compact && format == RTC_FORMAT_USHORT3)
+          rtcSetGeometryVertexQuantizationBounds(geom,&qbounds);
+        rtcCommitGeometry(geom);
+        rtcAttachGeometry(compact ? sceneC : scene,geom);
+        rtcReleaseGeometry(geom);
+      }
+      rtcCommitScene(scene);
+      rtcCommitScene(sceneC);
+      AssertNoError(device);
+
+      /* rays from above the grid towards random points on it, some of them miss */
+      const unsigned int numRays = 256;
+      RTCRayHit rays[numRays], raysC[numRays];
+      for (unsigned int i=0; i<numRays; i++) {
+        const Vec3fa org(6.0f*random_float()-3.0f,6.0f*random_float()-3.0f,5.0f);
+        const Vec3fa dst(9.0f*random_float()-4.5f,9.0f*random_float()-4.5f,0.0f);
+        rays[i] = makeRay(org,dst-org);
+        rays[i].ray.time = numTimeSteps > 1 ? random_float() : 0.0f;
+        raysC[i] = rays[i];
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,numRays);
+      IntersectWithMode(imode,ivariant,sceneC,raysC,numRays);
+      AssertNoError(device);
+
+      /* the compact vertices have to give the same hits as the decoded FLOAT3 vertices */
+      bool passed = true;
+      for (unsigned int i=0; i<numRays; i++)
+      {
+        if ((ivariant & VARIANT_INTERSECT) == VARIANT_INTERSECT) {
+          passed &= rays[i].hit.geomID == raysC[i].hit.geomID;
+          if (rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID)
+            passed &= abs(rays[i].ray.tfar - raysC[i].ray.tfar) <= 1E-4f*rays[i].ray.tfar;
+        }
+        else
+          passed &= (rays[i].ray.tfar == float(neg_inf)) == (raysC[i].ray.tfar == float(neg_inf));
+      }
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct PrimRefGenTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCGeometryType gtype;
+
+    PrimRefGenTest (std::string name, int isa, SceneFlags sflags, RTCGeometryType gtype)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gtype(gtype) {}
+
+    typedef CompactVertexTest::Vertex16 Vertex16;
+
+    static const unsigned int numPrims = 1027; // not a multiple of any SIMD width
+    static const unsigned int numColumns = 32;
+
+    /* primitives are valid, degenerate, have a NaN or infinite vertex, or an index out of range */
+    enum Kind { VALID, DEGENERATE, NAN_VERTEX, INF_VERTEX, INVALID_INDEX };
+
+    static Kind kind(unsigned int k)
+    {
+      switch (k%9) {
+      case 5 : return DEGENERATE;
+      case 6 : return NAN_VERTEX;
+      case 7 : return INF_VERTEX;
+      case 8 : return INVALID_INDEX;
+      default: return VALID;
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* each primitive lies in its own unit cell with unshared vertices that are exactly representable as half floats */
+      const unsigned int numVertices = gtype == RTC_GEOMETRY_TYPE_QUAD ? 4 : 3;
+      const Vec3f base[4] = { Vec3f(0.0f,0.0f,0.0f), Vec3f(0.75f,0.0f,0.0f), Vec3f(0.75f,0.75f,0.0f), Vec3f(0.0f,0.75f,0.0f) };
+      std::vector<Vec3f> vertices(numPrims*numVertices+1,Vec3f(zero)); // one dummy vertex for 16 byte padding
+      std::vector<Vertex16> vertices16(numPrims*numVertices);
+      std::vector<unsigned int> indices(numPrims*numVertices);
+      for (unsigned int k=0; k<numPrims; k++)
+      {
+        const Vec3f org(float(k%numColumns),float(k/numColumns),0.25f*float(k%4));
+        for (unsigned int i=0; i<numVertices; i++)
+        {
+          const unsigned int j = k*numVertices+i;
+          const Vec3f& v = gtype == RTC_GEOMETRY_TYPE_QUAD || i < 2 ? base[i] : base[3];
+          vertices[j] = kind(k) == DEGENERATE ? org+Vec3f(0.25f*float(i),0.0f,0.0f) : org+v;
+          vertices16[j].x = CompactVertexTest::floatToHalf(vertices[j].x);
+          vertices16[j].y = CompactVertexTest::floatToHalf(vertices[j].y);
+          vertices16[j].z = CompactVertexTest::floatToHalf(vertices[j].z);
+          vertices16[j].pad = 0;
+          indices[j] = j;
+        }
+
+        const unsigned int j = k*numVertices+(k%numVertices);
+        if (kind(k) == NAN_VERTEX) {
+          vertices[j][k%3] = float(nan);
+          (&vertices16[j].x)[k%3] = 0x7E00;
+        }
+        else if (kind(k) == INF_VERTEX) {
+          vertices[j][k%3] = k%2 ? float(neg_inf) : float(pos_inf);
+          (&vertices16[j].x)[k%3] = k%2 ? 0xFC00 : 0x7C00;
+        }
+        else if (kind(k) == INVALID_INDEX)
+          indices[j] = numPrims*numVertices+k;
+      }
+
+      /* FLOAT3 vertices get their primrefs generated vectorized, HALF3 vertices take the scalar path */
+      const RTCFormat indexFormat = gtype == RTC_GEOMETRY_TYPE_QUAD ? RTC_FORMAT_UINT4 : RTC_FORMAT_UINT3;
+      VerifyScene scene(device,sflags), scene16(device,sflags);
+      for (int half=0; half<2; half++)
+      {
+        RTCGeometry geom = rtcNewGeometry(device,gtype);
+        rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,indexFormat,indices.data(),0,numVertices*sizeof(unsigned int),numPrims);
+        if (half) rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_HALF3,vertices16.data(),0,sizeof(Vertex16),vertices16.size());
+        else      rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,vertices.data(),0,sizeof(Vec3f),vertices16.size());
+        rtcCommitGeometry(geom);
+        rtcAttachGeometry(half ? scene16 : scene,geom);
+        rtcReleaseGeometry(geom);
+      }
+      rtcCommitScene(scene);
+      rtcCommitScene(scene16);
+      AssertNoError(device);
+
+      /* both paths have to drop the same primitives and produce the same bounds */
+      RTCBounds bounds, bounds16;
+      rtcGetSceneBounds(scene,&bounds);
+      rtcGetSceneBounds(scene16,&bounds16);
+      if (bounds.lower_x != bounds16.lower_x || bounds.lower_y != bounds16.lower_y || bounds.lower_z != bounds16.lower_z ||
+          bounds.upper_x != bounds16.upper_x || bounds.upper_y != bounds16.upper_y || bounds.upper_z != bounds16.upper_z)
+        return VerifyApplication::FAILED;
+
+      /* one ray into each cell, only valid primitives get hit */
+      std::vector<RTCRayHit> rays(numPrims), rays16(numPrims);
+      for (unsigned int k=0; k<numPrims; k++) {
+        rays[k] = rays16[k] = makeRay(Vec3fa(float(k%numColumns)+0.2f,float(k/numColumns)+0.2f,2.0f),Vec3fa(0.0f,0.0f,-1.0f));
+        rtcIntersect1(scene,&rays[k]);
+        rtcIntersect1(scene16,&rays16[k]);
+      }
+      AssertNoError(device);
+
+      for (unsigned int k=0; k<numPrims; k++)
+      {
+        if (kind(k) != VALID) {
+          if (rays[k].hit.geomID != RTC_INVALID_GEOMETRY_ID || rays16[k].hit.geomID != RTC_INVALID_GEOMETRY_ID)
+            return VerifyApplication::FAILED;
+          continue;
+        }
+        const float tfar = 2.0f-0.25f*float(k%4);
+        if (rays[k].hit.primID != k || rays16[k].hit.primID != k) return VerifyApplication::FAILED;
+        if (abs(rays[k].ray.tfar-tfar) > 1E-5f || abs(rays16[k].ray.tfar-tfar) > 1E-5f) return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct MotionTimeStepTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCGeometryType gtype;
+    bool compress;
+
+    MotionTimeStepTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant, RTCGeometryType gtype, bool compress)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gtype(gtype), compress(compress) {}
+
+    static const unsigned int numTimeSteps = 3;
+
+    /* the primitive moves along x by 4 units until time 0.2 and by another 4 units until time 1 */
+    static float offset(float time, const float* times)
+    {
+      const float offsets[numTimeSteps] = { 0.0f, 4.0f, 8.0f };
+      const unsigned int i = time < times[1] ? 0 : 1;
+      const float f = (time-times[i])/(times[i+1]-times[i]);
+      return (1.0f-f)*offsets[i] + f*offsets[i+1];
+    }
+
+    /* traces one ray per time towards the primitive, shifted by y, and returns for each whether it hit */
+    std::vector<bool> trace(RTCScene scene, const std::vector<float>& rayTimes, const float* times, float y)
+    {
+      std::vector<RTCRayHit> rays(rayTimes.size());
+      for (size_t i=0; i<rays.size(); i++) {
+        rays[i] = makeRay(Vec3fa(offset(rayTimes[i],times)+0.25f,y+0.25f,1.0f),Vec3fa(0.0f,0.0f,-1.0f));
+        rays[i].ray.time = rayTimes[i];
+      }
+      IntersectWithMode(imode,ivariant,scene,rays.data(),(unsigned int)rays.size());
+      
+      std::vector<bool> hits(rays.size());
+      for (size_t i=0; i<rays.size(); i++) {
+        if ((ivariant & VARIANT_INTERSECT) == VARIANT_INTERSECT)
+          hits[i] = rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID && abs(rays[i].ray.tfar-1.0f) < 1E-4f;
+        else
+          hits[i] = rays[i].ray.tfar == float(neg_inf);
+      }
+      return hits;
+    }
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      const float times[numTimeSteps] = { 0.0f, 0.2f, 1.0f };
+      const float uniformTimes[numTimeSteps] = { 0.0f, 0.5f, 1.0f };
+      const unsigned int numVertices = gtype == RTC_GEOMETRY_TYPE_QUAD ? 4 : 3;
+      const Vec3f base[4] = { Vec3f(0.0f,0.0f,0.0f), Vec3f(1.0f,0.0f,0.0f), Vec3f(1.0f,1.0f,0.0f), Vec3f(0.0f,1.0f,0.0f) };
+      const unsigned int indices[4] = { 0, 1, 2, 3 };
+
+      /* the vertex buffers of all time steps, shifted along y, one dummy vertex for 16 byte padding */
+      auto createVertices = [&] (float y) {
+        std::vector<std::vector<Vec3f>> vertices(numTimeSteps,std::vector<Vec3f>(numVertices+1,Vec3f(zero)));
+        for (unsigned int t=0; t<numTimeSteps; t++)
+          for (unsigned int i=0; i<numVertices; i++) {
+            const Vec3f& v = gtype == RTC_GEOMETRY_TYPE_QUAD || i < 2 ? base[i] : base[3];
+            vertices[t][i] = Vec3f(v.x+offset(times[t],times),v.y+y,v.z);
+          }
+        return vertices;
+      };
+      std::vector<std::vector<Vec3f>> vertices = createVertices(0.0f);
+      
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+      RTCGeometry geom = rtcNewGeometry(device,gtype);
+      rtcSetGeometryTimeStepCount(geom,numTimeSteps);
+      rtcSetGeometryTimeStepTimes(geom,times,numTimeSteps);
+      if (compress) rtcSetGeometryVertexMotionCompression(geom,true);
+      if (gtype == RTC_GEOMETRY_TYPE_QUAD)
+        rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT4,indices,0,4*sizeof(unsigned int),1);
+      else
+        rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,indices,0,3*sizeof(unsigned int),1);
+      for (unsigned int t=0; t<numTimeSteps; t++)
+        rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,t,RTC_FORMAT_FLOAT3,vertices[t].data(),0,sizeof(Vec3f),numVertices);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* rays follow the non-uniform motion, at times 0.1 and 0.6 uniformly spaced time steps would put the primitive more than one unit away */
+      const std::vector<float> rayTimes = { 0.0f, 0.05f, 0.1f, 0.2f, 0.35f, 0.6f, 0.9f, 1.0f };
+      const std::vector<float> missTimes = { 0.1f, 0.6f };
+      bool passed = true;
+      for (bool hit : trace(scene,rayTimes,times,0.0f)) passed &= hit;
+      for (bool hit : trace(scene,missTimes,uniformTimes,0.0f)) passed &= !hit;
+      AssertNoError(device);
+
+      if (compress)
+      {
+        /* modifying only the first time step requires the motion to get compressed again, which fails without the other time steps */
+        for (unsigned int i=0; i<numVertices; i++) vertices[0][i].y += 10.0f;
+        rtcUpdateGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0);
+        rtcCommitGeometry(geom);
+        rtcCommitScene(scene);
+        AssertError(device,RTC_ERROR_INVALID_OPERATION);
+
+        /* setting all time steps again compresses the motion relative to the new first time step */
+        std::vector<std::vector<Vec3f>> moved = createVertices(10.0f);
+        for (unsigned int t=0; t<numTimeSteps; t++)
+          rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,t,RTC_FORMAT_FLOAT3,moved[t].data(),0,sizeof(Vec3f),numVertices);
+        rtcCommitGeometry(geom);
+        rtcCommitScene(scene);
+        AssertNoError(device);
+
+        for (bool hit : trace(scene,rayTimes,times,10.0f)) passed &= hit;
+        for (bool hit : trace(scene,rayTimes,times,0.0f)) passed &= !hit;
+        AssertNoError(device);
+      }
+      rtcReleaseGeometry(geom);
+
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct TimeStepBoundsTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCGeometryType gtype;
+
+    TimeStepBoundsTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant, RTCGeometryType gtype)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gtype(gtype) {}
+
+    static const unsigned int numPrims = 16; // number of primitives of each motion blurred geometry
+
+    /* the primitives zigzag along x between consecutive time steps, neighbouring primitives in opposite phase */
+    static float offset(float time, const std::vector<float>& times, unsigned int primID)
+    {
+      unsigned int i = 0;
+      while (i+2 < times.size() && time > times[i+1]) i++;
+      const float f = (time-times[i])/(times[i+1]-times[i]);
+      const float x0 = float((i+primID)%2)*2.0f;
+      const float x1 = float((i+1+primID)%2)*2.0f;
+      return (1.0f-f)*x0 + f*x1;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* a static geometry followed by geometries with 4 uniform and 8 non-uniform time segments, enough to cache their bounds per time step */
+      std::vector<std::vector<float>> times(3);
+      times[0] = { 0.0f };
+      for (unsigned int t=0; t<5; t++) times[1].push_back(float(t)/4.0f);
+      for (unsigned int t=0; t<9; t++) times[2].push_back(float(t*t)/64.0f);
+
+      const unsigned int numVertices = gtype == RTC_GEOMETRY_TYPE_QUAD ? 4 : 3;
+      const Vec3f base[4] = { Vec3f(0.0f,0.0f,0.0f), Vec3f(1.0f,0.0f,0.0f), Vec3f(1.0f,1.0f,0.0f), Vec3f(0.0f,1.0f,0.0f) };
+      std::vector<unsigned int> indices;
+      for (unsigned int k=0; k<numPrims; k++)
+        for (unsigned int i=0; i<numVertices; i++)
+          indices.push_back(k*numVertices+i);
+
+      /* primitive k of geometry g moves within the cell at x=6*k and y=4*g, one dummy vertex for 16 byte padding */
+      std::vector<std::vector<std::vector<Vec3f>>> vertices(times.size());
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+      for (unsigned int g=0; g<times.size(); g++)
+      {
+        const unsigned int numTimeSteps = (unsigned int) times[g].size();
+        vertices[g].resize(numTimeSteps,std::vector<Vec3f>(numPrims*numVertices+1,Vec3f(zero)));
+        for (unsigned int t=0; t<numTimeSteps; t++)
+          for (unsigned int k=0; k<numPrims; k++)
+            for (unsigned int i=0; i<numVertices; i++) {
+              const Vec3f& v = gtype == RTC_GEOMETRY_TYPE_QUAD || i < 2 ? base[i] : base[3];
+              const float x = numTimeSteps > 1 ? offset(times[g][t],times[g],k) : 0.0f;
+              vertices[g][t][k*numVertices+i] = Vec3f(v.x+6.0f*float(k)+x,v.y+4.0f*float(g),v.z);
+            }
+
+        RTCGeometry geom = rtcNewGeometry(device,gtype);
+        rtcSetGeometryTimeStepCount(geom,numTimeSteps);
+        if (g == 2) rtcSetGeometryTimeStepTimes(geom,times[g].data(),numTimeSteps);
+        if (gtype == RTC_GEOMETRY_TYPE_QUAD)
+          rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT4,indices.data(),0,4*sizeof(unsigned int),numPrims);
+        else
+          rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,indices.data(),0,3*sizeof(unsigned int),numPrims);
+        for (unsigned int t=0; t<numTimeSteps; t++)
+          rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,t,RTC_FORMAT_FLOAT3,vertices[g][t].data(),0,sizeof(Vec3f),numPrims*numVertices);
+        rtcCommitGeometry(geom);
+        rtcAttachGeometry(scene,geom);
+        rtcReleaseGeometry(geom);
+      }
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* rays at random times towards each primitive of the motion blurred geometries have to hit it,
+       * rays mirrored to the opposite end of the zigzag have to miss when that is more than one unit away */
+      std::vector<RTCRayHit> rays;
+      std::vector<unsigned int> geomIDs, primIDs;
+      std::vector<bool> expectHit;
+      for (unsigned int g=1; g<times.size(); g++)
+        for (unsigned int k=0; k<numPrims; k++)
+          for (unsigned int j=0; j<4; j++)
+          {
+            const float time = random_float();
+            const float x = offset(time,times[g],k);
+            for (bool hit : { true, false })
+            {
+              if (!hit && abs(x-1.0f) < 0.6f) continue;
+              RTCRayHit ray = makeRay(Vec3fa(6.0f*float(k)+(hit ? x : 2.0f-x)+0.25f,4.0f*float(g)+0.25f,1.0f),Vec3fa(0.0f,0.0f,-1.0f));
+              ray.ray.time = time;
+              rays.push_back(ray); geomIDs.push_back(g); primIDs.push_back(k); expectHit.push_back(hit);
+            }
+          }
+      IntersectWithMode(imode,ivariant,scene,rays.data(),(unsigned int)rays.size());
+      AssertNoError(device);
+
+      bool passed = true;
+      for (size_t i=0; i<rays.size(); i++)
+      {
+        if ((ivariant & VARIANT_INTERSECT) == VARIANT_INTERSECT) {
+          if (!expectHit[i]) passed &= rays[i].hit.geomID == RTC_INVALID_GEOMETRY_ID;
+          else passed &= rays[i].hit.geomID == geomIDs[i] && rays[i].hit.primID == primIDs[i] && abs(rays[i].ray.tfar-1.0f) < 1E-4f;
+        }
+        else
+          passed &= (rays[i].ray.tfar == float(neg_inf)) == expectHit[i];
+      }
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct OccludedBatchTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+    unsigned int numRaysPerGroup;
+
+    OccludedBatchTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, unsigned int numRaysPerGroup)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality), numRaysPerGroup(numRaysPerGroup) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+      scene.addGeometry(quality,SceneGraph::createTriangleSphere(Vec3fa(0.0f,2.0f,0.0f),0.5f,50));
+      scene.addGeometry(quality,SceneGraph::createQuadSphere(Vec3fa(1.0f,2.0f,0.5f),0.3f,20));
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* shadow rays from shading points on the ground towards samples of
+       * an area light above the spheres, the group of the 4th shading point
+       * is empty and every 5th ray is disabled */
+      const unsigned int numGroups = 16;
+      std::vector<unsigned int> offsets(numGroups+1);
+      std::vector<RTCRay> rays;
+      for (unsigned int g=0; g<numGroups; g++)
+      {
+        offsets[g] = (unsigned int) rays.size();
+        if (g == 3) continue;
+        const Vec3fa org(4.0f*random_float()-2.0f,0.0f,4.0f*random_float()-2.0f);
+        for (unsigned int i=0; i<numRaysPerGroup; i++) {
+          const Vec3fa light(random_float()-0.5f,4.0f,random_float()-0.5f);
+          const size_t j = rays.size();
+          rays.push_back(makeRay(org,light-org,0.0f,j%5 == 2 ? -1.0f : 1.0f).ray);
+        }
+      }
+      offsets[numGroups] = (unsigned int) rays.size();
+
+      std::vector<RTCRay> rays1 = rays;
+      rtcOccludedBatch(scene,rays.data(),offsets.data(),numGroups);
+      for (size_t i=0; i<rays1.size(); i++)
+        rtcOccluded1(scene,&rays1[i]);
+      AssertNoError(device);
+
+      /* the batch has to find the same occlusions as single rays */
+      bool passed = true;
+      for (size_t i=0; i<rays.size(); i++)
+        passed &= rays[i].tfar == rays1[i].tfar;
+
+      /* not ascending group offsets are rejected */
+      std::swap(offsets[1],offsets[2]);
+      rtcOccludedBatch(scene,rays.data(),offsets.data(),numGroups);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct OccluderCacheTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    OccluderCacheTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    static const unsigned int numPlanes = 64;
+
+    /* only the last plane occludes, the filter counts all tested hits */
+    static void occludedFilter(const RTCFilterFunctionNArguments* args)
+    {
+      size_t* numHits = (size_t*) args->geometryUserPtr;
+      for (unsigned int i=0; i<args->N; i++)
+      {
+        if (args->valid[i] == 0) continue;
+        (*numHits)++;
+        if (RTCHitN_primID(args->hit,args->N,i) != numPlanes)
+          args->valid[i] = 0;
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+
+      /* a stack of large planes, all rays hit every plane but only the last one blocks them */
+      size_t numHits = 0;
+      RTCGeometry geom = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_TRIANGLE);
+      Vec3f* vertices = (Vec3f*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,sizeof(Vec3f),3*(numPlanes+1));
+      Triangle* triangles = (Triangle*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,sizeof(Triangle),numPlanes+1);
+      for (unsigned int i=0; i<=numPlanes; i++) {
+        const float z = float(i+1);
+        vertices[3*i+0] = Vec3f(-100.0f,-100.0f,z);
+        vertices[3*i+1] = Vec3f(+100.0f,-100.0f,z);
+        vertices[3*i+2] = Vec3f(   0.0f,+100.0f,z);
+        triangles[i] = Triangle(3*i+0,3*i+1,3*i+2);
+      }
+      rtcSetGeometryUserData(geom,&numHits);
+      rtcSetGeometryOccludedFilterFunction(geom,occludedFilter);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* one group of shadow rays towards a small light behind the planes */
+      const unsigned int numRays = 64;
+      std::vector<RTCRay> rays;
+      for (unsigned int i=0; i<numRays; i++) {
+        const Vec3fa light(random_float()-0.5f,random_float()-0.5f,2.0f*numPlanes);
+        rays.push_back(makeRay(Vec3fa(0.0f),light,0.0f,1.0f).ray);
+      }
+      std::vector<RTCRay> rays1 = rays;
+
+      unsigned int offsets[2] = { 0, numRays };
+      rtcOccludedBatch(scene,rays.data(),offsets,1);
+      const size_t numBatchHits = numHits;
+      numHits = 0;
+      for (size_t i=0; i<numRays; i++)
+        rtcOccluded1(scene,&rays1[i]);
+      const size_t numSingleHits = numHits;
       AssertNoError(device);
-      
-      return VerifyApplication::PASSED;
+
+      bool passed = true;
+      for (size_t i=0; i<numRays; i++)
+        passed &= rays[i].tfar == float(neg_inf) && rays1[i].tfar == float(neg_inf);
+
+      /* single rays test all planes in front of the occluder, the batch
+       * rays mostly only test the leaf of the cached occluder */
+      passed &= 4*numBatchHits < numSingleHits;
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
     }
   };
-  
+
   struct RayMasksTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags; 
@@ -2692,6 +4345,160 @@ namespace embree
     }
   };
 
+  struct BuiltinFilterTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+    bool opacity;
+
+    BuiltinFilterTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, bool opacity, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality), opacity(opacity) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      Vec3f vertices[7] = {
+        Vec3f(0.0f,0.0f,0.0f), Vec3f(1.0f,0.0f,0.0f), Vec3f(0.0f,1.0f,0.0f),
+        Vec3f(2.0f,0.0f,0.0f), Vec3f(3.0f,0.0f,0.0f), Vec3f(2.0f,1.0f,0.0f),
+        Vec3f(zero) // dummy vertex for 16 byte padding
+      };
+      Triangle triangles[2] = {
+        Triangle(0,1,2), Triangle(3,4,5)
+      };
+      /* the second triangle gets removed by the filter */
+      unsigned int masks[2] = { 1, 2 };
+      float opacities[2] = { 1.0f, 0.25f };
+
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+
+      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryBuildQuality(geom,quality);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices , 0, sizeof(Vec3f), 6);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX , 0, RTC_FORMAT_UINT3,  triangles, 0, sizeof(Triangle), 2);
+      if (opacity) rtcSetGeometryPrimitiveOpacityBuffer(geom,opacities,sizeof(float),0.5f);
+      else         rtcSetGeometryPrimitiveMaskBuffer(geom,masks,sizeof(unsigned int));
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      RTCRayHit rays[256];
+      for (size_t i=0; i<256; i++)
+      {
+        Vec3fa from(0.0f,0.0f,-1.0f);
+        Vec3fa to = Vec3fa(0.25f + 2.0f*float(i%2),0.25f,0.0f);
+        rays[i] = makeRay(from,to-from);
+        rays[i].ray.mask = 1;
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      bool passed = true;
+      for (size_t i=0; i<256; i++)
+      {
+        const bool visible = (i%2) == 0;
+        if ((ivariant & VARIANT_INTERSECT) == VARIANT_INTERSECT) {
+          passed &= visible == (rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID);
+          passed &= !visible || rays[i].hit.primID == 0;
+        }
+        else
+          passed &= visible == (rays[i].ray.tfar == float(neg_inf));
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct AlphaTextureTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCGeometryType gtype;
+
+    AlphaTextureTest (std::string name, int isa, SceneFlags sflags, RTCGeometryType gtype, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gtype(gtype) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* unit square or its lower left half, the texture coordinates are the xy coordinates of the vertices */
+      const bool quad = gtype == RTC_GEOMETRY_TYPE_QUAD;
+      Vec3f vertices[5] = { Vec3f(0.0f,0.0f,0.0f), Vec3f(1.0f,0.0f,0.0f), quad ? Vec3f(1.0f,1.0f,0.0f) : Vec3f(0.0f,1.0f,0.0f), Vec3f(0.0f,1.0f,0.0f), Vec3f(zero) };
+      float texcoords[10];
+      for (size_t i=0; i<5; i++) {
+        texcoords[2*i+0] = vertices[i].x;
+        texcoords[2*i+1] = vertices[i].y;
+      }
+      unsigned int indices[4] = { 0, 1, 2, 3 };
+
+      /* 2x2 checkerboard of opaque and transparent texels */
+      const unsigned char texels[4] = { 255, 0, 0, 255 };
+      const unsigned int texcoordSlot = 1;
+
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+
+      RTCGeometry geom = rtcNewGeometry (device, gtype);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices, 0, sizeof(Vec3f), quad ? 4 : 3);
+      if (quad) rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT4, indices, 0, 4*sizeof(unsigned int), 1);
+      else      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, indices, 0, 3*sizeof(unsigned int), 1);
+      rtcSetGeometryVertexAttributeCount(geom,texcoordSlot+1);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE, texcoordSlot, RTC_FORMAT_FLOAT2, texcoords, 0, 2*sizeof(float), quad ? 4 : 3);
+      rtcSetGeometryAlphaTexture(geom,texels,2,2,texcoordSlot,0.5f);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+
+      /* rays through transparent texels continue to an opaque square behind */
+      Vec3f backVertices[5] = { Vec3f(0.0f,0.0f,1.0f), Vec3f(1.0f,0.0f,1.0f), Vec3f(1.0f,1.0f,1.0f), Vec3f(0.0f,1.0f,1.0f), Vec3f(zero) };
+      RTCGeometry back = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_QUAD);
+      rtcSetSharedGeometryBuffer(back, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, backVertices, 0, sizeof(Vec3f), 4);
+      rtcSetSharedGeometryBuffer(back, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT4, indices, 0, 4*sizeof(unsigned int), 1);
+      rtcCommitGeometry(back);
+      const bool withBack = (ivariant & VARIANT_INTERSECT) == VARIANT_INTERSECT;
+      if (withBack) rtcAttachGeometry(scene,back);
+      rtcReleaseGeometry(back);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* rays through the centers of a 5x5 grid of cells, none of them on a texel or primitive border */
+      std::vector<RTCRayHit> rays;
+      std::vector<Vec2f> st;
+      for (size_t y=0; y<5; y++) {
+        for (size_t x=0; x<5; x++) {
+          const Vec2f p(0.1f+0.2f*float(x),0.1f+0.2f*float(y));
+          if (!quad && p.x+p.y >= 1.0f) continue;
+          rays.push_back(makeRay(Vec3fa(p.x,p.y,-1.0f),Vec3fa(0.0f,0.0f,1.0f)));
+          st.push_back(p);
+        }
+      }
+      IntersectWithMode(imode,ivariant,scene,rays.data(),(unsigned int)rays.size());
+      AssertNoError(device);
+
+      bool passed = true;
+      for (size_t i=0; i<rays.size(); i++)
+      {
+        const bool opaque = texels[2*int(2.0f*st[i].y)+int(2.0f*st[i].x)] >= 128;
+        if (withBack) {
+          passed &= rays[i].hit.geomID == (opaque ? 0 : 1);
+          passed &= abs(rays[i].ray.tfar - (opaque ? 1.0f : 2.0f)) < 1E-4f;
+        }
+        else
+          passed &= opaque == (rays[i].ray.tfar == float(neg_inf));
+      }
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct BackfaceCullingTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags;
@@ -2940,6 +4747,57 @@ namespace embree
     }
   };
 
+  struct FarInstanceTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    bool mblur;
+    static const size_t N = 16;
+
+    FarInstanceTest (std::string name, int isa, SceneFlags sflags, bool mblur, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), mblur(mblur) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* a scaled plane instanced far away from the world origin, the scale makes world2local inexact */
+      const Vec3fa origin(1048576.0f,-1048576.0f,1048576.0f);
+      const AffineSpace3fa xfm = AffineSpace3fa::translate(origin)*AffineSpace3fa::scale(Vec3fa(3.0f));
+      Ref<SceneGraph::Node> plane = SceneGraph::createTrianglePlane(Vec3fa(-1.0f,-1.0f,0.0f),Vec3fa(2.0f,0.0f,0.0f),Vec3fa(0.0f,2.0f,0.0f),4,4);
+      Ref<SceneGraph::Node> instance = mblur ? new SceneGraph::TransformNode(xfm,xfm,plane) : new SceneGraph::TransformNode(xfm,plane);
+
+      VerifyScene scene(device,sflags);
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,instance);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* shoot rays down onto the plane from just above it, the ray origins are multiples of 1/8 away from the instance origin */
+      RTCRayHit rays[N];
+      float dist[N];
+      for (size_t i=0; i<N; i++)
+      {
+        const Vec3fa xy = floor(8.0f*(4.0f*random_Vec3fa()-Vec3fa(2.0f)))/8.0f;
+        const Vec3fa org = origin + Vec3fa(xy.x,xy.y,0.125f*float(i+1));
+        dist[i] = org.z-origin.z;
+        rays[i] = makeRay(org,Vec3fa(0.0f,0.0f,-1.0f));
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,N);
+      AssertNoError(device);
+
+      bool passed = true;
+      for (size_t i=0; i<N; i++)
+      {
+        if (ivariant & VARIANT_INTERSECT)
+          passed &= rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID && abs(rays[i].ray.tfar-dist[i]) < 1E-4f;
+        else
+          passed &= rays[i].ray.tfar == float(neg_inf);
+      }
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   #if defined(EMBREE_GEOMETRY_INSTANCE_ARRAY)
 
   struct InstanceArrayTest : public VerifyApplication::IntersectTest
@@ -3549,6 +5407,86 @@ namespace embree
     }
   };
 
+  struct InstanceArrayLODTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    static const size_t N = 64;
+
+    InstanceArrayLODTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* the coarse level 1 is larger than the detailed level 0 */
+      VerifyScene lod0(device,sflags), lod1(device,sflags);
+      lod0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(0.0f),1.0f,64));
+      lod1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(0.0f),2.0f,64));
+      rtcCommitScene(lod0);
+      rtcCommitScene(lod1);
+      AssertNoError(device);
+
+      RTCScene scenes[2] = { lod0, lod1 };
+      AffineSpace3fa xfm = one;
+      unsigned int index = 0;
+      const float distance = 10.0f;
+
+      VerifyScene scene(device,sflags);
+      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE_ARRAY);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_TRANSFORM, 0, RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, (void*)&xfm, 0, sizeof(AffineSpace3fa), 1);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT, (void*)&index, 0, sizeof(unsigned int), 1);
+      rtcSetGeometryInstancedScenes(geom, scenes, 2);
+      rtcSetGeometryInstanceLODs(geom, &distance, 1, 4.0f);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      bool passed = true;
+
+      /* rays close to the instance select level 0, distant rays level 1, also where level 1 sticks out of level 0 */
+      RTCRayHit rays[N];
+      rays[0] = makeRay(Vec3fa(0.0f,0.0f,-5.0f),Vec3fa(0,0,1));
+      rays[1] = makeRay(Vec3fa(0.0f,0.0f,-20.0f),Vec3fa(0,0,1));
+      rays[2] = makeRay(Vec3fa(1.5f,0.0f,-20.0f),Vec3fa(0,0,1));
+      IntersectWithMode(imode,ivariant,scene,rays,3);
+      passed &= rays[0].hit.geomID != RTC_INVALID_GEOMETRY_ID && abs(rays[0].ray.tfar-4.0f) < 0.01f;
+      passed &= rays[1].hit.geomID != RTC_INVALID_GEOMETRY_ID && abs(rays[1].ray.tfar-18.0f) < 0.01f;
+      passed &= rays[2].hit.geomID != RTC_INVALID_GEOMETRY_ID && abs(rays[2].ray.tfar-(20.0f-sqrt(4.0f-1.5f*1.5f))) < 0.05f;
+
+      /* rays at the switching distance blend both levels, but the same ray always selects the same level */
+      float tfar[N];
+      size_t numLevel0 = 0, numLevel1 = 0;
+      for (size_t k=0; k<2; k++)
+      {
+        for (size_t i=0; i<N; i++) {
+          rays[i] = makeRay(Vec3fa(0.0f,0.0f,-distance),Vec3fa(0,0,1));
+          rays[i].ray.id = (unsigned int) i;
+        }
+        IntersectWithMode(imode,ivariant,scene,rays,N);
+        for (size_t i=0; i<N; i++)
+        {
+          passed &= rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID;
+          if (k == 0) {
+            tfar[i] = rays[i].ray.tfar;
+            numLevel0 += abs(tfar[i]-(distance-1.0f)) < 0.01f;
+            numLevel1 += abs(tfar[i]-(distance-2.0f)) < 0.01f;
+          }
+          else
+            passed &= rays[i].ray.tfar == tfar[i];
+        }
+      }
+      passed &= numLevel0 > 0 && numLevel1 > 0 && numLevel0+numLevel1 == N;
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
 #endif
 
   struct InactiveRaysTest : public VerifyApplication::IntersectTest
@@ -5658,8 +7596,10 @@ namespace embree
 	static const size_t numTilesX = width / tileSizeX;
 	static const size_t numTilesY = height / tileSizeY;
     
-    CoherentRaysBenchmark (std::string name, int isa, GeometryType gtype, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant, size_t numPhi)
-      : ParallelIntersectBenchmark(name,isa,numTilesX*numTilesY,1), gtype(gtype), sflags(sflags), quality(quality), imode(imode), ivariant(ivariant), numPhi(numPhi) {}
+    std::string config;
+    
+    CoherentRaysBenchmark (std::string name, int isa, GeometryType gtype, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant, size_t numPhi, std::string config = "")
+      : ParallelIntersectBenchmark(name,isa,numTilesX*numTilesY,1), gtype(gtype), sflags(sflags), quality(quality), imode(imode), ivariant(ivariant), numPhi(numPhi), config(config) {}
     
     size_t setNumPrimitives(size_t N) 
     { 
@@ -5673,6 +7613,7 @@ namespace embree
         return false;
 
       std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      if (config != "") cfg += ","+config;
       device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
       rtcSetDeviceErrorFunction(device,errorHandler,nullptr);
@@ -5820,8 +7761,10 @@ namespace embree
     static const size_t numRays = 16*1024*1024;
     static const size_t deltaRays = 1024;
     
-    IncoherentRaysBenchmark (std::string name, int isa, GeometryType gtype, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant, size_t numPhi)
-      : ParallelIntersectBenchmark(name,isa,numRays,deltaRays), gtype(gtype), sflags(sflags), quality(quality), imode(imode), ivariant(ivariant), numPhi(numPhi), device(nullptr)  {}
+    std::string config;
+    
+    IncoherentRaysBenchmark (std::string name, int isa, GeometryType gtype, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant, size_t numPhi, std::string config = "")
+      : ParallelIntersectBenchmark(name,isa,numRays,deltaRays), gtype(gtype), sflags(sflags), quality(quality), imode(imode), ivariant(ivariant), numPhi(numPhi), device(nullptr), config(config)  {}
 
     size_t setNumPrimitives(size_t N) 
     { 
@@ -5835,6 +7778,7 @@ namespace embree
         return false;
 
       std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      if (config != "") cfg += ","+config;
       device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
       rtcSetDeviceErrorFunction(device,errorHandler,nullptr);
@@ -6166,6 +8110,7 @@ namespace embree
     sceneFlagsRobust.push_back(SceneFlags(RTC_SCENE_FLAG_ROBUST | RTC_SCENE_FLAG_COMPACT,RTC_BUILD_QUALITY_MEDIUM));
     sceneFlagsRobust.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_ROBUST,        RTC_BUILD_QUALITY_LOW));
     sceneFlagsRobust.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_ROBUST | RTC_SCENE_FLAG_COMPACT,RTC_BUILD_QUALITY_LOW));
+    sceneFlagsRobust.push_back(SceneFlags(RTC_SCENE_FLAG_WATERTIGHT,    RTC_BUILD_QUALITY_MEDIUM));
 
     sceneFlagsDynamic.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,       RTC_BUILD_QUALITY_LOW));
     sceneFlagsDynamic.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,       RTC_BUILD_QUALITY_MEDIUM));
@@ -6240,8 +8185,24 @@ namespace embree
       push(new TestGroup("build",true,true));
       for (auto sflags : sceneFlags) 
         groups.top()->add(new BuildTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new MortonSplitBuildTest("morton_split."+to_string(sflags),isa,sflags));
       groups.pop();
       
+      push(new TestGroup("bvh_stream",true,true));
+      groups.top()->add(new BVHStreamTest("build_quality_low",isa,RTC_BUILD_QUALITY_LOW));
+      groups.top()->add(new BVHStreamTest("build_quality_medium",isa,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
+      push(new TestGroup("flat_bvh",true,true));
+      for (auto quality : { RTC_BUILD_QUALITY_LOW, RTC_BUILD_QUALITY_MEDIUM, RTC_BUILD_QUALITY_HIGH })
+        for (auto layout : { RTC_FLAT_BVH_NODE_LAYOUT_AOS, RTC_FLAT_BVH_NODE_LAYOUT_SOA, RTC_FLAT_BVH_NODE_LAYOUT_SOA_QUANTIZED })
+          for (unsigned int N : { 2, 4, 8 }) {
+            const char* layoutName = layout == RTC_FLAT_BVH_NODE_LAYOUT_AOS ? "aos" : layout == RTC_FLAT_BVH_NODE_LAYOUT_SOA ? "soa" : "soa_quantized";
+            groups.top()->add(new FlatBVHTest(to_string(quality)+"."+layoutName+".bvh"+std::to_string(N),isa,quality,layout,N));
+          }
+      groups.pop();
+
       push(new TestGroup("overlapping_primitives",true,false));
       for (auto sflags : sceneFlags)
         groups.top()->add(new OverlappingGeometryTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,clamp(int(intensity*10000),1000,100000)));
@@ -6278,6 +8239,13 @@ namespace embree
             if (has_variant(imode,ivariant)) {
               groups.top()->add(new UpdateTest("deformable."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_REFIT,imode,ivariant));
               groups.top()->add(new UpdateTest("dynamic."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_LOW,imode,ivariant));
+              groups.top()->add(new PrimRefCacheUpdateTest("primref_cache."+to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+              groups.top()->add(new PartialUpdateTest("partial_refit.triangle."+to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_TYPE_TRIANGLE,RTC_BUILD_QUALITY_REFIT,false,false,imode,ivariant));
+              groups.top()->add(new PartialUpdateTest("partial_refit.quad."+to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_TYPE_QUAD,RTC_BUILD_QUALITY_REFIT,false,false,imode,ivariant));
+              groups.top()->add(new PartialUpdateTest("partial_refit_rebuild.triangle."+to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_TYPE_TRIANGLE,RTC_BUILD_QUALITY_REFIT,true,false,imode,ivariant));
+              groups.top()->add(new PartialUpdateTest("byte_range.triangle."+to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_TYPE_TRIANGLE,RTC_BUILD_QUALITY_MEDIUM,false,true,imode,ivariant));
+              groups.top()->add(new PartialUpdateTest("byte_range.quad."+to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_TYPE_QUAD,RTC_BUILD_QUALITY_REFIT,false,true,imode,ivariant));
+              groups.top()->add(new SubdivLevelUpdateTest("subdiv_levels."+to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
             }
           }
         }
@@ -6355,6 +8323,115 @@ namespace embree
                 groups.top()->add(new QuadHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
       groups.pop();
 
+      push(new TestGroup("triangle_hit_obb",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+                groups.top()->add(new TriangleHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant,"bvh4obb.triangle4i"));
+      groups.pop();
+      
+      push(new TestGroup("quad_hit_obb",true,true));
+      for (auto& sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+                groups.top()->add(new QuadHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant,"bvh4obb.quad4i"));
+      groups.pop();
+
+      push(new TestGroup("multi_hit",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          if (imode != MODE_INTERSECT_NONE) {
+            groups.top()->add(new MultiHitTest(to_string(sflags,imode),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,false));
+            groups.top()->add(new MultiHitTest("instanced."+to_string(sflags,imode),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,true));
+          }
+      groups.pop();
+
+      push(new TestGroup("ray_cone",true,true));
+      for (auto sflags : sceneFlags) {
+        groups.top()->add(new RayConeTest(to_string(sflags)+".triangle",isa,sflags,RTC_GEOMETRY_TYPE_TRIANGLE,false));
+        groups.top()->add(new RayConeTest(to_string(sflags)+".triangle.instanced",isa,sflags,RTC_GEOMETRY_TYPE_TRIANGLE,true));
+        groups.top()->add(new RayConeTest(to_string(sflags)+".quad",isa,sflags,RTC_GEOMETRY_TYPE_QUAD,false));
+        groups.top()->add(new RayConeTest(to_string(sflags)+".round_linear_curve",isa,sflags,RTC_GEOMETRY_TYPE_ROUND_LINEAR_CURVE,false));
+      }
+      groups.pop();
+
+#if defined(EMBREE_TARGET_AVX512)
+      if (isa == AVX512)
+      {
+        push(new TestGroup("bvh16",true,true));
+        for (auto sflags : sceneFlags)
+          for (auto imode : intersectModes)
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new BVH16Test(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+        groups.pop();
+      }
+#endif
+
+      push(new TestGroup("compact_vertices",true,true));
+      for (auto sflags : sceneFlags)
+        for (auto imode : intersectModes)
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+              for (unsigned int numTimeSteps=1; numTimeSteps<=2; numTimeSteps++) {
+                const std::string name = to_string(sflags,imode,ivariant) + (numTimeSteps > 1 ? ".mblur" : "");
+                groups.top()->add(new CompactVertexTest("triangle.half3."+name,isa,sflags,imode,ivariant,RTC_GEOMETRY_TYPE_TRIANGLE,RTC_FORMAT_HALF3,numTimeSteps));
+                groups.top()->add(new CompactVertexTest("triangle.ushort3."+name,isa,sflags,imode,ivariant,RTC_GEOMETRY_TYPE_TRIANGLE,RTC_FORMAT_USHORT3,numTimeSteps));
+                groups.top()->add(new CompactVertexTest("quad.half3."+name,isa,sflags,imode,ivariant,RTC_GEOMETRY_TYPE_QUAD,RTC_FORMAT_HALF3,numTimeSteps));
+                groups.top()->add(new CompactVertexTest("quad.ushort3."+name,isa,sflags,imode,ivariant,RTC_GEOMETRY_TYPE_QUAD,RTC_FORMAT_USHORT3,numTimeSteps));
+              }
+      groups.pop();
+
+      push(new TestGroup("primref_generation",true,true));
+      for (auto sflags : sceneFlags) {
+        groups.top()->add(new PrimRefGenTest("triangle."+to_string(sflags),isa,sflags,RTC_GEOMETRY_TYPE_TRIANGLE));
+        groups.top()->add(new PrimRefGenTest("quad."+to_string(sflags),isa,sflags,RTC_GEOMETRY_TYPE_QUAD));
+      }
+      groups.pop();
+
+      push(new TestGroup("motion_time_steps",true,true));
+      for (auto sflags : sceneFlags)
+        for (auto imode : intersectModes)
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant)) {
+              const std::string name = to_string(sflags,imode,ivariant);
+              groups.top()->add(new MotionTimeStepTest("triangle."+name,isa,sflags,imode,ivariant,RTC_GEOMETRY_TYPE_TRIANGLE,false));
+              groups.top()->add(new MotionTimeStepTest("quad."+name,isa,sflags,imode,ivariant,RTC_GEOMETRY_TYPE_QUAD,false));
+              groups.top()->add(new MotionTimeStepTest("triangle.compressed."+name,isa,sflags,imode,ivariant,RTC_GEOMETRY_TYPE_TRIANGLE,true));
+              groups.top()->add(new MotionTimeStepTest("quad.compressed."+name,isa,sflags,imode,ivariant,RTC_GEOMETRY_TYPE_QUAD,true));
+            }
+      groups.pop();
+
+      push(new TestGroup("time_step_bounds",true,true));
+      for (auto sflags : sceneFlags)
+        for (auto imode : intersectModes)
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant)) {
+              const std::string name = to_string(sflags,imode,ivariant);
+              groups.top()->add(new TimeStepBoundsTest("triangle."+name,isa,sflags,imode,ivariant,RTC_GEOMETRY_TYPE_TRIANGLE));
+              groups.top()->add(new TimeStepBoundsTest("quad."+name,isa,sflags,imode,ivariant,RTC_GEOMETRY_TYPE_QUAD));
+            }
+      groups.pop();
+
+      push(new TestGroup("occluded_batch",true,true));
+      for (auto sflags : sceneFlags) {
+        groups.top()->add(new OccludedBatchTest(to_string(sflags)+".1",isa,sflags,RTC_BUILD_QUALITY_MEDIUM,1));
+        groups.top()->add(new OccludedBatchTest(to_string(sflags)+".37",isa,sflags,RTC_BUILD_QUALITY_MEDIUM,37));
+        groups.top()->add(new OccludedBatchTest(to_string(sflags)+".300",isa,sflags,RTC_BUILD_QUALITY_MEDIUM,300));
+        groups.top()->add(new OccluderCacheTest(to_string(sflags)+".cache",isa,sflags));
+      }
+      groups.pop();
+
+      push(new TestGroup("tile",true,true));
+      for (auto sflags : sceneFlags) {
+        groups.top()->add(new TileTest(to_string(sflags)+".16x16",isa,sflags,RTC_BUILD_QUALITY_MEDIUM,16,16));
+        groups.top()->add(new TileTest(to_string(sflags)+".13x5",isa,sflags,RTC_BUILD_QUALITY_MEDIUM,13,5));
+        groups.top()->add(new TileTest(to_string(sflags)+".200x1",isa,sflags,RTC_BUILD_QUALITY_MEDIUM,200,1));
+      }
+      groups.pop();
+
       if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_RAY_MASK_SUPPORTED)) 
       {
         push(new TestGroup("ray_masks",true,true));
@@ -6378,6 +8455,21 @@ namespace embree
         groups.pop();
       }
 
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED))
+      {
+        push(new TestGroup("builtin_filter",true,true));
+        for (auto sflags : sceneFlags) 
+          for (auto imode : intersectModes) 
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant)) {
+                groups.top()->add(new BuiltinFilterTest("mask."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,false,imode,ivariant));
+                groups.top()->add(new BuiltinFilterTest("opacity."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,true,imode,ivariant));
+                groups.top()->add(new AlphaTextureTest("alpha_texture.triangle."+to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_TYPE_TRIANGLE,imode,ivariant));
+                groups.top()->add(new AlphaTextureTest("alpha_texture.quad."+to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_TYPE_QUAD,imode,ivariant));
+              }
+        groups.pop();
+      }
+
       if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED))
       {
         push(new TestGroup("intersection_filter",true,true));
@@ -6410,6 +8502,13 @@ namespace embree
             for (auto ivariant : intersectVariants)
               if (has_variant(imode,ivariant)) 
                 groups.top()->add(new InstancingTest("instancing."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,true,imode,ivariant));
+        for (auto sflags : sceneFlags) 
+          for (auto imode : intersectModes) 
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant)) {
+                groups.top()->add(new FarInstanceTest("far."+to_string(sflags,imode,ivariant),isa,sflags,false,imode,ivariant));
+                groups.top()->add(new FarInstanceTest("far_mblur."+to_string(sflags,imode,ivariant),isa,sflags,true,imode,ivariant));
+              }
       groups.pop();
 
   #if defined(EMBREE_GEOMETRY_INSTANCE_ARRAY)
@@ -6423,6 +8522,8 @@ namespace embree
                 groups.top()->add(new InstanceArrayRandomTest<AffineSpace3f>("instancing_random_3x4."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
                 groups.top()->add(new InstanceArrayRandomTest<RTCQuaternionDecomposition>("instancing_random_SRT."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
                 groups.top()->add(new InstanceArrayTestFormats("instancing_format."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
+                if (ivariant & VARIANT_INTERSECT)
+                  groups.top()->add(new InstanceArrayLODTest("lod."+to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
               }
       groups.pop();
 #endif
@@ -6612,6 +8713,7 @@ namespace embree
       benchmark_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_ROBUST,        RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
       benchmark_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_COMPACT,       RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
       benchmark_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_ROBUST | RTC_SCENE_FLAG_COMPACT,RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
+      benchmark_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_WATERTIGHT,    RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
       benchmark_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,       RTC_BUILD_QUALITY_LOW),RTC_BUILD_QUALITY_LOW));
 
       std::vector<std::pair<IntersectMode,IntersectVariant>> benchmark_imodes_ivariants;
@@ -6654,6 +8756,32 @@ namespace embree
             groups.top()->add(new IncoherentRaysBenchmark("incoherent."+to_string(gtype)+"_1000k."+to_string(sflags.first,imode.first,imode.second),
                                                           isa,gtype,sflags.first,sflags.second,imode.first,imode.second,501));
 
+      /* the adaptive hybrid switch threshold against the fixed thresholds above for packets of coherent and incoherent rays */
+      for (auto& imode : benchmark_imodes_ivariants)
+      {
+        if (imode.first == MODE_INTERSECT1) continue;
+        const SceneFlags sflags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM);
+        groups.top()->add(new CoherentRaysBenchmark("coherent.adaptive_hybrid_switch."+to_string(TRIANGLE_MESH)+"_1000k."+to_string(sflags,imode.first,imode.second),
+                                                    isa,TRIANGLE_MESH,sflags,RTC_BUILD_QUALITY_MEDIUM,imode.first,imode.second,501,"adaptive_hybrid_switch=1"));
+        groups.top()->add(new IncoherentRaysBenchmark("incoherent.adaptive_hybrid_switch."+to_string(TRIANGLE_MESH)+"_1000k."+to_string(sflags,imode.first,imode.second),
+                                                      isa,TRIANGLE_MESH,sflags,RTC_BUILD_QUALITY_MEDIUM,imode.first,imode.second,501,"adaptive_hybrid_switch=1"));
+      }
+
+#if defined(EMBREE_TARGET_AVX512)
+      /* the 16-wide BVH against the default 8-wide BVH above */
+      if (isa == AVX512)
+      {
+        for (auto& imode : benchmark_imodes_ivariants)
+        {
+          const SceneFlags sflags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM);
+          groups.top()->add(new CoherentRaysBenchmark("coherent.bvh16."+to_string(TRIANGLE_MESH)+"_1000k."+to_string(sflags,imode.first,imode.second),
+                                                      isa,TRIANGLE_MESH,sflags,RTC_BUILD_QUALITY_MEDIUM,imode.first,imode.second,501,"tri_accel=bvh16.triangle4"));
+          groups.top()->add(new IncoherentRaysBenchmark("incoherent.bvh16."+to_string(TRIANGLE_MESH)+"_1000k."+to_string(sflags,imode.first,imode.second),
+                                                        isa,TRIANGLE_MESH,sflags,RTC_BUILD_QUALITY_MEDIUM,imode.first,imode.second,501,"tri_accel=bvh16.triangle4"));
+        }
+      }
+#endif
+
       std::vector<std::pair<SceneFlags,RTCBuildQuality>> benchmark_create_sflags_quality;
       benchmark_create_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
       benchmark_create_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW),RTC_BUILD_QUALITY_LOW));